@@ -0,0 +1,62 @@
+
+# BENCHMARK_FOUND
+# BENCHMARK_INCLUDE_DIR
+# BENCHMARK_LIBRARIES
+
+find_path(BENCHMARK_INCLUDE_DIR benchmark/benchmark.h
+    $ENV{BENCHMARKDIR}/include
+    $ENV{BENCHMARK_HOME}/include
+    $ENV{PROGRAMFILES}/BENCHMARK/include
+    /usr/include
+    /usr/local/include
+    /sw/include
+    /opt/local/include
+    DOC "The directory where benchmark/benchmark.h resides")
+
+find_library(BENCHMARK_LIBRARY
+    NAMES benchmark
+    PATHS
+    $ENV{BENCHMARKDIR}/lib
+    $ENV{BENCHMARK_HOME}/lib
+    $ENV{BENCHMARKDIR}/Release
+    $ENV{BENCHMARK_HOME}/Release
+    /usr/lib64
+    /usr/local/lib64
+    /sw/lib64
+    /opt/local/lib64
+    /usr/lib
+    /usr/local/lib
+    /sw/lib
+    /opt/local/lib
+    DOC "The BENCHMARK library")
+
+find_library(BENCHMARK_LIBRARY_DEBUG
+    NAMES benchmarkd
+    PATHS
+    $ENV{BENCHMARKDIR}/lib
+    $ENV{BENCHMARK_HOME}/lib
+    $ENV{BENCHMARKDIR}/Debug
+    $ENV{BENCHMARK_HOME}/Debug
+    /usr/lib64
+    /usr/local/lib64
+    /sw/lib64
+    /opt/local/lib64
+    /usr/lib
+    /usr/local/lib
+    /sw/lib
+    /opt/local/lib
+    DOC "The BENCHMARK debug library")
+
+if (BENCHMARK_LIBRARY AND BENCHMARK_LIBRARY_DEBUG)
+    set(BENCHMARK_LIBRARIES "optimized" ${BENCHMARK_LIBRARY} "debug" ${BENCHMARK_LIBRARY_DEBUG})
+elseif (BENCHMARK_LIBRARY)
+    set(BENCHMARK_LIBRARIES ${BENCHMARK_LIBRARY})
+elseif (BENCHMARK_LIBRARY_DEBUG)
+    set(BENCHMARK_LIBRARIES ${BENCHMARK_LIBRARY_DEBUG})
+else ()
+    set(BENCHMARK_LIBRARIES "")
+endif ()
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(BENCHMARK REQUIRED_VARS BENCHMARK_INCLUDE_DIR BENCHMARK_LIBRARIES)
+mark_as_advanced(BENCHMARK_INCLUDE_DIR BENCHMARK_LIBRARIES)
@@ -1,6 +1,7 @@
 
 #include "Postprocessing.h"
 
+#include <glm/vec2.hpp>
 #include <glm/gtc/constants.hpp>
 
 #include <gloperate/painter/ViewportCapability.h>
@@ -29,7 +30,11 @@ Postprocessing::Postprocessing(gloperate::ResourceManager & resourceManager)
     m_pipeline.renderTargets.setData(renderTargets);
 
     targetFBO->changed.connect([this]() { m_pipeline.targetFBO.invalidate(); });
-    viewport->changed.connect([this]() { m_pipeline.viewport.invalidate(); });
+    viewport->changed.connect([this, viewport]()
+    {
+        m_pipeline.transientResources().setViewport(glm::ivec2(viewport->width(), viewport->height()));
+        m_pipeline.viewport.invalidate();
+    });
     time->changed.connect([this]() { m_pipeline.time.invalidate(); });
     
     projection->setZNear(0.1f);
@@ -1,6 +1,7 @@
 
 #include "PostprocessingPipeline.h"
 
+#include <glm/vec2.hpp>
 #include <glm/gtc/constants.hpp>
 
 #include <glbinding/gl/enum.h>
@@ -21,10 +22,12 @@
 #include <globjects/base/StringTemplate.h>
 
 #include <gloperate/base/RenderTargetType.h>
+#include <gloperate/base/StateCache.h>
 
 #include <gloperate/pipeline/AbstractStage.h>
 #include <gloperate/pipeline/Data.h>
 #include <gloperate/pipeline/InputSlot.h>
+#include <gloperate/pipeline/TransientResource.h>
 
 #include <gloperate/painter/Camera.h>
 #include <gloperate/painter/AbstractViewportCapability.h>
@@ -45,6 +48,10 @@ class RasterizationStage : public gloperate::AbstractStage
 public:
     RasterizationStage()
     : AbstractStage("Rasterization")
+    , m_colorTarget(gl::GL_RGBA32F, gl::GL_RGBA, gl::GL_FLOAT)
+    , m_normalTarget(gl::GL_RGBA32F, gl::GL_RGBA, gl::GL_FLOAT)
+    , m_geometryTarget(gl::GL_RGBA32F, gl::GL_RGBA, gl::GL_FLOAT)
+    , m_depthSize(0, 0)
     {
         addInput("viewport", viewport);
         addInput("camera", camera);
@@ -54,6 +61,11 @@ public:
         addOutput("color", color);
         addOutput("normal", normal);
         addOutput("geometry", geometry);
+
+        // The targets are pooled by the pipeline and resized only when the viewport changes
+        addTransientResource(m_colorTarget, &color);
+        addTransientResource(m_normalTarget, &normal);
+        addTransientResource(m_geometryTarget, &geometry);
     }
 
     virtual ~RasterizationStage()
@@ -64,14 +76,8 @@ public:
     {
         m_fbo = new globjects::Framebuffer;
 
-        color.data() = globjects::Texture::createDefault(gl::GL_TEXTURE_2D);
-        normal.data() = globjects::Texture::createDefault(gl::GL_TEXTURE_2D);
-        geometry.data() = globjects::Texture::createDefault(gl::GL_TEXTURE_2D);
+        // The depth buffer is read back by the painter after execution, so it is not transient
         m_depth = new globjects::Renderbuffer();
-
-        m_fbo->attachTexture(gl::GL_COLOR_ATTACHMENT0, color.data());
-        m_fbo->attachTexture(gl::GL_COLOR_ATTACHMENT1, normal.data());
-        m_fbo->attachTexture(gl::GL_COLOR_ATTACHMENT2, geometry.data());
         m_fbo->attachRenderBuffer(gl::GL_DEPTH_ATTACHMENT, m_depth);
 
         globjects::StringTemplate* sphereVertexShader = new globjects::StringTemplate(new globjects::File("data/postprocessing/sphere.vert"));
@@ -108,32 +114,45 @@ public:
 protected:
     virtual void process() override
     {
-        gl::glViewport(viewport.data()->x(), viewport.data()->y(), viewport.data()->width(), viewport.data()->height());
+        stateCache()->viewport(viewport.data()->x(), viewport.data()->y(), viewport.data()->width(), viewport.data()->height());
+
+        // Pooled objects may differ between executions
+        color.data() = m_colorTarget.texture();
+        normal.data() = m_normalTarget.texture();
+        geometry.data() = m_geometryTarget.texture();
+
+        // Bound through the cache first, globjects binds the same objects to attach and set uniforms
+        stateCache()->bindFramebuffer(gl::GL_FRAMEBUFFER, m_fbo->id());
+        m_fbo->attachTexture(gl::GL_COLOR_ATTACHMENT0, m_colorTarget.texture());
+        m_fbo->attachTexture(gl::GL_COLOR_ATTACHMENT1, m_normalTarget.texture());
+        m_fbo->attachTexture(gl::GL_COLOR_ATTACHMENT2, m_geometryTarget.texture());
+        m_fbo->setDrawBuffers({ gl::GL_COLOR_ATTACHMENT0, gl::GL_COLOR_ATTACHMENT1, gl::GL_COLOR_ATTACHMENT2 });
 
-        color.data()->image2D(0, gl::GL_RGBA32F, viewport.data()->width(), viewport.data()->height(), 0, gl::GL_RGBA, gl::GL_FLOAT, nullptr);
-        normal.data()->image2D(0, gl::GL_RGBA32F, viewport.data()->width(), viewport.data()->height(), 0, gl::GL_RGBA, gl::GL_FLOAT, nullptr);
-        geometry.data()->image2D(0, gl::GL_RGBA32F, viewport.data()->width(), viewport.data()->height(), 0, gl::GL_RGBA, gl::GL_FLOAT, nullptr);
+        const auto size = glm::ivec2(viewport.data()->width(), viewport.data()->height());
 
-        m_depth->storage(gl::GL_DEPTH_COMPONENT32, viewport.data()->width(), viewport.data()->height());
+        if (size != m_depthSize)
+        {
+            m_depth->storage(gl::GL_DEPTH_COMPONENT32, size.x, size.y);
+            m_depthSize = size;
+        }
 
+        stateCache()->useProgram(m_program->id());
         m_program->setUniform("transform", projection.data()->projection() * camera.data()->view());
         m_program->setUniform("timef", time.data()->time());
 
-        m_fbo->bind(gl::GL_FRAMEBUFFER);
-        m_fbo->setDrawBuffers({ gl::GL_COLOR_ATTACHMENT0, gl::GL_COLOR_ATTACHMENT1, gl::GL_COLOR_ATTACHMENT2 });
-
-        gl::glClearColor(1.0, 1.0, 1.0, 0.0);
+        stateCache()->enable(gl::GL_DEPTH_TEST);
+        stateCache()->clearColor(1.0, 1.0, 1.0, 0.0);
         gl::glClear(gl::GL_COLOR_BUFFER_BIT | gl::GL_DEPTH_BUFFER_BIT);
 
-        m_program->use();
         m_icosahedron->draw();
-        m_program->release();
-
-        m_fbo->unbind(gl::GL_FRAMEBUFFER);
     }
 protected:
     globjects::ref_ptr<globjects::Framebuffer> m_fbo;
+    gloperate::TransientResource m_colorTarget;
+    gloperate::TransientResource m_normalTarget;
+    gloperate::TransientResource m_geometryTarget;
     globjects::ref_ptr<globjects::Renderbuffer> m_depth;
+    glm::ivec2 m_depthSize;
     globjects::ref_ptr<globjects::Program> m_program;
     globjects::ref_ptr<gloperate::Icosahedron> m_icosahedron;
 };
@@ -188,33 +207,26 @@ public:
 protected:
     virtual void process() override
     {
-        gl::glDisable(gl::GL_DEPTH_TEST);
+        stateCache()->disable(gl::GL_DEPTH_TEST);
 
-        color.data()->bindActive(gl::GL_TEXTURE0);
-        normal.data()->bindActive(gl::GL_TEXTURE1);
-        geometry.data()->bindActive(gl::GL_TEXTURE2);
+        stateCache()->bindTexture(gl::GL_TEXTURE0, color.data()->target(), color.data()->id());
+        stateCache()->bindTexture(gl::GL_TEXTURE1, normal.data()->target(), normal.data()->id());
+        stateCache()->bindTexture(gl::GL_TEXTURE2, geometry.data()->target(), geometry.data()->id());
 
         globjects::Framebuffer * fbo = targetFramebuffer.data()->framebuffer() ? targetFramebuffer.data()->framebuffer() : globjects::Framebuffer::defaultFBO();
 
-        fbo->bind(gl::GL_FRAMEBUFFER);
+        // Bound through the cache first, globjects binds the same framebuffer to set the draw buffers
+        stateCache()->bindFramebuffer(gl::GL_FRAMEBUFFER, fbo->id());
 
         if (!fbo->isDefault())
         {
             fbo->setDrawBuffers({ gl::GL_COLOR_ATTACHMENT0 });
         }
 
-        gl::glClearColor(1.0, 1.0, 1.0, 0.0);
+        stateCache()->clearColor(1.0, 1.0, 1.0, 0.0);
         gl::glClear(gl::GL_COLOR_BUFFER_BIT | gl::GL_DEPTH_BUFFER_BIT);
 
-        m_quad->draw();
-
-        color.data()->unbindActive(gl::GL_TEXTURE0);
-        normal.data()->unbindActive(gl::GL_TEXTURE1);
-        geometry.data()->unbindActive(gl::GL_TEXTURE2);
-
-        globjects::Framebuffer::defaultFBO()->bind(gl::GL_FRAMEBUFFER);
-
-        gl::glEnable(gl::GL_DEPTH_TEST);
+        m_quad->draw(*stateCache());
     }
 protected:
     globjects::ref_ptr<gloperate::ScreenAlignedQuad> m_quad;
@@ -0,0 +1,150 @@
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include <globjects/base/baselogging.h>
+
+#include <gloperate/plugin/PluginManager.h>
+#include <gloperate/plugin/Plugin.h>
+#include <gloperate/painter/ContextFormat.h>
+#include <gloperate/painter/Painter.h>
+
+#include <gloperate/resources/ResourceManager.h>
+#include <gloperate/tools/FixedStepDriver.h>
+
+#include <gloperate-headless/Context.h>
+#include <gloperate-headless/Renderer.h>
+
+
+using namespace gloperate;
+using namespace gloperate_headless;
+
+
+namespace
+{
+
+bool writePPM(const Frame & frame, const std::string & filename)
+{
+    std::ofstream stream(filename, std::ios::binary);
+
+    if (!stream)
+        return false;
+
+    stream << "P6\n" << frame.width << " " << frame.height << "\n255\n";
+
+    // PPM has no alpha channel
+    for (std::size_t i = 0; i < frame.pixels.size(); i += 4)
+        stream.write(reinterpret_cast<const char *>(&frame.pixels[i]), 3);
+
+    return stream.good();
+}
+
+} // namespace
+
+
+// Usage: viewer-headless [painter] [width] [height] [frames] [output prefix]
+int main(int argc, char * argv[])
+{
+    ResourceManager resourceManager;
+
+
+    PluginManager::init(argv[0]);
+
+    PluginManager pluginManager;
+#ifdef NDEBUG
+    pluginManager.addPath("plugins");
+#else
+    pluginManager.addPath("plugins/debug");
+#endif
+    pluginManager.scan("painters");
+
+    // Choose a painter
+    std::string name = (argc > 1) ? argv[1] : "CubeScape";
+
+    const int width  = (argc > 2) ? std::atoi(argv[2]) : 1280;
+    const int height = (argc > 3) ? std::atoi(argv[3]) : 720;
+    const int frames = (argc > 4) ? std::atoi(argv[4]) : 1;
+    const std::string prefix = (argc > 5) ? argv[5] : "frame";
+
+    std::unique_ptr<gloperate::Painter> painter(nullptr);
+    Plugin * plugin = pluginManager.plugin(name);
+
+    if (!plugin)
+    {
+        globjects::fatal() << "Plugin '" << name << "' not found. Listing plugins found:";
+        pluginManager.printPlugins();
+
+        return 1;
+    }
+
+    painter.reset(plugin->createPainter(resourceManager));
+
+    if (!Renderer::isApplicableTo(painter.get()))
+    {
+        globjects::fatal() << "Plugin '" << name << "' lacks a viewport or target framebuffer capability.";
+
+        return 1;
+    }
+
+    ContextFormat format;
+    format.setVersion(3, 2);
+
+    std::unique_ptr<Context> context(Context::create(format));
+
+    if (!context)
+        return 1;
+
+    context->makeCurrent();
+
+    globjects::info() << std::endl
+        << "OpenGL Version:  " << context->version() << std::endl
+        << "OpenGL Vendor:   " << context->vendor() << std::endl
+        << "OpenGL Renderer: " << context->renderer() << std::endl;
+
+    Renderer renderer(*context, painter.get());
+    renderer.initialize();
+    renderer.resize(width, height);
+
+    Frame frame;
+    bool failed = false;
+
+    const auto capture = [&](std::size_t frameNumber)
+    {
+        if (failed)
+            return;
+
+        renderer.render(frame);
+
+        const std::string filename = prefix + "-" + std::to_string(frameNumber) + ".ppm";
+
+        if (!writePPM(frame, filename))
+        {
+            globjects::fatal() << "Writing " << filename << " failed.";
+
+            failed = true;
+        }
+    };
+
+    if (FixedStepDriver::isApplicableTo(painter.get()))
+    {
+        // Animated painters advance exactly 1/60 s per frame, so captures are reproducible
+        FixedStepDriver driver(painter.get());
+        driver.run(static_cast<std::size_t>(std::max(frames, 0)), capture);
+    }
+    else
+    {
+        for (int i = 0; i < frames; ++i)
+            capture(i);
+    }
+
+    if (failed)
+        return 1;
+
+    // Release the painter's OpenGL objects while the context is still current
+    painter.reset();
+
+    return 0;
+}
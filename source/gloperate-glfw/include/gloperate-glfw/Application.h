@@ -35,6 +35,12 @@ protected:
     void pollEvents();
     void processEvents();
 
+    /** Sleeps until an event arrives or the next timer is ready */
+    void waitEvents();
+
+    /** True if all windows render on demand and none has to be repainted */
+    bool isIdle() const;
+
 protected:
     static std::string baseName(const std::string & filePath);
     static std::string path(const std::string & filePath);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <set>
 #include <string>
 #include <queue>
@@ -9,6 +10,8 @@
 #include <globjects/base/ref_ptr.h>
 
 #include <gloperate/painter/Painter.h>
+#include <gloperate/tools/ProgressiveRefinement.h>
+#include <gloperate/tools/RepaintMonitor.h>
 
 #include <gloperate-glfw/gloperate-glfw_api.h>
 
@@ -28,6 +31,7 @@ namespace gloperate
 {
 
 class ResourceManager;
+class ResolutionScaler;
 
 } // namespace gloperate
 
@@ -126,6 +130,28 @@ public:
     gloperate::Painter * painter() const;
     void setPainter(gloperate::Painter * painter);
 
+    /** If enabled, the window repaints only when a capability of the painter changed,
+        an output of the painter was invalidated, input arrived (see RepaintMonitor),
+        or the still image of a progressive painter has not converged yet
+        (see ProgressiveRefinement), and the application sleeps while all windows
+        are idle. Disabled by default.
+     */
+    bool renderOnDemand() const;
+    void setRenderOnDemand(bool enabled);
+
+    /** True if the window renders on demand and a repaint is required */
+    bool isRepaintRequired() const;
+
+    /** If enabled and the painter supports a ResolutionScaleCapability, the painter is
+        rendered at a reduced resolution to hold the target frame time (in seconds, see
+        ResolutionScaler). Disabled by default.
+     */
+    bool dynamicResolution() const;
+    void setDynamicResolution(bool enabled, float targetFrameTime = 1.0f / 60.0f);
+
+    /** nullptr while dynamic resolution is disabled or not supported by the painter, and before the first paint */
+    gloperate::ResolutionScaler * resolutionScaler() const;
+
     gloperate::ResourceManager & resourceManager();
     const gloperate::ResourceManager & resourceManager() const;
 
@@ -140,6 +166,13 @@ protected:
     void processEvent(WindowEvent & event);
     void postprocessEvent(WindowEvent & event);
 
+    /** Runs the virtual time timer while virtual time is enabled, or always if not rendering on demand */
+    void updateTimeTimer();
+
+    /** Creates or deletes the scaler as configured, requires the context to be current */
+    void updateResolutionScaler();
+    void releaseResolutionScaler();
+
 
 protected:
     Context * m_context;
@@ -162,6 +195,14 @@ protected:
     gloperate::Painter * m_painter;
     gloperate::ResourceManager & m_resourceManager;
 
+    gloperate::RepaintMonitor m_repaintMonitor;
+    gloperate::ProgressiveRefinement m_progressiveRefinement;
+    bool m_renderOnDemand;
+
+    std::unique_ptr<gloperate::ResolutionScaler> m_resolutionScaler;
+    bool m_dynamicResolution;
+    float m_targetFrameTime;
+
 private:
     static std::set<Window*> s_instances;
 };
@@ -43,6 +43,10 @@ public:
     static void addTimer(Window* window, int id, int interval, bool singleShot);
     static void removeTimer(Window* window, int id);
     static void removeTimers(Window* window);
+    static bool hasTimer(Window* window, int id);
+
+    /** Time until the next timer is ready, Timer::Duration::max() if there are no timers */
+    static Timer::Duration remainingTime();
     static void initializeTime();
     static void checkForTimerEvents();
    
@@ -2,6 +2,7 @@
 #include <gloperate-glfw/Application.h>
 
 #include <cassert>
+#include <chrono>
 
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
@@ -119,14 +120,54 @@ int Application::exitCode()
 
 void Application::pollEvents()
 {
-    glfwPollEvents();
+    if (isIdle())
+        waitEvents();
+    else
+        glfwPollEvents();
+
     WindowEventDispatcher::checkForTimerEvents();
 }
 
+void Application::waitEvents()
+{
+    auto remaining = WindowEventDispatcher::remainingTime();
+
+    if (remaining == WindowEventDispatcher::Timer::Duration::max())
+    {
+        glfwWaitEvents();
+        return;
+    }
+
+#if GLFW_VERSION_MAJOR > 3 || (GLFW_VERSION_MAJOR == 3 && GLFW_VERSION_MINOR >= 2)
+    if (remaining > WindowEventDispatcher::Timer::Duration::zero())
+    {
+        glfwWaitEventsTimeout(std::chrono::duration_cast<std::chrono::duration<double>>(remaining).count());
+        return;
+    }
+#endif
+
+    // Waiting with timeout requires GLFW 3.2
+    glfwPollEvents();
+}
+
+bool Application::isIdle() const
+{
+    for (Window * window : Window::instances())
+    {
+        if (!window->renderOnDemand() || window->isRepaintRequired() || window->hasPendingEvents())
+            return false;
+    }
+
+    return true;
+}
+
 void Application::processEvents()
 {
     for (Window * window : Window::instances())
     {
+        if (window->isRepaintRequired())
+            window->repaint();
+
         if (window->hasPendingEvents())
             window->processEvents();
         else
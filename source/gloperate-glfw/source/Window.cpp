@@ -10,6 +10,7 @@
 
 #include <gloperate/painter/ContextFormat.h>
 #include <gloperate/painter/AbstractVirtualTimeCapability.h>
+#include <gloperate/tools/ResolutionScaler.h>
 
 #include <gloperate-glfw/Application.h>
 #include <gloperate-glfw/Context.h>
@@ -45,8 +46,19 @@ Window::Window(gloperate::ResourceManager & resourceManager)
 ,   m_mode(WindowMode)
 ,   m_painter(nullptr)
 ,   m_resourceManager(resourceManager)
+,   m_renderOnDemand(false)
+,   m_dynamicResolution(false)
+,   m_targetFrameTime(1.0f / 60.0f)
 {
     s_instances.insert(this);
+
+    m_repaintMonitor.repaintRequested.connect([]()
+    {
+        // Wakes the application, which may sleep in glfwWaitEvents(), also from worker threads
+#if GLFW_VERSION_MAJOR > 3 || (GLFW_VERSION_MAJOR == 3 && GLFW_VERSION_MINOR >= 1)
+        glfwPostEmptyEvent();
+#endif
+    });
 }
 
 Window::~Window()
@@ -170,6 +182,8 @@ bool Window::createContext(const ContextFormat & format, int width, int height,
 
 void Window::destroyContext()
 {
+    releaseResolutionScaler();
+
     delete m_context;
     glfwDestroyWindow(m_window);
 
@@ -417,9 +431,45 @@ void Window::processEvents()
 
 void Window::processEvent(WindowEvent & event)
 {
+    switch (event.type())
+    {
+    case WindowEvent::Type::KeyPress:
+    case WindowEvent::Type::KeyRelease:
+    case WindowEvent::Type::KeyTyped:
+    case WindowEvent::Type::MousePress:
+    case WindowEvent::Type::MouseRelease:
+    case WindowEvent::Type::MouseMove:
+    case WindowEvent::Type::Scroll:
+        // Input may change what the painter shows
+        m_repaintMonitor.requestRepaint();
+        break;
+
+    default:
+        break;
+    }
+
+    const bool paint = event.type() == WindowEvent::Type::Paint;
+
+    if (paint)
+    {
+        updateResolutionScaler();
+        m_repaintMonitor.beginPaint();
+        m_progressiveRefinement.beginPaint();
+    }
+
     if (m_eventHandler)
         m_eventHandler->handleEvent(event);
 
+    if (paint)
+    {
+        m_progressiveRefinement.endPaint();
+        m_repaintMonitor.endPaint();
+
+        // A still image that has not converged yet is refined by the next frame
+        if (m_progressiveRefinement.isRefining())
+            m_repaintMonitor.requestRepaint();
+    }
+
     postprocessEvent(event);
 }
 
@@ -429,6 +479,11 @@ void Window::postprocessEvent(WindowEvent & event)
     {
     case WindowEvent::Type::Paint:
         swap();
+        updateTimeTimer();
+        break;
+
+    case WindowEvent::Type::Timer:
+        updateTimeTimer();
         break;
 
     case WindowEvent::Type::Close:
@@ -473,16 +528,99 @@ void Window::setPainter(gloperate::Painter * painter)
     if (m_painter)
         removeTimer(0);
 
+    // The scaler hands the output back to the old painter
+    releaseResolutionScaler();
+
     m_painter = painter;
+    m_repaintMonitor.setPainter(painter);
+    m_progressiveRefinement.setPainter(painter);
+
+    updateTimeTimer();
+}
+
+bool Window::renderOnDemand() const
+{
+    return m_renderOnDemand;
+}
+
+void Window::setRenderOnDemand(bool enabled)
+{
+    m_renderOnDemand = enabled;
+
+    m_repaintMonitor.requestRepaint();
+    updateTimeTimer();
+}
+
+bool Window::isRepaintRequired() const
+{
+    return m_renderOnDemand && m_context && m_repaintMonitor.isRepaintRequired();
+}
+
+bool Window::dynamicResolution() const
+{
+    return m_dynamicResolution;
+}
+
+void Window::setDynamicResolution(bool enabled, float targetFrameTime)
+{
+    m_dynamicResolution = enabled;
+    m_targetFrameTime = targetFrameTime;
+
+    // Applied on the next paint, with the context current
+    m_repaintMonitor.requestRepaint();
+}
+
+gloperate::ResolutionScaler * Window::resolutionScaler() const
+{
+    return m_resolutionScaler.get();
+}
+
+void Window::updateResolutionScaler()
+{
+    if (!m_dynamicResolution || !gloperate::ResolutionScaler::isApplicableTo(m_painter))
+    {
+        releaseResolutionScaler();
+        return;
+    }
+
+    if (!m_resolutionScaler)
+    {
+        m_resolutionScaler.reset(new gloperate::ResolutionScaler(m_painter));
+        m_resolutionScaler->initialize();
+    }
 
-    if (!m_painter)
+    // Changing the target discards the collected frame times
+    if (m_resolutionScaler->controller().targetFrameTime() != m_targetFrameTime)
+        m_resolutionScaler->controller().setTargetFrameTime(m_targetFrameTime);
+}
+
+void Window::releaseResolutionScaler()
+{
+    if (!m_resolutionScaler)
         return;
 
-    gloperate::AbstractVirtualTimeCapability * timeCapability = 
-        m_painter->getCapability<gloperate::AbstractVirtualTimeCapability>();
+    GLFWwindow * current = glfwGetCurrentContext();
+
+    glfwMakeContextCurrent(m_window);
+    m_resolutionScaler = nullptr;
+    glfwMakeContextCurrent(current);
+}
+
+void Window::updateTimeTimer()
+{
+    gloperate::AbstractVirtualTimeCapability * timeCapability = m_painter ?
+        m_painter->getCapability<gloperate::AbstractVirtualTimeCapability>() : nullptr;
 
-    if (timeCapability)
+    // A disabled virtual time is resumed by the repaint its enabling requires
+    const bool required = timeCapability && (!m_renderOnDemand || timeCapability->enabled());
+
+    if (required == WindowEventDispatcher::hasTimer(this, 0))
+        return;
+
+    if (required)
         addTimer(0, 0, false);
+    else
+        removeTimer(0);
 }
 
 gloperate::ResourceManager & Window::resourceManager()
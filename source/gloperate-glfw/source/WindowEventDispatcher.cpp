@@ -1,5 +1,6 @@
 #include <gloperate-glfw/WindowEventDispatcher.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 
@@ -109,6 +110,31 @@ void WindowEventDispatcher::removeTimers(Window* window)
     s_timers.erase(window);
 }
 
+bool WindowEventDispatcher::hasTimer(Window* window, int id)
+{
+    auto it = s_timers.find(window);
+
+    return it != s_timers.end() && it->second.count(id) > 0;
+}
+
+WindowEventDispatcher::Timer::Duration WindowEventDispatcher::remainingTime()
+{
+    Timer::Duration sinceCheck = std::chrono::duration_cast<Timer::Duration>(s_clock.now() - s_time);
+    Timer::Duration remaining = Timer::Duration::max();
+
+    for (const auto& timerMapPair : s_timers)
+    {
+        for (const auto& timerPair : timerMapPair.second)
+        {
+            const Timer& timer = timerPair.second;
+
+            remaining = std::min(remaining, std::max(timer.interval - timer.elapsed - sinceCheck, Timer::Duration::zero()));
+        }
+    }
+
+    return remaining;
+}
+
 void WindowEventDispatcher::initializeTime()
 {
     s_time = s_clock.now();
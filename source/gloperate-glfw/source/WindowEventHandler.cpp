@@ -12,6 +12,7 @@
 #include <gloperate/painter/AbstractVirtualTimeCapability.h>
 #include <gloperate/painter/AbstractInputCapability.h>
 
+#include <gloperate/tools/ResolutionScaler.h>
 #include <gloperate/tools/ScreenshotTool.h>
 
 
@@ -48,6 +49,15 @@ static gloperate::Key fromGLFWKeyCode(int key)
     return static_cast<gloperate::Key>(key);
 }
 
+/** \brief Map the position of a mouse event to the viewport the painter renders
+*/
+static glm::ivec2 toViewport(MouseEvent & event)
+{
+    gloperate::ResolutionScaler * scaler = event.window()->resolutionScaler();
+
+    return scaler ? scaler->mapToViewport(event.pos()) : event.pos();
+}
+
 WindowEventHandler::WindowEventHandler()
 {
 }
@@ -82,8 +92,11 @@ void WindowEventHandler::framebufferResizeEvent(ResizeEvent & event)
 void WindowEventHandler::paintEvent(PaintEvent & event)
 {
     if (event.window()->painter()) {
-        // Call painter
-        event.window()->painter()->paint();
+        // Call painter, through the scaler if rendering at a reduced resolution
+        if (event.window()->resolutionScaler())
+            event.window()->resolutionScaler()->paint();
+        else
+            event.window()->painter()->paint();
     }
 }
 
@@ -123,24 +136,28 @@ void WindowEventHandler::keyReleaseEvent(KeyEvent & event)
 
 void WindowEventHandler::mouseMoveEvent(MouseEvent & event)
 {
+    const glm::ivec2 position = toViewport(event);
+
     // Check for input capability
     if (event.window()->painter() && event.window()->painter()->supports<gloperate::AbstractInputCapability>()) {
         // Propagate event
         event.window()->painter()->getCapability<gloperate::AbstractInputCapability>()->onMouseMove(
-            event.x(),
-            event.y()
+            position.x,
+            position.y
         );
     }
 }
 
 void WindowEventHandler::mousePressEvent(MouseEvent & event)
 {
+    const glm::ivec2 position = toViewport(event);
+
     // Check for input capability
     if (event.window()->painter() && event.window()->painter()->supports<gloperate::AbstractInputCapability>()) {
         // Propagate event
         event.window()->painter()->getCapability<gloperate::AbstractInputCapability>()->onMousePress(
-            event.x(),
-            event.y(),
+            position.x,
+            position.y,
             fromGLFWMouseButton(event.button())
         );
     }
@@ -148,12 +165,14 @@ void WindowEventHandler::mousePressEvent(MouseEvent & event)
 
 void WindowEventHandler::mouseReleaseEvent(MouseEvent & event)
 {
+    const glm::ivec2 position = toViewport(event);
+
     // Check for input capability
     if (event.window()->painter() && event.window()->painter()->supports<gloperate::AbstractInputCapability>()) {
         // Propagate event
         event.window()->painter()->getCapability<gloperate::AbstractInputCapability>()->onMouseRelease(
-            event.x(),
-            event.y(),
+            position.x,
+            position.y,
             fromGLFWMouseButton(event.button())
         );
     }
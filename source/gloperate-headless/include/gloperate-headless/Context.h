@@ -0,0 +1,56 @@
+#pragma once
+
+#include <gloperate-headless/gloperate-headless_api.h>
+
+#include <gloperate/painter/AbstractContext.h>
+
+
+namespace gloperate
+{
+    class ContextFormat;
+}
+
+namespace gloperate_headless
+{
+
+/** \brief OpenGL context created through EGL, without a window system or display.
+
+    The display is taken from the EGL device platform, which lists GPUs as well as Mesa's
+    software device (llvmpipe), so the context works on machines without GPU and without
+    X server. Without device enumeration, Mesa's surfaceless platform and the default
+    display are tried. The context has no default framebuffer to render to, painters
+    render into the framebuffer of a Renderer.
+
+    The function pointers are resolved by glbinding, which requires a libglvnd-based
+    OpenGL installation on Linux. glbinding identifies contexts by the current GLX
+    context, so a process should create only one headless context.
+*/
+class GLOPERATE_HEADLESS_API Context : public gloperate::AbstractContext
+{
+public:
+    /** Creates a context of the requested version and profile, nullptr on failure.
+        device selects the EGL device by index, -1 takes the first usable one.
+    */
+    static Context * create(const gloperate::ContextFormat & format, int device = -1);
+
+    virtual ~Context();
+
+    virtual glbinding::ContextHandle handle() const override;
+
+    virtual const gloperate::ContextFormat & format() const override;
+
+    virtual void makeCurrent() const override;
+    virtual void doneCurrent() const override;
+
+protected:
+    Context(void * display, void * surface, void * context);
+
+protected:
+    mutable gloperate::ContextFormat * m_format;
+
+    void * m_display;   /**< EGLDisplay */
+    void * m_surface;   /**< EGLSurface, EGL_NO_SURFACE for surfaceless contexts */
+    void * m_context;   /**< EGLContext */
+};
+
+} // namespace gloperate_headless
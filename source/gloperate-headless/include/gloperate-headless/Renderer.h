@@ -0,0 +1,92 @@
+#pragma once
+
+#include <vector>
+
+#include <globjects/base/ref_ptr.h>
+
+#include <gloperate-headless/gloperate-headless_api.h>
+
+
+namespace globjects
+{
+    class Framebuffer;
+    class Renderbuffer;
+    class Texture;
+}
+
+namespace gloperate
+{
+    class Painter;
+    class AbstractViewportCapability;
+    class AbstractTargetFramebufferCapability;
+    class AbstractVirtualTimeCapability;
+}
+
+namespace gloperate_headless
+{
+
+class Context;
+
+
+/** \brief Frame read back from the GPU
+*/
+struct GLOPERATE_HEADLESS_API Frame
+{
+    int width;
+    int height;
+    std::vector<unsigned char> pixels;  /**< RGBA with 8 bits per channel, top row first */
+};
+
+
+/** \brief Drives a painter without a window and hands back its frames as CPU buffers.
+
+    The painter renders into a framebuffer object of the renderer, which it receives
+    through its TargetFramebufferCapability, and is resized through its ViewportCapability.
+    Painters lacking either capability cannot be rendered headless, see isApplicableTo().
+
+    All methods make the context current and leave it current.
+*/
+class GLOPERATE_HEADLESS_API Renderer
+{
+public:
+    static bool isApplicableTo(gloperate::Painter * painter);
+
+public:
+    /** The renderer neither owns the context nor the painter */
+    Renderer(Context & context, gloperate::Painter * painter);
+    /** Hands the painter its previous target framebuffer back */
+    virtual ~Renderer();
+
+    Renderer(const Renderer &) = delete;
+    Renderer & operator=(const Renderer &) = delete;
+
+    /** Initializes globjects, the framebuffer and the painter, which renders into the framebuffer from now on */
+    void initialize();
+
+    int width() const;
+    int height() const;
+    void resize(int width, int height);
+
+    /** Advances the virtual time of the painter, if it supports one */
+    void update(float delta);
+
+    /** Paints a frame and reads it back, frame keeps its memory if the size did not change */
+    void render(Frame & frame);
+
+protected:
+    Context & m_context;
+    gloperate::Painter * m_painter;
+    gloperate::AbstractViewportCapability * m_viewportCapability;
+    gloperate::AbstractTargetFramebufferCapability * m_framebufferCapability;
+    gloperate::AbstractVirtualTimeCapability * m_timeCapability;
+    globjects::Framebuffer * m_oldFramebuffer;
+
+    int m_width;
+    int m_height;
+
+    globjects::ref_ptr<globjects::Framebuffer> m_fbo;
+    globjects::ref_ptr<globjects::Texture> m_color;
+    globjects::ref_ptr<globjects::Renderbuffer> m_depth;
+};
+
+} // namespace gloperate_headless
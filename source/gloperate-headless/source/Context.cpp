@@ -0,0 +1,315 @@
+#include <gloperate-headless/Context.h>
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <glbinding/Binding.h>
+#include <glbinding/Version.h>
+
+#include <globjects/base/baselogging.h>
+
+#include <gloperate/painter/ContextFormat.h>
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+
+using namespace globjects;
+using namespace gloperate;
+
+namespace
+{
+
+bool hasExtension(const char * extensions, const char * extension)
+{
+    if (!extensions)
+        return false;
+
+    const auto length = std::strlen(extension);
+
+    for (auto position = std::strstr(extensions, extension); position; position = std::strstr(position + length, extension))
+    {
+        // Only whole names count, e.g., not EGL_EXT_device_base for EGL_EXT_device
+        const auto end = position[length];
+
+        if ((position == extensions || position[-1] == ' ') && (end == ' ' || end == '\0'))
+            return true;
+    }
+
+    return false;
+}
+
+std::string errorName(EGLint error)
+{
+    switch (error)
+    {
+    case EGL_BAD_ACCESS:            return "EGL_BAD_ACCESS";
+    case EGL_BAD_ALLOC:             return "EGL_BAD_ALLOC";
+    case EGL_BAD_CONTEXT:           return "EGL_BAD_CONTEXT";
+    case EGL_BAD_CURRENT_SURFACE:   return "EGL_BAD_CURRENT_SURFACE";
+    case EGL_BAD_DISPLAY:           return "EGL_BAD_DISPLAY";
+    case EGL_BAD_MATCH:             return "EGL_BAD_MATCH";
+    case EGL_BAD_NATIVE_WINDOW:     return "EGL_BAD_NATIVE_WINDOW";
+    case EGL_BAD_SURFACE:           return "EGL_BAD_SURFACE";
+    case EGL_CONTEXT_LOST:          return "EGL_CONTEXT_LOST";
+    case EGL_NOT_INITIALIZED:       return "EGL_NOT_INITIALIZED";
+    default:
+        break;
+    }
+
+    std::ostringstream stream;
+    stream << "0x" << std::hex << error;
+
+    return stream.str();
+}
+
+EGLDisplay initializedDisplay(EGLDisplay display)
+{
+    if (display == EGL_NO_DISPLAY)
+        return EGL_NO_DISPLAY;
+
+    return eglInitialize(display, nullptr, nullptr) ? display : EGL_NO_DISPLAY;
+}
+
+EGLDisplay openDisplay(int device)
+{
+    const auto clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+    const auto getPlatformDisplay = hasExtension(clientExtensions, "EGL_EXT_platform_base")
+        ? reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT")) : nullptr;
+
+    const auto queryDevices = hasExtension(clientExtensions, "EGL_EXT_device_enumeration")
+        ? reinterpret_cast<PFNEGLQUERYDEVICESEXTPROC>(eglGetProcAddress("eglQueryDevicesEXT")) : nullptr;
+
+    // GPUs and Mesa's software device, which need neither window system nor display
+    if (getPlatformDisplay && queryDevices && hasExtension(clientExtensions, "EGL_EXT_platform_device"))
+    {
+        EGLint numDevices = 0;
+        queryDevices(0, nullptr, &numDevices);
+
+        std::vector<EGLDeviceEXT> devices(static_cast<std::size_t>(numDevices));
+
+        if (numDevices > 0 && queryDevices(numDevices, devices.data(), &numDevices))
+        {
+            if (device >= 0)
+            {
+                if (device >= numDevices)
+                {
+                    critical() << "EGL device " << device << " requested, but only " << numDevices << " found.";
+                    return EGL_NO_DISPLAY;
+                }
+
+                return initializedDisplay(getPlatformDisplay(EGL_PLATFORM_DEVICE_EXT, devices[device], nullptr));
+            }
+
+            for (auto candidate : devices)
+            {
+                const auto display = initializedDisplay(getPlatformDisplay(EGL_PLATFORM_DEVICE_EXT, candidate, nullptr));
+
+                if (display != EGL_NO_DISPLAY)
+                    return display;
+            }
+        }
+    }
+
+    if (getPlatformDisplay && hasExtension(clientExtensions, "EGL_MESA_platform_surfaceless"))
+    {
+        const auto display = initializedDisplay(getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr));
+
+        if (display != EGL_NO_DISPLAY)
+            return display;
+    }
+
+    return initializedDisplay(eglGetDisplay(EGL_DEFAULT_DISPLAY));
+}
+
+} // namespace
+
+
+namespace gloperate_headless
+{
+
+Context * Context::create(const ContextFormat & format, int device)
+{
+    const auto display = openDisplay(device);
+
+    if (display == EGL_NO_DISPLAY)
+    {
+        critical() << "No EGL display available for headless rendering.";
+        return nullptr;
+    }
+
+    if (!eglBindAPI(EGL_OPENGL_API))
+    {
+        critical() << "EGL display does not support desktop OpenGL.";
+        eglTerminate(display);
+        return nullptr;
+    }
+
+    // Painters render into framebuffer objects, so only a surfaceless context or a minimal pbuffer is needed
+    const auto surfaceless = hasExtension(eglQueryString(display, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context");
+
+    const EGLint configAttributes[] =
+    {
+        EGL_SURFACE_TYPE, surfaceless ? 0 : EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_NONE
+    };
+
+    EGLConfig config = nullptr;
+    EGLint numConfigs = 0;
+
+    if (!eglChooseConfig(display, configAttributes, &config, 1, &numConfigs) || numConfigs < 1)
+    {
+        critical() << "No EGL config for desktop OpenGL found.";
+        eglTerminate(display);
+        return nullptr;
+    }
+
+    // The windowless contexts of Mesa and NVIDIA support core profiles, so older requests get 3.2 core
+    const auto version = format.version() < glbinding::Version(3, 0) ? glbinding::Version(3, 2) : format.version();
+    const auto profile = format.version() < glbinding::Version(3, 0) ? ContextFormat::Profile::Core : format.profile();
+
+    EGLint flags = 0;
+
+    if (format.forwardCompatible())
+        flags |= EGL_CONTEXT_OPENGL_FORWARD_COMPATIBLE_BIT_KHR;
+
+    if (format.debugContext())
+        flags |= EGL_CONTEXT_OPENGL_DEBUG_BIT_KHR;
+
+    const EGLint contextAttributes[] =
+    {
+        EGL_CONTEXT_MAJOR_VERSION_KHR, version.m_major,
+        EGL_CONTEXT_MINOR_VERSION_KHR, version.m_minor,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR, profile == ContextFormat::Profile::Compatibility
+            ? EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT_KHR : EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR,
+        EGL_CONTEXT_FLAGS_KHR, flags,
+        EGL_NONE
+    };
+
+    const auto context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes);
+
+    if (context == EGL_NO_CONTEXT)
+    {
+        critical() << "Creating an OpenGL " << version.toString() << " context through EGL failed.";
+        eglTerminate(display);
+        return nullptr;
+    }
+
+    auto surface = EGL_NO_SURFACE;
+
+    if (!surfaceless)
+    {
+        const EGLint surfaceAttributes[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+
+        surface = eglCreatePbufferSurface(display, config, surfaceAttributes);
+
+        if (surface == EGL_NO_SURFACE)
+        {
+            critical() << "Creating an EGL pbuffer failed.";
+            eglDestroyContext(display, context);
+            eglTerminate(display);
+            return nullptr;
+        }
+    }
+
+    if (!eglMakeCurrent(display, surface, surface, context))
+    {
+        critical() << "Making the EGL context current failed (" << errorName(eglGetError()) << ").";
+
+        if (surface != EGL_NO_SURFACE)
+            eglDestroySurface(display, surface);
+
+        eglDestroyContext(display, context);
+        eglTerminate(display);
+        return nullptr;
+    }
+
+    glbinding::Binding::initialize(false);
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+
+    return new Context(display, surface, context);
+}
+
+Context::Context(void * display, void * surface, void * context)
+: m_format(nullptr)
+, m_display(display)
+, m_surface(surface)
+, m_context(context)
+{
+    assert(context);
+}
+
+Context::~Context()
+{
+    if (eglGetCurrentContext() == m_context)
+        eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+
+    if (m_surface != EGL_NO_SURFACE)
+        eglDestroySurface(m_display, m_surface);
+
+    eglDestroyContext(m_display, m_context);
+    eglTerminate(m_display);
+
+    delete m_format;
+}
+
+glbinding::ContextHandle Context::handle() const
+{
+    // glbinding only queries GLX for the current context, so the EGL context is the handle
+    return static_cast<glbinding::ContextHandle>(reinterpret_cast<std::uintptr_t>(m_context));
+}
+
+const ContextFormat & Context::format() const
+{
+    assert(isValid());
+
+    if (m_format)
+        return *m_format;
+
+    // create and retrieve format if not done already
+
+    m_format = new ContextFormat();
+
+    const auto current = eglGetCurrentContext();
+    const auto currentDisplay = eglGetCurrentDisplay();
+    const auto currentDraw = eglGetCurrentSurface(EGL_DRAW);
+    const auto currentRead = eglGetCurrentSurface(EGL_READ);
+
+    if (current != m_context)
+        makeCurrent();
+
+    m_format->setVersion(retrieveVersion());
+
+    if (current != m_context)
+    {
+        if (current != EGL_NO_CONTEXT)
+            eglMakeCurrent(currentDisplay, currentDraw, currentRead, current);
+        else
+            doneCurrent();
+    }
+
+    return *m_format;
+}
+
+void Context::makeCurrent() const
+{
+    eglMakeCurrent(m_display, m_surface, m_surface, m_context);
+}
+
+void Context::doneCurrent() const
+{
+    if (eglGetCurrentContext() == m_context)
+        eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+}
+
+} // namespace gloperate_headless
@@ -0,0 +1,141 @@
+#include <gloperate-headless/Renderer.h>
+
+#include <algorithm>
+#include <cassert>
+
+#include <glbinding/gl/enum.h>
+#include <glbinding/gl/functions.h>
+
+#include <globjects/globjects.h>
+#include <globjects/Framebuffer.h>
+#include <globjects/Renderbuffer.h>
+#include <globjects/Texture.h>
+
+#include <gloperate/painter/Painter.h>
+#include <gloperate/painter/AbstractViewportCapability.h>
+#include <gloperate/painter/AbstractTargetFramebufferCapability.h>
+#include <gloperate/painter/AbstractVirtualTimeCapability.h>
+
+#include <gloperate-headless/Context.h>
+
+
+using namespace gloperate;
+
+namespace gloperate_headless
+{
+
+bool Renderer::isApplicableTo(Painter * painter)
+{
+    return painter
+        && painter->supports<AbstractViewportCapability>()
+        && painter->supports<AbstractTargetFramebufferCapability>();
+}
+
+Renderer::Renderer(Context & context, Painter * painter)
+: m_context(context)
+, m_painter(painter)
+, m_viewportCapability(painter->getCapability<AbstractViewportCapability>())
+, m_framebufferCapability(painter->getCapability<AbstractTargetFramebufferCapability>())
+, m_timeCapability(painter->getCapability<AbstractVirtualTimeCapability>())
+, m_oldFramebuffer(nullptr)
+, m_width(1)
+, m_height(1)
+{
+    assert(isApplicableTo(painter));
+}
+
+Renderer::~Renderer()
+{
+    // The objects have to be deleted while their context is current
+    m_context.makeCurrent();
+
+    if (m_fbo)
+        m_framebufferCapability->setFramebuffer(m_oldFramebuffer);
+
+    m_fbo = nullptr;
+    m_color = nullptr;
+    m_depth = nullptr;
+}
+
+void Renderer::initialize()
+{
+    m_context.makeCurrent();
+
+    globjects::init();
+
+    m_fbo = new globjects::Framebuffer();
+    m_color = globjects::Texture::createDefault(gl::GL_TEXTURE_2D);
+    m_depth = new globjects::Renderbuffer();
+
+    m_fbo->attachTexture(gl::GL_COLOR_ATTACHMENT0, m_color);
+    m_fbo->attachRenderBuffer(gl::GL_DEPTH_ATTACHMENT, m_depth);
+
+    // The painter renders into the framebuffer of the renderer until the renderer is destroyed
+    m_oldFramebuffer = m_framebufferCapability->framebuffer();
+    m_framebufferCapability->setFramebuffer(m_fbo);
+
+    m_painter->initialize();
+
+    resize(m_width, m_height);
+}
+
+int Renderer::width() const
+{
+    return m_width;
+}
+
+int Renderer::height() const
+{
+    return m_height;
+}
+
+void Renderer::resize(int width, int height)
+{
+    m_width = std::max(width, 1);
+    m_height = std::max(height, 1);
+
+    if (!m_fbo)
+        return;
+
+    m_context.makeCurrent();
+
+    m_color->image2D(0, gl::GL_RGBA8, m_width, m_height, 0, gl::GL_RGBA, gl::GL_UNSIGNED_BYTE, nullptr);
+    m_depth->storage(gl::GL_DEPTH_COMPONENT32, m_width, m_height);
+
+    m_viewportCapability->setViewport(0, 0, m_width, m_height);
+}
+
+void Renderer::update(float delta)
+{
+    if (m_timeCapability && m_timeCapability->enabled())
+        m_timeCapability->update(delta);
+}
+
+void Renderer::render(Frame & frame)
+{
+    assert(m_fbo);
+
+    m_context.makeCurrent();
+
+    m_painter->paint();
+
+    const auto rowSize = static_cast<std::size_t>(m_width) * 4;
+
+    frame.width = m_width;
+    frame.height = m_height;
+    frame.pixels.resize(rowSize * m_height);
+
+    m_fbo->bind(gl::GL_READ_FRAMEBUFFER);
+    gl::glReadBuffer(gl::GL_COLOR_ATTACHMENT0);
+    gl::glPixelStorei(gl::GL_PACK_ALIGNMENT, 1);
+    gl::glReadPixels(0, 0, m_width, m_height, gl::GL_RGBA, gl::GL_UNSIGNED_BYTE, frame.pixels.data());
+    m_fbo->unbind(gl::GL_READ_FRAMEBUFFER);
+
+    // OpenGL returns the bottom row first
+    for (std::size_t top = 0, bottom = m_height - 1; top < bottom; ++top, --bottom)
+    {
+        std::swap_ranges(frame.pixels.begin() + top * rowSize, frame.pixels.begin() + (top + 1) * rowSize, frame.pixels.begin() + bottom * rowSize);
+    }
+}
+
+} // namespace gloperate_headless
@@ -3,9 +3,13 @@
 
 #include <memory>
 
+#include <glm/glm.hpp>
+
 #include <globjects/base/ref_ptr.h>
 
 #include <gloperate/painter/Painter.h>
+#include <gloperate/tools/ProgressiveRefinement.h>
+#include <gloperate/tools/RepaintMonitor.h>
 
 #include <gloperate-qt/QtOpenGLWindowBase.h>
 #include <gloperate-qt/TimePropagator.h>
@@ -15,6 +19,7 @@ namespace gloperate
 {
 
 class ResourceManager;
+class ResolutionScaler;
 
 }
 
@@ -70,11 +75,69 @@ public:
     */
     void setPainter(gloperate::Painter * painter);
 
+    /**
+    *  @brief
+    *    Check if the window renders on demand
+    *
+    *  @return
+    *    'true' if the window repaints only on changes, 'false' if it repaints continuously
+    */
+    bool renderOnDemand() const;
+
+    /**
+    *  @brief
+    *    Set if the window renders on demand
+    *
+    *  @param[in] renderOnDemand
+    *    If 'true', the window repaints only when a capability of the painter changed,
+    *    an output of the painter was invalidated, input arrived (see RepaintMonitor),
+    *    or the still image of a progressive painter has not converged yet
+    *    (see ProgressiveRefinement).
+    *    Otherwise, it repaints continuously (default).
+    */
+    void setRenderOnDemand(bool renderOnDemand);
+
+    /**
+    *  @brief
+    *    Check if the window renders at a dynamic resolution
+    *
+    *  @return
+    *    'true' if the resolution is scaled to hold a target frame time, else 'false'
+    */
+    bool dynamicResolution() const;
+
+    /**
+    *  @brief
+    *    Set if the window renders at a dynamic resolution
+    *
+    *  @param[in] enabled
+    *    If 'true', painters with a resolution scale capability are rendered through
+    *    a ResolutionScaler, which lowers the resolution whenever frames take too long
+    *  @param[in] targetFrameTime
+    *    GPU time per frame to hold, in seconds
+    */
+    void setDynamicResolution(bool enabled, float targetFrameTime = 1.0f / 60.0f);
+
+    /**
+    *  @brief
+    *    Get the resolution scaler
+    *
+    *  @return
+    *    Resolution scaler, nullptr if dynamic resolution is disabled or not supported by the painter
+    */
+    gloperate::ResolutionScaler * resolutionScaler() const;
+
 
 protected:
+    void connectRepaintMonitor();
+    void updateResolutionScaler();
+    void releaseResolutionScaler();
+    glm::ivec2 toViewport(int x, int y) const;
+
     virtual void onInitialize() override;
     virtual void onResize(QResizeEvent * event) override;
     virtual void onPaint() override;
+    virtual bool event(QEvent * event) override;
     virtual void keyPressEvent(QKeyEvent * event) override;
     virtual void keyReleaseEvent(QKeyEvent * event) override;
     virtual void mouseMoveEvent(QMouseEvent * event) override;
@@ -88,6 +151,12 @@ protected:
     gloperate::ResourceManager & m_resourceManager;
     gloperate::Painter * m_painter;                    /**< Currently used painter */
     std::unique_ptr<TimePropagator> m_timePropagator;  /**< Time propagator for continous updates */
+    gloperate::RepaintMonitor m_repaintMonitor;        /**< Tells when a repaint is required on demand */
+    gloperate::ProgressiveRefinement m_progressiveRefinement;  /**< Counts the frames the view stays unchanged */
+    bool m_renderOnDemand;                             /**< Repaint only on changes? */
+    std::unique_ptr<gloperate::ResolutionScaler> m_resolutionScaler;  /**< Scales the resolution of the painter, can be nullptr */
+    bool m_dynamicResolution;                          /**< Scale the resolution to hold the target frame time? */
+    float m_targetFrameTime;                           /**< Target frame time for dynamic resolution, in seconds */
     
 };
 
@@ -46,6 +46,22 @@ public:
     
     void setCapability(gloperate::AbstractVirtualTimeCapability * capability);
 
+    /**
+    *  @brief
+    *    Stop the timer while there is nothing to animate
+    *
+    *  @param[in] renderOnDemand
+    *    If 'true', the timer stops while no capability is set or it is disabled,
+    *    instead of updating the window continuously. resume() restarts it.
+    */
+    void setRenderOnDemand(bool renderOnDemand);
+
+    /**
+    *  @brief
+    *    Restart the timer if it was stopped and the capability is enabled
+    */
+    void resume();
+
 protected slots:
     /**
     *  @brief
@@ -58,6 +74,7 @@ protected:
     gloperate::AbstractVirtualTimeCapability * m_capability; /**< VirtualTimeCapability that is informed about the time change */
     QScopedPointer<QTimer> m_timer; /**< Qt timer for continuous updates */
     gloperate::ChronoTimer m_time;  /**< Time measurement */
+    bool m_renderOnDemand;          /**< Stop the timer while there is nothing to animate? */
 };
 
 } // namespace gloperate_qt
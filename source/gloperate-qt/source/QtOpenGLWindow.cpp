@@ -1,7 +1,9 @@
 #include "gloperate-qt/QtOpenGLWindow.h"
 
 #include <gloperate-qt/qt-includes-begin.h>
+#include <QCoreApplication>
 #include <QResizeEvent>
+#include <QThread>
 #include <QKeyEvent>
 #include <QMouseEvent>
 #include <QWheelEvent>
@@ -19,6 +21,7 @@
 #include <gloperate/painter/AbstractViewportCapability.h>
 #include <gloperate/painter/AbstractInputCapability.h>
 #include <gloperate/resources/ResourceManager.h>
+#include <gloperate/tools/ResolutionScaler.h>
 #include <gloperate/tools/ScreenshotTool.h>
 
 #include <gloperate-qt/QtEventTransformer.h>
@@ -36,7 +39,11 @@ QtOpenGLWindow::QtOpenGLWindow(gloperate::ResourceManager & resourceManager)
 :   m_resourceManager(resourceManager)
 ,   m_painter(nullptr)
 ,   m_timePropagator(nullptr)
+,   m_renderOnDemand(false)
+,   m_dynamicResolution(false)
+,   m_targetFrameTime(1.0f / 60.0f)
 {
+    connectRepaintMonitor();
 }
 
 /**
@@ -48,7 +55,11 @@ QtOpenGLWindow::QtOpenGLWindow(gloperate::ResourceManager & resourceManager, con
 ,   m_resourceManager(resourceManager)
 ,   m_painter(nullptr)
 ,   m_timePropagator(nullptr)
+,   m_renderOnDemand(false)
+,   m_dynamicResolution(false)
+,   m_targetFrameTime(1.0f / 60.0f)
 {
+    connectRepaintMonitor();
 }
 
 /**
@@ -57,6 +68,7 @@ QtOpenGLWindow::QtOpenGLWindow(gloperate::ResourceManager & resourceManager, con
 */
 QtOpenGLWindow::~QtOpenGLWindow()
 {
+    releaseResolutionScaler();
 }
 
 /**
@@ -74,8 +86,13 @@ Painter * QtOpenGLWindow::painter() const
 */
 void QtOpenGLWindow::setPainter(Painter * painter)
 {
+    // The scaler holds on to the capabilities of the old painter
+    releaseResolutionScaler();
+
     // Save painter
     m_painter = painter;
+    m_repaintMonitor.setPainter(painter);
+    m_progressiveRefinement.setPainter(painter);
 
     // Destroy old time propagator
     m_timePropagator = nullptr;
@@ -84,6 +101,7 @@ void QtOpenGLWindow::setPainter(Painter * painter)
         return;
     
     m_timePropagator = make_unique<TimePropagator>(this);
+    m_timePropagator->setRenderOnDemand(m_renderOnDemand);
 
     // Check for virtual time capability
     if (m_painter->supports<AbstractVirtualTimeCapability>())
@@ -92,6 +110,91 @@ void QtOpenGLWindow::setPainter(Painter * painter)
     m_initialized = false;
 }
 
+bool QtOpenGLWindow::renderOnDemand() const
+{
+    return m_renderOnDemand;
+}
+
+void QtOpenGLWindow::setRenderOnDemand(bool renderOnDemand)
+{
+    m_renderOnDemand = renderOnDemand;
+
+    if (m_timePropagator)
+        m_timePropagator->setRenderOnDemand(renderOnDemand);
+
+    updateGL();
+}
+
+bool QtOpenGLWindow::dynamicResolution() const
+{
+    return m_dynamicResolution;
+}
+
+void QtOpenGLWindow::setDynamicResolution(bool enabled, float targetFrameTime)
+{
+    m_dynamicResolution = enabled;
+    m_targetFrameTime = targetFrameTime;
+
+    // The scaler is created or released on the next paint, where the context is current
+    updateGL();
+}
+
+ResolutionScaler * QtOpenGLWindow::resolutionScaler() const
+{
+    return m_resolutionScaler.get();
+}
+
+void QtOpenGLWindow::connectRepaintMonitor()
+{
+    m_repaintMonitor.repaintRequested.connect([this]()
+    {
+        if (!m_renderOnDemand)
+            return;
+
+        // May be emitted on a worker thread, where only posting the event is safe
+        if (QThread::currentThread() == thread())
+            updateGL();
+        else
+            QCoreApplication::postEvent(this, new QEvent(QEvent::UpdateRequest));
+    });
+}
+
+void QtOpenGLWindow::updateResolutionScaler()
+{
+    if (!m_dynamicResolution || !ResolutionScaler::isApplicableTo(m_painter))
+    {
+        // Restores the painter's output, the context is current while painting
+        m_resolutionScaler = nullptr;
+        return;
+    }
+
+    if (!m_resolutionScaler)
+    {
+        m_resolutionScaler = make_unique<ResolutionScaler>(m_painter);
+        m_resolutionScaler->initialize();
+    }
+
+    if (m_resolutionScaler->controller().targetFrameTime() != m_targetFrameTime)
+        m_resolutionScaler->controller().setTargetFrameTime(m_targetFrameTime);
+}
+
+void QtOpenGLWindow::releaseResolutionScaler()
+{
+    if (!m_resolutionScaler)
+        return;
+
+    makeCurrent();
+    m_resolutionScaler = nullptr;
+    doneCurrent();
+}
+
+glm::ivec2 QtOpenGLWindow::toViewport(int x, int y) const
+{
+    const glm::ivec2 position(x * devicePixelRatio(), y * devicePixelRatio());
+
+    return m_resolutionScaler ? m_resolutionScaler->mapToViewport(position) : position;
+}
+
 void QtOpenGLWindow::onInitialize()
 {
     // Initialize globjects
@@ -131,8 +234,27 @@ void QtOpenGLWindow::onResize(QResizeEvent * event)
 void QtOpenGLWindow::onPaint()
 {
     if (m_painter) {
-        // Call painter
-        m_painter->paint();
+        updateResolutionScaler();
+
+        // Call painter, through the scaler if rendering at a reduced resolution
+        m_repaintMonitor.beginPaint();
+        m_progressiveRefinement.beginPaint();
+
+        if (m_resolutionScaler)
+            m_resolutionScaler->paint();
+        else
+            m_painter->paint();
+
+        m_progressiveRefinement.endPaint();
+        m_repaintMonitor.endPaint();
+
+        // A still image that has not converged yet is refined by the next frame
+        if (m_progressiveRefinement.isRefining())
+            m_repaintMonitor.requestRepaint();
+
+        // Virtual time may have been enabled since the timer stopped
+        if (m_timePropagator)
+            m_timePropagator->resume();
     }
     else
     {
@@ -145,6 +267,28 @@ void QtOpenGLWindow::onPaint()
     }
 }
 
+bool QtOpenGLWindow::event(QEvent * event)
+{
+    switch (event->type())
+    {
+    case QEvent::KeyPress:
+    case QEvent::KeyRelease:
+    case QEvent::MouseMove:
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonRelease:
+    case QEvent::MouseButtonDblClick:
+    case QEvent::Wheel:
+        // Input may change what the painter shows
+        m_repaintMonitor.requestRepaint();
+        break;
+
+    default:
+        break;
+    }
+
+    return QtOpenGLWindowBase::event(event);
+}
+
 void QtOpenGLWindow::keyPressEvent(QKeyEvent * event)
 {
     makeCurrent();
@@ -185,26 +329,30 @@ void QtOpenGLWindow::keyReleaseEvent(QKeyEvent * event)
 
 void QtOpenGLWindow::mouseMoveEvent(QMouseEvent * event)
 {
+    const glm::ivec2 position = toViewport(event->x(), event->y());
+
     // Check for input capability
     if (m_painter && m_painter->supports<gloperate::AbstractInputCapability>())
     {
         // Propagate event
         m_painter->getCapability<gloperate::AbstractInputCapability>()->onMouseMove(
-            event->x() * devicePixelRatio(),
-            event->y() * devicePixelRatio()
+            position.x,
+            position.y
         );
     }
 }
 
 void QtOpenGLWindow::mousePressEvent(QMouseEvent * event)
 {
+    const glm::ivec2 position = toViewport(event->x(), event->y());
+
     // Check for input capability
     if (m_painter && m_painter->supports<gloperate::AbstractInputCapability>())
     {
         // Propagate event
         m_painter->getCapability<gloperate::AbstractInputCapability>()->onMousePress(
-            event->x() * devicePixelRatio(),
-            event->y() * devicePixelRatio(),
+            position.x,
+            position.y,
             QtEventTransformer::fromQtMouseButton(event->button())
         );
     }
@@ -212,13 +360,15 @@ void QtOpenGLWindow::mousePressEvent(QMouseEvent * event)
 
 void QtOpenGLWindow::mouseReleaseEvent(QMouseEvent * event)
 {
+    const glm::ivec2 position = toViewport(event->x(), event->y());
+
     // Check for input capability
     if (m_painter && m_painter->supports<gloperate::AbstractInputCapability>())
     {
         // Propagate event
         m_painter->getCapability<gloperate::AbstractInputCapability>()->onMouseRelease(
-            event->x() * devicePixelRatio(),
-            event->y() * devicePixelRatio(),
+            position.x,
+            position.y,
             QtEventTransformer::fromQtMouseButton(event->button())
         );
     }
@@ -226,13 +376,15 @@ void QtOpenGLWindow::mouseReleaseEvent(QMouseEvent * event)
 
 void QtOpenGLWindow::mouseDoubleClickEvent(QMouseEvent * event)
 {
+    const glm::ivec2 position = toViewport(event->x(), event->y());
+
     // Check for input capability
     if (m_painter && m_painter->supports<gloperate::AbstractInputCapability>())
     {
         // Propagate event
         m_painter->getCapability<gloperate::AbstractInputCapability>()->onMouseDoubleClick(
-            event->x() * devicePixelRatio(),
-            event->y() * devicePixelRatio(),
+            position.x,
+            position.y,
             QtEventTransformer::fromQtMouseButton(event->button())
         );
     }
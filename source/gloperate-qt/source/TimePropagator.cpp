@@ -15,6 +15,7 @@ TimePropagator::TimePropagator(gloperate_qt::QtOpenGLWindowBase * window)
 ,   m_capability(nullptr)
 ,   m_timer(new QTimer())
 ,   m_time(false, true)
+,   m_renderOnDemand(false)
 {
     // Connect to timer signal
     connect(m_timer.data(), SIGNAL(timeout()), this, SLOT(update()));
@@ -34,12 +35,38 @@ void TimePropagator::setCapability(gloperate::AbstractVirtualTimeCapability * ca
         m_time.stop();
 }
 
+void TimePropagator::setRenderOnDemand(bool renderOnDemand)
+{
+    m_renderOnDemand = renderOnDemand;
+
+    resume();
+}
+
+void TimePropagator::resume()
+{
+    if (m_timer->isActive())
+        return;
+
+    if (m_renderOnDemand && !(m_capability && m_capability->enabled()))
+        return;
+
+    // Time does not advance while stopped
+    m_time.reset();
+    m_timer->start(0);
+}
+
 /**
 *  @brief
 *    Called by the timer when the timer has elapsed
 */
 void TimePropagator::update()
 {
+    if (m_renderOnDemand && !(m_capability && m_capability->enabled()))
+    {
+        m_timer->stop();
+        return;
+    }
+
     if (!m_capability)
     {
         m_window->updateGL();
@@ -133,6 +133,9 @@ Viewer::~Viewer()
 
     MessageHandler::dettach(*m_messagesLog);
     MessageHandler::dettach(*m_messagesStatus);
+
+    // The canvas outlives the painter, it has to disconnect from it first
+    m_canvas->setPainter(nullptr);
 }
 
 void Viewer::attachMessageWidgets()
@@ -265,13 +268,16 @@ void Viewer::switchToPainter(bool)
 
     Q_ASSERT(plugin);
 
-    m_currentPainter.reset(plugin->createPainter(*m_resourceManager));
+    std::unique_ptr<gloperate::Painter> painter(plugin->createPainter(*m_resourceManager));
 
     // check for painter context format requirements
     // ToDo:
 
-    m_canvas->setPainter(m_currentPainter.get());
-    m_mapping->setPainter(m_currentPainter.get());
+    // The canvas disconnects from the old painter, so it is deleted afterwards
+    m_canvas->setPainter(painter.get());
+    m_mapping->setPainter(painter.get());
+
+    m_currentPainter = std::move(painter);
 
     m_canvas->initialize();
 
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include <glm/fwd.hpp>
+
+#include <glbinding/gl/types.h>
+#include <glbinding/gl/bitfield.h>
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace globjects
+{
+
+class Framebuffer;
+class Program;
+class Texture;
+class VertexArray;
+
+}
+
+
+namespace gloperate
+{
+
+class StateCache;
+
+
+/** \brief OpenGL commands recorded on any thread and replayed on the thread owning the context.
+
+    Preparing thousands of draws costs CPU time that is serialized on the context thread if the
+    calls are issued directly. A command list records the same work as typed commands without
+    calling OpenGL, so stages can fill it from worker threads (see AbstractStage::commands()).
+    The pipeline replays the lists on the context thread in pipeline order.
+
+    Recording only reads the names of the globjects objects and never calls OpenGL. Uniforms are
+    set by location, which has to be queried on the context thread beforehand, e.g., in
+    AbstractStage::initialize(). Programs have to be linked before the list is replayed, because
+    replaying uses them as they are.
+
+    State changes are replayed through a StateCache and thereby filtered like direct calls. Draws,
+    uniforms and vertex array bindings are issued through a function table, which is backed by
+    glbinding by default and can be replaced by a mock to test without a context.
+
+    A list is not thread-safe, it is recorded by one thread at a time.
+*/
+class GLOPERATE_API CommandList
+{
+public:
+    struct Functions
+    {
+        std::function<void(gl::ClearBufferMask)> clear;
+        std::function<void(gl::GLuint)> bindVertexArray;
+        std::function<void(gl::GLint, gl::GLint)> uniform1i;
+        std::function<void(gl::GLint, gl::GLsizei, const gl::GLfloat *)> uniform1fv;
+        std::function<void(gl::GLint, gl::GLsizei, const gl::GLfloat *)> uniform2fv;
+        std::function<void(gl::GLint, gl::GLsizei, const gl::GLfloat *)> uniform3fv;
+        std::function<void(gl::GLint, gl::GLsizei, const gl::GLfloat *)> uniform4fv;
+        std::function<void(gl::GLint, gl::GLsizei, gl::GLboolean, const gl::GLfloat *)> uniformMatrix4fv;
+        std::function<void(gl::GLenum, gl::GLint, gl::GLsizei)> drawArrays;
+        std::function<void(gl::GLenum, gl::GLsizei, gl::GLenum, const void *)> drawElements;
+    };
+
+    /** Function table calling OpenGL through glbinding */
+    static Functions glFunctions();
+
+public:
+    CommandList();
+    explicit CommandList(const Functions & functions);
+    virtual ~CommandList();
+
+    CommandList(const CommandList &) = delete;
+    CommandList & operator=(const CommandList &) = delete;
+
+    // State, replayed through the StateCache
+    void enable(gl::GLenum capability);
+    void disable(gl::GLenum capability);
+    void viewport(gl::GLint x, gl::GLint y, gl::GLsizei width, gl::GLsizei height);
+    void clearColor(gl::GLfloat red, gl::GLfloat green, gl::GLfloat blue, gl::GLfloat alpha);
+    void depthMask(bool enabled);
+
+    /** Binds the framebuffer, nullptr binds the default framebuffer */
+    void bindFramebuffer(gl::GLenum target, const globjects::Framebuffer * framebuffer);
+    /** Binds the texture to the texture unit, e.g., GL_TEXTURE0 */
+    void bindTexture(gl::GLenum unit, const globjects::Texture * texture);
+    void useProgram(const globjects::Program * program);
+
+    // Commands issued through the function table
+    void clear(gl::ClearBufferMask mask);
+    void bindVertexArray(const globjects::VertexArray * vertexArray);
+
+    /** Sets a uniform of the program in use at replay time */
+    void uniform(gl::GLint location, gl::GLint value);
+    void uniform(gl::GLint location, gl::GLfloat value);
+    void uniform(gl::GLint location, const glm::vec2 & value);
+    void uniform(gl::GLint location, const glm::vec3 & value);
+    void uniform(gl::GLint location, const glm::vec4 & value);
+    void uniform(gl::GLint location, const glm::mat4 & value);
+
+    void drawArrays(gl::GLenum mode, gl::GLint first, gl::GLsizei count);
+    /** Draws from the element buffer of the bound vertex array, starting at the byte offset */
+    void drawElements(gl::GLenum mode, gl::GLsizei count, gl::GLenum type, std::size_t offset = 0);
+
+    /** Issues the recorded commands in order, on the thread owning the context */
+    void replay(StateCache & stateCache) const;
+
+    /** Removes all commands, but keeps the memory for recording the next frame */
+    void reset();
+
+    bool empty() const;
+    std::size_t size() const;
+
+protected:
+    enum class Opcode : unsigned char
+    {
+        Enable
+    ,   Disable
+    ,   Viewport
+    ,   ClearColor
+    ,   DepthMask
+    ,   BindFramebuffer
+    ,   BindTexture
+    ,   UseProgram
+    ,   Clear
+    ,   BindVertexArray
+    ,   Uniform1i
+    ,   Uniform1f
+    ,   Uniform2f
+    ,   Uniform3f
+    ,   Uniform4f
+    ,   UniformMatrix4f
+    ,   DrawArrays
+    ,   DrawElements
+    };
+
+    struct Command
+    {
+        Opcode opcode;
+        gl::GLenum enums[2];
+        gl::GLuint name;
+        gl::GLint arguments[4];
+        std::size_t offset;     /**< Into m_floats for uniforms and clear colors, into the element buffer for draws */
+    };
+
+    Command & record(Opcode opcode);
+    void recordFloats(Opcode opcode, gl::GLint location, const gl::GLfloat * values, std::size_t count);
+
+protected:
+    Functions m_functions;
+    std::vector<Command> m_commands;
+    std::vector<gl::GLfloat> m_floats;  /**< Values of all commands, so recording allocates only while the list grows */
+};
+
+} // namespace gloperate
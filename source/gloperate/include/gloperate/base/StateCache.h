@@ -0,0 +1,135 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include <glbinding/gl/types.h>
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace gloperate
+{
+
+/** \brief Shadows OpenGL state and drops calls that would not change it.
+
+    Stages route their state changes through the cache of their pipeline (see
+    AbstractStage::stateCache()) instead of calling OpenGL directly, so that a stage
+    restoring state which the next stage changes again costs no driver calls.
+
+    The cache issues the calls through a function table, which is backed by glbinding
+    by default and can be replaced by a mock to test without a context. Shadowed state
+    is unknown until it is set through the cache, so the first call of each kind is
+    always issued. Code that changes state behind the cache, e.g., globjects binding
+    objects for non-DSA operations, has to be followed by invalidate(), or by the
+    invalidation of the affected state only. Binding an object through the cache before
+    globjects operates on it keeps the shadowed state valid, as globjects binds the same
+    object then.
+
+    The cache is not thread-safe, it is only used on the thread owning the context.
+*/
+class GLOPERATE_API StateCache
+{
+public:
+    struct Functions
+    {
+        std::function<void(gl::GLenum)> enable;
+        std::function<void(gl::GLenum)> disable;
+        std::function<void(gl::GLint, gl::GLint, gl::GLsizei, gl::GLsizei)> viewport;
+        std::function<void(gl::GLfloat, gl::GLfloat, gl::GLfloat, gl::GLfloat)> clearColor;
+        std::function<void(gl::GLboolean)> depthMask;
+        std::function<void(gl::GLenum, gl::GLuint)> bindFramebuffer;
+        std::function<void(gl::GLenum)> activeTexture;
+        std::function<void(gl::GLenum, gl::GLuint)> bindTexture;
+        std::function<void(gl::GLuint)> useProgram;
+    };
+
+    struct Statistics
+    {
+        std::size_t issued;     /**< Calls passed on to OpenGL */
+        std::size_t filtered;   /**< Redundant calls that were dropped */
+    };
+
+    /** Function table calling OpenGL through glbinding */
+    static Functions glFunctions();
+
+public:
+    StateCache();
+    explicit StateCache(const Functions & functions);
+    virtual ~StateCache();
+
+    StateCache(const StateCache &) = delete;
+    StateCache & operator=(const StateCache &) = delete;
+
+    void enable(gl::GLenum capability);
+    void disable(gl::GLenum capability);
+    void setEnabled(gl::GLenum capability, bool enabled);
+
+    void viewport(gl::GLint x, gl::GLint y, gl::GLsizei width, gl::GLsizei height);
+    void clearColor(gl::GLfloat red, gl::GLfloat green, gl::GLfloat blue, gl::GLfloat alpha);
+    void depthMask(bool enabled);
+
+    /** GL_FRAMEBUFFER binds the draw and the read framebuffer */
+    void bindFramebuffer(gl::GLenum target, gl::GLuint framebuffer);
+
+    void activeTexture(gl::GLenum unit);
+    /** Binds to the active texture unit */
+    void bindTexture(gl::GLenum target, gl::GLuint texture);
+    /** Binds to the given unit, which becomes the active one if the binding changes */
+    void bindTexture(gl::GLenum unit, gl::GLenum target, gl::GLuint texture);
+
+    void useProgram(gl::GLuint program);
+
+    /** Forgets all shadowed state, so the next call of each kind is issued */
+    void invalidate();
+
+    /** Forgets the texture bindings of all units, e.g., after globjects specified a texture */
+    void invalidateTextures();
+
+    /** Invalidates and starts counting the calls of a new frame */
+    void beginFrame();
+
+    /** Counts of the calls since the last beginFrame() */
+    const Statistics & statistics() const;
+
+protected:
+    template <typename T>
+    struct Shadowed
+    {
+        bool known;
+        T value;
+    };
+
+    struct TextureBinding
+    {
+        gl::GLenum unit;
+        gl::GLenum target;
+        gl::GLuint texture;
+    };
+
+    bool changes(Shadowed<bool> & state, bool value);
+    Shadowed<bool> & capability(gl::GLenum capability);
+
+    void issued();
+    void filtered();
+
+protected:
+    Functions m_functions;
+    Statistics m_statistics;
+
+    // Few entries each, so linear search beats hashing and keeps calls allocation-free once warm
+    std::vector<std::pair<gl::GLenum, Shadowed<bool>>> m_capabilities;
+    std::vector<TextureBinding> m_textureBindings;
+
+    Shadowed<std::array<gl::GLint, 4>> m_viewport;
+    Shadowed<std::array<gl::GLfloat, 4>> m_clearColor;
+    Shadowed<bool> m_depthMask;
+    Shadowed<gl::GLuint> m_drawFramebuffer;
+    Shadowed<gl::GLuint> m_readFramebuffer;
+    Shadowed<gl::GLenum> m_activeTexture;
+    Shadowed<gl::GLuint> m_program;
+};
+
+} // namespace gloperate
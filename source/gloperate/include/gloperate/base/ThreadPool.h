@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace gloperate
+{
+
+/** \brief Fixed-size pool of worker threads with per-worker task queues.
+
+    Tasks are distributed round-robin onto the queues of the workers. A worker
+    that runs out of tasks steals from the other queues before going to sleep,
+    so uneven task durations do not leave workers idle.
+
+    Threads that wait for submitted tasks to complete can help out by calling
+    runPendingTask() instead of blocking.
+*/
+class GLOPERATE_API ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+public:
+    ThreadPool(unsigned int numThreads);
+    virtual ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool & operator=(const ThreadPool &) = delete;
+
+    unsigned int numThreads() const;
+
+    void submit(Task task);
+
+    /** Runs one queued task on the calling thread.
+        \return true if a task was run, false if all queues were empty
+    */
+    bool runPendingTask();
+
+protected:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void work(unsigned int index);
+
+    bool popTask(unsigned int index, Task & task);
+    bool stealTask(unsigned int index, Task & task);
+
+protected:
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+
+    std::atomic<unsigned int> m_numPending;
+    std::atomic<unsigned int> m_nextQueue;
+    bool m_stop;
+};
+
+} // namespace gloperate
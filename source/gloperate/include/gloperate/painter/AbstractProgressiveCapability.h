@@ -0,0 +1,80 @@
+
+#pragma once
+
+
+#include <gloperate/gloperate_api.h>
+#include <gloperate/painter/AbstractCapability.h>
+
+
+namespace gloperate 
+{
+
+
+/**
+*  @brief
+*    Capability that allows a painter to refine its image over successive frames
+*
+*    If a painter supports this capability, the host reports the number of frames
+*    rendered since the view last changed (see ProgressiveRefinement). On frame 0,
+*    the painter renders its regular, cheap image and clears its history. On later
+*    frames, it renders jittered or partial work and accumulates it into its history,
+*    until the image has converged after numFrames() frames. Changes of the camera,
+*    projection or viewport capability restart at frame 0.
+*/
+class GLOPERATE_API AbstractProgressiveCapability : public AbstractCapability
+{
+public:
+    /**
+    *  @brief
+    *    Constructor
+    */
+    AbstractProgressiveCapability();
+
+    /**
+    *  @brief
+    *    Destructor
+    */
+    virtual ~AbstractProgressiveCapability();
+
+    /**
+    *  @brief
+    *    Get index of the current frame since the view last changed
+    *
+    *  @return
+    *    Frame index, 0 if the history has to be cleared
+    */
+    virtual unsigned int frameIndex() const = 0;
+
+    /**
+    *  @brief
+    *    Set index of the current frame since the view last changed
+    *
+    *  @param[in] frameIndex
+    *    Frame index, set by the host before painting
+    *
+    *  @remarks
+    *    Does not mark the capability as changed, as it changes on every refining frame.
+    */
+    virtual void setFrameIndex(unsigned int frameIndex) = 0;
+
+    /**
+    *  @brief
+    *    Get number of frames until the image has converged
+    *
+    *  @return
+    *    Number of frames, the host stops repainting a still view after that many frames
+    */
+    virtual unsigned int numFrames() const = 0;
+
+    /**
+    *  @brief
+    *    Check if the image has converged
+    *
+    *  @return
+    *    'true' if frameIndex() reached numFrames(), else 'false'
+    */
+    bool isConverged() const;
+};
+
+
+} // namespace gloperate
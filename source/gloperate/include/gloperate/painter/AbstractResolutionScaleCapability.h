@@ -0,0 +1,69 @@
+
+#pragma once
+
+
+#include <gloperate/gloperate_api.h>
+#include <gloperate/painter/AbstractCapability.h>
+
+
+namespace gloperate 
+{
+
+
+/**
+*  @brief
+*    Capability that allows the host to request a render scale
+*
+*    If a painter supports this capability, the host may render it at a fraction
+*    of the output resolution and upsample the result, e.g., to hold a frame rate
+*    on slow machines (see ResolutionScaler). The painter then sees the scaled
+*    resolution through its viewport capability, so everything derived from the
+*    viewport, like the aspect ratio of its projection, adapts as on a resize.
+*    By supporting the capability, a painter declares that its output holds up
+*    to being upsampled.
+*/
+class GLOPERATE_API AbstractResolutionScaleCapability : public AbstractCapability
+{
+public:
+    /**
+    *  @brief
+    *    Constructor
+    */
+    AbstractResolutionScaleCapability();
+
+    /**
+    *  @brief
+    *    Destructor
+    */
+    virtual ~AbstractResolutionScaleCapability();
+
+    /**
+    *  @brief
+    *    Get render scale
+    *
+    *  @return
+    *    Scale of the rendered resolution relative to the output, in [minimumScale(), 1]
+    */
+    virtual float scale() const = 0;
+
+    /**
+    *  @brief
+    *    Set render scale
+    *
+    *  @param[in] scale
+    *    Requested scale, clamped to [minimumScale(), 1]
+    */
+    virtual void setScale(float scale) = 0;
+
+    /**
+    *  @brief
+    *    Get the lowest scale the painter is still usable at
+    *
+    *  @return
+    *    Minimum scale in (0, 1]
+    */
+    virtual float minimumScale() const = 0;
+};
+
+
+} // namespace gloperate
@@ -85,6 +85,52 @@ public:
     */
     virtual void setLoopDuration(float duration) = 0;
 
+    /**
+    *  @brief
+    *    Get fixed time step
+    *
+    *  @return
+    *    Duration of a fixed step (in seconds), 0 if time advances by the delta of each update
+    */
+    virtual float fixedStep() const = 0;
+
+    /**
+    *  @brief
+    *    Set fixed time step
+    *
+    *  @param[in] step
+    *    Duration of a fixed step (in seconds), 0 to advance by the delta of each update
+    *
+    *  @remarks
+    *    With a fixed step, update() accumulates the deltas passed by the host and advances
+    *    time in whole steps only. Time then takes the same values on every machine, no matter
+    *    how fast the host updates, so animations can be reproduced exactly. The remainder
+    *    not yet stepped is available as interpolation() for smooth display.
+    */
+    virtual void setFixedStep(float step) = 0;
+
+    /**
+    *  @brief
+    *    Get number of fixed steps taken by the last update
+    *
+    *  @return
+    *    Number of steps, 1 for every update without a fixed step
+    */
+    virtual unsigned int steps() const = 0;
+
+    /**
+    *  @brief
+    *    Get fraction of a fixed step accumulated but not yet taken
+    *
+    *  @return
+    *    Interpolation factor in [0, 1), 0 without a fixed step
+    *
+    *  @remarks
+    *    Painters that keep the state of the last two steps blend them by this factor,
+    *    others may display time() + interpolation() * fixedStep().
+    */
+    virtual float interpolation() const = 0;
+
     /**
     *  @brief
     *    Update virtual time
@@ -93,6 +139,12 @@ public:
     *    Time delta (in seconds)
     */
     virtual void update(float delta) = 0;
+
+    /**
+    *  @brief
+    *    Reset virtual time and accumulated deltas to 0
+    */
+    virtual void reset() = 0;
 };
 
 
@@ -2,6 +2,8 @@
 #pragma once
 
 #include <memory>
+#include <typeindex>
+#include <unordered_map>
 #include <vector>
 
 #include <reflectionzeug/Object.h>
@@ -94,10 +96,24 @@ public:
     *
     *  @return
     *    Pointer to the capability, nullptr if the capability is not supported
+    *
+    *  @remarks
+    *    The capability interfaces of gloperate (AbstractViewportCapability, ...) are
+    *    resolved by addCapability(), so their lookups take constant time and only
+    *    read the painter. Other types are searched in all capabilities.
     */
     template <typename Capability>
     Capability * getCapability() const;
 
+    /**
+    *  @brief
+    *    Get all capabilities
+    *
+    *  @return
+    *    Capabilities in the order they were added
+    */
+    const std::vector<AbstractCapability *> & capabilities() const;
+
 
 protected:
     /**
@@ -131,6 +147,9 @@ protected:
 protected:
     ResourceManager & m_resourceManager; /**< Resource manager, e.g., to load and save textures */
     std::vector<AbstractCapability *>  m_capabilities; /**< List of supported capabilities */
+
+    /** Capability interface -> first capability cast to it, or nullptr if none matches. Filled by addCapability(). */
+    std::unordered_map<std::type_index, void *> m_capabilityRegistry;
 };
 
 
@@ -3,6 +3,8 @@
 
 #include <gloperate/painter/Painter.h>
 
+#include <typeinfo>
+
 
 namespace gloperate
 {
@@ -17,6 +19,14 @@ bool Painter::supports() const
 template <typename Capability>
 Capability * Painter::getCapability() const
 {
+    const auto it = m_capabilityRegistry.find(typeid(Capability));
+
+    if (it != m_capabilityRegistry.end())
+    {
+        // Stored after the cast, as it may adjust the pointer for multiple inheritance
+        return static_cast<Capability *>(it->second);
+    }
+
     for (auto & capability : m_capabilities)
     {
         Capability * castCapability = dynamic_cast<Capability *>(capability);
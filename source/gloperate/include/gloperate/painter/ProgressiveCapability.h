@@ -0,0 +1,56 @@
+
+#pragma once
+
+
+#include <gloperate/gloperate_api.h>
+#include <gloperate/painter/AbstractProgressiveCapability.h>
+
+
+namespace gloperate
+{
+
+
+/**
+*  @brief
+*    Default implementation for AbstractProgressiveCapability
+*/
+class GLOPERATE_API ProgressiveCapability : public AbstractProgressiveCapability
+{
+public:
+    /**
+    *  @brief
+    *    Constructor
+    *
+    *  @param[in] numFrames
+    *    Number of frames until the image has converged
+    */
+    ProgressiveCapability(unsigned int numFrames = 64);
+
+    /**
+    *  @brief
+    *    Destructor
+    */
+    virtual ~ProgressiveCapability();
+
+    // Virtual functions from AbstractProgressiveCapability
+    virtual unsigned int frameIndex() const override;
+    virtual void setFrameIndex(unsigned int frameIndex) override;
+    virtual unsigned int numFrames() const override;
+
+    /**
+    *  @brief
+    *    Set number of frames until the image has converged
+    *
+    *  @param[in] numFrames
+    *    Number of frames
+    */
+    void setNumFrames(unsigned int numFrames);
+
+
+protected:
+    unsigned int m_frameIndex;  /**< Index of the current frame since the view last changed */
+    unsigned int m_numFrames;   /**< Number of frames until the image has converged */
+};
+
+
+} // namespace gloperate
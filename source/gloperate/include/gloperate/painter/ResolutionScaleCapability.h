@@ -0,0 +1,47 @@
+
+#pragma once
+
+
+#include <gloperate/gloperate_api.h>
+#include <gloperate/painter/AbstractResolutionScaleCapability.h>
+
+
+namespace gloperate
+{
+
+
+/**
+*  @brief
+*    Default implementation for AbstractResolutionScaleCapability
+*/
+class GLOPERATE_API ResolutionScaleCapability : public AbstractResolutionScaleCapability
+{
+public:
+    /**
+    *  @brief
+    *    Constructor
+    *
+    *  @param[in] minimumScale
+    *    Lowest scale the painter is still usable at, in (0, 1]
+    */
+    ResolutionScaleCapability(float minimumScale = 0.5f);
+
+    /**
+    *  @brief
+    *    Destructor
+    */
+    virtual ~ResolutionScaleCapability();
+
+    // Virtual functions from AbstractResolutionScaleCapability
+    virtual float scale() const override;
+    virtual void setScale(float scale) override;
+    virtual float minimumScale() const override;
+
+
+protected:
+    float m_scale;          /**< Render scale */
+    float m_minimumScale;   /**< Lowest allowed render scale */
+};
+
+
+} // namespace gloperate
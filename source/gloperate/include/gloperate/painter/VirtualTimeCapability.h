@@ -34,7 +34,16 @@ public:
     virtual float time() const override;
     virtual float delta() const override;
     virtual void setLoopDuration(float duration) override;
+    virtual float fixedStep() const override;
+    virtual void setFixedStep(float step) override;
+    virtual unsigned int steps() const override;
+    virtual float interpolation() const override;
     virtual void update(float delta) override;
+    virtual void reset() override;
+
+
+public:
+    static const unsigned int maxSteps = 8; /**< Fixed steps per update at most, longer deltas are cut to avoid falling behind ever more */
 
 
 protected:
@@ -50,6 +59,9 @@ protected:
     float m_duration;   /**< Duration after which time is reset to 0 (in seconds) */ 
     float m_time;       /**< Current time (in seconds) */
     float m_delta;      /**< Last time delta  (in seconds)*/
+    float m_fixedStep;  /**< Duration of a fixed step, 0 if not stepping (in seconds) */
+    float m_accumulator;  /**< Accumulated time not yet stepped (in seconds) */
+    unsigned int m_steps; /**< Number of steps taken by the last update */
 };
 
 
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+
+#include <gloperate/gloperate_api.h>
+
+#include <signalzeug/Signal.h>
+
+
+namespace gloperate
+{
+
+/** \brief Interface of data with separate buffers for producer and consumers, see BufferedData.
+
+    The producer writes a back buffer and publishes it. Consumers keep reading the
+    current (front) value until acquire() makes the oldest published buffer current.
+*/
+class GLOPERATE_API AbstractBufferedData
+{
+public:
+    AbstractBufferedData();
+    virtual ~AbstractBufferedData();
+
+    /** Queues the back buffer for acquire() and moves on to the next free buffer.
+        \return false if no buffer is free, i.e., consumers are N - 1 buffers behind
+    */
+    virtual bool publish() = 0;
+
+    /** Makes the oldest published buffer the current value and invalidates the data.
+        \return false if nothing was published since the last acquire
+    */
+    virtual bool acquire() = 0;
+
+    /** Number of buffers published but not yet acquired */
+    virtual std::size_t numPending() const = 0;
+
+public:
+    /** Emitted after a successful publish(), on the producer's thread */
+    signalzeug::Signal<> published;
+};
+
+} // namespace gloperate
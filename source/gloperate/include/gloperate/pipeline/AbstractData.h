@@ -1,6 +1,11 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <gloperate/gloperate_api.h>
 
@@ -11,11 +16,15 @@ namespace gloperate
 {
 
 class AbstractStage;
+class AbstractInputSlot;
+class AbstractDataSnapshot;
 
 
 class GLOPERATE_API AbstractData
 {
     friend class AbstractStage;
+    friend class AbstractInputSlot;
+    friend class InvalidationTransaction;
 
 public:
     AbstractData(const std::string & name = "");
@@ -33,20 +42,76 @@ public:
 
     virtual std::string qualifiedName() const;
 
+    /** Advances the generation and schedules the stages of all connected input slots.
+        The invalidated signal is emitted afterwards for observers that need a callback.
+        Within an InvalidationTransaction, scheduling and the signal are deferred to its commit.
+    */
     void invalidate();
 
+    /** Generation of the current value, advanced by every invalidation.
+        Generations are drawn from a single counter, so they are unique across all data
+        and can be compared from any thread without synchronization.
+    */
+    std::uint64_t generation() const;
+
     bool matchesName(const std::string & name) const;
 
+    /** Input slots currently connected to this data */
+    const std::vector<AbstractInputSlot *> & consumers() const;
+
     virtual std::string type() const = 0;
 
+    /** Hashes the current value.
+        \return false if the value type provides no std::hash, operator== or copy
+    */
+    virtual bool hashValue(std::size_t & hash) const;
+
+    /** Compares the current value to a snapshot() of a hashable value.
+        \return false if the values differ or the snapshot was taken from data of another type
+    */
+    virtual bool equals(const AbstractDataSnapshot & snapshot) const;
+
+    /** Copies the current value, nullptr if the value type is not copyable */
+    virtual std::unique_ptr<AbstractDataSnapshot> snapshot() const;
+
+    /** Sets the value to a copy taken by snapshot() and invalidates.
+        \return false if the snapshot was taken from data of another type
+    */
+    virtual bool restore(const AbstractDataSnapshot & snapshot);
+
 public:
     signalzeug::Signal<> invalidated;
 
 protected:
     AbstractStage * m_owner;
     std::string m_name;
+    std::atomic<std::uint64_t> m_generation;
+    mutable std::vector<AbstractInputSlot *> m_consumers;  /**< Input slots connected to this data */
+    std::vector<AbstractData *> * m_pendingIn;              /**< Invalidations of the open transaction recording this one */
 
     void setOwner(AbstractStage * owner);
+
+    void addConsumer(AbstractInputSlot * slot) const;
+    void removeConsumer(AbstractInputSlot * slot) const;
+
+    void notifyInvalidated();
+
+    /** Invalidations of the transaction deferring this data's, nullptr if there is none */
+    std::vector<AbstractData *> * openTransaction() const;
+
+    static std::uint64_t nextGeneration();
+
+    static void beginTransaction();
+    static void commitTransaction();
+    static bool isTransactionActive();
+
+    /** Records the processScheduled signal of a stage in the open transaction of the thread or
+        of the stage's pipeline, false if there is none
+    */
+    static bool deferSchedule(AbstractStage * stage);
+
+    static void detachTransaction(std::vector<AbstractData *> & invalidated, std::vector<AbstractStage *> & scheduled);
+    static void deliver(std::vector<AbstractData *> & invalidated, std::vector<AbstractStage *> & scheduled);
 };
 
 } // namespace gloperate
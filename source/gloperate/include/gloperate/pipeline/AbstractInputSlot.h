@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include <gloperate/gloperate_api.h>
 
@@ -17,6 +19,7 @@ class AbstractStage;
 class GLOPERATE_API AbstractInputSlot
 {
     friend class AbstractStage;
+    friend class AbstractData;
 
 public:
     AbstractInputSlot(const std::string & name = "");
@@ -37,8 +40,14 @@ public:
     virtual bool connectTo(const AbstractData & data) = 0;
     virtual bool matchType(const AbstractData & data) = 0;
 
+    /** Compares the generation of the connected data to the one seen by processed(), no signal involved */
     bool hasChanged() const;
 
+    /** Generation of the connected data, 0 if unconnected */
+    std::uint64_t generation() const;
+    std::uint64_t processedGeneration() const;
+
+    /** Forces hasChanged() until the next processed() and schedules the stages using this slot */
     void changed();
     void processed();
 
@@ -59,13 +68,19 @@ public:
 
 protected:
     AbstractStage * m_owner;
+    std::vector<AbstractStage *> m_sharingStages;   /**< Stages that share this input, scheduled on changes like the owner */
     std::string m_name;
 
-    bool m_hasChanged;
+    const AbstractData * m_source;      /**< Data this slot is registered at as consumer */
+    std::uint64_t m_processedGeneration;
     bool m_isOptional;
     bool m_isFeedback;
 
     void setOwner(AbstractStage * owner);
+
+    /** Registers this slot at data, which then schedules the using stages directly on invalidation */
+    void attach(const AbstractData * data);
+    void scheduleStages();
 };
 
 } // namespace gloperate
@@ -1,19 +1,32 @@
 #pragma once
 
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
 
 #include <gloperate/gloperate_api.h>
 
+#include <gloperate/base/StateCache.h>
+
+#include <gloperate/pipeline/BackgroundWorkers.h>
+#include <gloperate/pipeline/InvalidationTransaction.h>
+#include <gloperate/pipeline/OutputCache.h>
+#include <gloperate/pipeline/StageGraph.h>
+#include <gloperate/pipeline/TransientResourcePool.h>
+
 
 namespace gloperate
 {
 
 class AbstractData;
+class AbstractBufferedData;
 class AbstractStage;
 class AbstractInputSlot;
+class PipelineProfiler;
+class ThreadPool;
 template <typename T>
 class Data;
 
@@ -40,8 +53,105 @@ public:
     bool isInitialized() const;
     void initialize();
 
+    /** Executes the stages scheduled since the last execution in topological order.
+        Stages are scheduled when their inputs are invalidated (see AbstractStage::processScheduled),
+        stages that are always processed or have no inputs are scheduled on every execution.
+    */
     virtual void execute();
 
+    /** Number of stages visited by the last execution, i.e., the stages that were scheduled */
+    std::size_t visitedStageCount() const;
+    /** Number of stages processed by the last execution */
+    std::size_t processedStageCount() const;
+
+    /** Records per-stage timings of every execution, see PipelineProfiler */
+    bool isProfilingEnabled() const;
+    void setProfilingEnabled(bool enabled);
+
+    /** Cache of the outputs of memoized stages, see AbstractStage::setMemoized */
+    OutputCache & outputCache();
+    const OutputCache & outputCache() const;
+
+    /** Pooled GPU objects for the transient resources of the stages, see AbstractStage::addTransientResource */
+    TransientResourcePool & transientResources();
+    const TransientResourcePool & transientResources() const;
+
+    /** OpenGL state shared by the stages, invalidated at the start of each execution, see AbstractStage::stateCache */
+    StateCache & stateCache();
+    const StateCache & stateCache() const;
+
+    /** Workers for long-running jobs of the stages, their results are posted to the next execution.
+        Hosts that render on demand connect to BackgroundWorkers::posted to execute again.
+    */
+    BackgroundWorkers & backgroundWorkers();
+    const BackgroundWorkers & backgroundWorkers() const;
+
+    /** Profiler of this pipeline, nullptr unless profiling is enabled */
+    PipelineProfiler * profiler();
+    const PipelineProfiler * profiler() const;
+
+    /** Number of threads used to execute stages, including the calling (context) thread.
+        With a single worker, stages are executed sequentially in topological order.
+    */
+    unsigned int workerCount() const;
+    void setWorkerCount(unsigned int count);
+
+    /** Runs the CPU half of the pipeline one frame ahead of the stages bound to the context.
+        Frame-ahead stages are the AnyThread stages that only depend on other frame-ahead stages
+        and pass data to the remaining stages through BufferedData exclusively. Producers write
+        BufferedData::back() and publish it. Each execution acquires the published buffers, starts
+        the frame-ahead stages of the next frame on a dedicated thread and executes the remaining
+        stages in the meantime. Without workers, the frame-ahead stages run at the start of the next
+        execution. Invalidations and scheduling of the background execution are delivered on the
+        context thread, by the next execution or synchronize().
+        Thread affinities have to be set before pipelining is enabled.
+    */
+    bool isFramePipelining() const;
+    void setFramePipelining(bool enabled);
+
+    /** Waits until frame-ahead stages running in the background are done and delivers their notifications.
+        Has to be called on the context thread before changing data read by the frame-ahead stages.
+    */
+    void synchronize();
+
+    /** Whether a stage belongs to the CPU half run ahead when frame pipelining is enabled */
+    bool isFrameAhead(const AbstractStage * stage) const;
+
+    /** Only executes stages the registered sinks depend on, i.e., the transitive producers of
+        the sink outputs. Skipped stages stay scheduled and catch up once they are demanded again.
+        Without sinks, nothing is executed in demand-driven mode.
+    */
+    bool isDemandDriven() const;
+    void setDemandDriven(bool enabled);
+
+    /** Declares an output the host reads, see setDemandDriven() */
+    void addSink(const AbstractData * output);
+    /** Declares all outputs found by findOutputs(name) as sinks */
+    void addSinks(const std::string & name);
+    void removeSink(const AbstractData * output);
+    void clearSinks();
+    const std::vector<const AbstractData *> & sinks() const;
+
+    /** Whether a stage is executed in demand-driven mode */
+    bool isDemanded(const AbstractStage * stage) const;
+
+    /** Renders linear chains of FusibleStages in a single pass, see FusibleStage.
+        Enabled by default, disabling it renders every stage on its own for debugging.
+    */
+    bool isFusionEnabled() const;
+    void setFusionEnabled(bool enabled);
+
+    /** Coalesces invalidations, e.g., of bulk parameter changes, until commitTransaction().
+        Each invalidated data then schedules its consumers once. Only data consumed by the
+        stages of this pipeline and invalidated on the calling thread is deferred. Data shared
+        with other pipelines is deferred as a whole, so their stages are scheduled by the commit
+        as well, while data they consume exclusively notifies them right away. execute() refuses
+        to run while a transaction is open. InvalidationTransaction(pipeline) serves as RAII guard.
+    */
+    void beginTransaction();
+    void commitTransaction();
+    bool isTransactionActive() const;
+
     virtual void addStage(AbstractStage * stage);
 
     void addParameter(AbstractData * parameter);
@@ -73,6 +183,7 @@ public:
     void addStages(AbstractStage * stage, Args... pipeline);
 
     const std::vector<AbstractStage *> & stages() const;
+    const StageGraph & stageGraph() const;
     const std::vector<AbstractData *> & parameters() const;
 
     std::set<AbstractData *> unusedParameters();
@@ -80,18 +191,81 @@ public:
 protected: 
     bool sortDependencies();
     void addStages();
-    bool initializeStages();
+    virtual bool initializeStages();
+
+    /** Takes ownership of a stage and adds it to the graph, without scheduling it on changes */
+    std::size_t registerStage(AbstractStage * stage);
+
+    void executeSequential();
+    void executeParallel();
+    void computeLevels();
+
+    void computeDemand();
+    void computeFusion();
+
+    void computeFrameAhead();
+    void beginFrameAhead();
+    void executeFrameAhead();
+    bool passesOnlyBufferedData(std::size_t producer, std::size_t consumer) const;
+
+    bool executeStage(std::size_t index);
+    void replayStage(std::size_t index);
+    void scheduleStage(std::size_t index);
+    bool popScheduledStages(bool wholeLevel);
 
     static bool tsort(std::vector<AbstractStage *> &stages);
 
 protected:
     bool m_initialized;
     std::string m_name;
-    std::vector<AbstractStage *> m_stages;
+    std::vector<AbstractStage *> m_stages;  /**< Stages in topological order once sorted */
+    StageGraph m_graph;
     std::vector<AbstractData *> m_constantParameters;
     std::vector<AbstractData *> m_parameters;
     std::vector<const AbstractData *> m_sharedData;
     bool m_dependenciesSorted;
+
+    unsigned int m_workerCount;
+    std::unique_ptr<ThreadPool> m_threadPool;
+    std::vector<std::size_t> m_levels;      /**< Stage index -> dependency level, stages within a level are independent */
+    std::vector<std::size_t> m_positions;   /**< Stage index -> position in m_stages, which is ordered by level */
+
+    std::mutex m_worklistMutex;
+    std::vector<std::size_t> m_worklist;    /**< Min-heap of scheduled stage indices by position */
+    std::vector<std::size_t> m_deferred;    /**< Stages scheduled for the next execution */
+    std::vector<bool> m_scheduled;          /**< Stage index -> is in m_worklist or m_deferred */
+    std::vector<std::size_t> m_batch;       /**< Stages popped from the worklist for execution */
+    bool m_executing;
+    std::size_t m_currentPosition;
+
+    std::size_t m_visitedStages;
+    std::size_t m_processedStages;
+
+    std::unique_ptr<PipelineProfiler> m_profiler;
+    OutputCache m_outputCache;
+    TransientResourcePool m_transientResources;
+    StateCache m_stateCache;
+    BackgroundWorkers m_backgroundWorkers;
+    InvalidationTransaction::Scope m_transaction;
+
+    bool m_demandDriven;
+    bool m_demandComputed;
+    std::vector<const AbstractData *> m_sinks;
+    std::vector<bool> m_demanded;           /**< Stage index -> a sink depends on the stage */
+
+    bool m_fusionEnabled;
+    bool m_fusionComputed;
+
+    bool m_framePipelining;
+    std::vector<bool> m_frameAhead;                     /**< Stage index -> runs one frame ahead */
+    std::vector<std::size_t> m_frameAheadStages;        /**< Frame-ahead stage indices in topological order */
+    std::vector<AbstractBufferedData *> m_frameAheadOutputs;
+    std::unique_ptr<ThreadPool> m_frameAheadThread;     /**< Runs the next frame, apart from the workers the context thread helps */
+    std::mutex m_frameAheadMutex;
+    std::condition_variable m_frameAheadFinished;
+    bool m_frameAheadRunning;
+    bool m_frameAheadSubmitted;                         /**< A background execution has not been synchronized yet */
+    InvalidationTransaction::Notifications m_frameAheadNotifications;
 };
 
 } // namespace gloperate
@@ -1,23 +1,46 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <gloperate/gloperate_api.h>
 
 #include <globjects/base/CachedValue.h>
 #include <signalzeug/Signal.h>
 
+#include <gloperate/pipeline/InvalidationTransaction.h>
+
 
 namespace gloperate
 {
 
 class AbstractInputSlot;
 class AbstractData;
+class BackgroundWorkers;
+class CommandList;
+class OutputCache;
+class StateCache;
+class TransientResource;
+class TransientResourcePool;
+template <typename... Stages>
+class StaticPipeline;
 
 
 class GLOPERATE_API AbstractStage
 {
+    template <typename... Stages>
+    friend class StaticPipeline;
+
+public:
+    enum class ThreadAffinity
+    {
+        ContextThread   /**< Stage issues OpenGL calls and has to run on the thread owning the context */
+    ,   AnyThread       /**< Stage only does CPU work and may run on a worker thread */
+    };
+
 public:
     AbstractStage(const std::string & name = "");
     virtual ~AbstractStage();
@@ -36,12 +59,51 @@ public:
     void setEnabled(bool enabled);
     bool isEnabled() const;
 
+    ThreadAffinity threadAffinity() const;
+    void setThreadAffinity(ThreadAffinity affinity);
+
+    /** Memoized stages have to be pure functions of their input values. Once added to a pipeline,
+        their outputs are restored from the pipeline's OutputCache for input values seen before,
+        instead of calling process(). Requires hashable input and copyable output types.
+    */
+    bool isMemoized() const;
+    void setMemoized(bool memoized);
+
+    /** Set by the pipeline the stage is added to */
+    void setOutputCache(OutputCache * cache);
+    /** Set by the pipeline the stage is added to */
+    void setTransientResourcePool(TransientResourcePool * pool);
+
+    /** Transaction of the pipeline the stage is added to, set by the pipeline */
+    InvalidationTransaction::Scope * transactionScope() const;
+    void setTransactionScope(InvalidationTransaction::Scope * scope);
+
+    /** OpenGL state cache of the pipeline the stage is added to, stages route their state changes through it */
+    StateCache * stateCache() const;
+    void setStateCache(StateCache * cache);
+
+    /** Workers of the pipeline the stage is added to for long-running jobs, see AsyncStage */
+    BackgroundWorkers * backgroundWorkers() const;
+    void setBackgroundWorkers(BackgroundWorkers * workers);
+
+    /** OpenGL commands recorded by process(), which lets stages running on worker threads
+        prepare their draws. The pipeline replays them on the context thread once the stage
+        has been processed, in pipeline order, see CommandList.
+    */
+    CommandList & commands();
+    /** Replays and resets the recorded commands, called by the pipeline on the context thread */
+    void replayCommands();
+
+    /** Stage that processes on behalf of this one and reads its inputs then, nullptr if it processes itself */
+    virtual const AbstractStage * processedBy() const;
+
     bool requires(const AbstractStage * stage, bool recursive = true) const;
+    std::vector<const AbstractStage *> dependencies() const;
 
     const std::set<AbstractData*> & outputs() const;
-    std::set<AbstractData*> allOutputs() const;
+    const std::set<AbstractData*> & allOutputs() const;
     const std::set<AbstractInputSlot*> & inputs() const;
-    std::set<AbstractInputSlot*> allInputs() const;
+    const std::set<AbstractInputSlot*> & allInputs() const;
 
     void addOutput(const std::string & name, AbstractData & output);
     void shareOutput(AbstractData * output);
@@ -51,34 +113,74 @@ public:
     void addOptionalInput(const std::string & name, AbstractInputSlot & input);
     void addDependency(AbstractStage * stage);
 
+    /** Requests a resource from the pipeline's TransientResourcePool, acquired before each process().
+        \param exportedAs
+            Output the resource is passed on through, its consumers extend the lifetime of the resource
+    */
+    void addTransientResource(TransientResource & resource, const AbstractData * exportedAs = nullptr);
+    void removeTransientResource(TransientResource & resource);
+    const std::vector<TransientResource*> & transientResources() const;
+
     void alwaysProcess(bool on);
     bool isAlwaysProcess() const;
+
+    /** Marks the stage to be processed on its next execution.
+        Called whenever one of its inputs changes, emits processScheduled if the stage was not marked yet.
+        Thread-safe, within an InvalidationTransaction the signal is deferred to its commit.
+    */
     void scheduleProcess();
+    bool isProcessScheduled() const;
 
     void invalidateOutputs();
 
 public:
     signalzeug::Signal<> dependenciesChanged;
+    signalzeug::Signal<> processScheduled;  /**< Emitted when the stage becomes dirty, or is re-enabled while dirty */
 
 protected:
+    /** Checks whether the stage has to process, resets its schedule and acquires its transient resources, first part of execute() */
+    bool beginProcess();
+    /** Marks the inputs processed and reschedules stages to be processed always, last part of execute() */
+    void endProcess();
+
     bool needsToProcess() const;
     bool inputsUsable() const;
     void markInputsProcessed();
+    void processMemoized();
+    bool hashInputs(std::vector<std::size_t> & key, std::vector<const AbstractData *> & inputs) const;
 
     virtual void process() = 0;
 
 protected:
     bool m_enabled;
     bool m_alwaysProcess;
-    bool m_processScheduled;
+    std::atomic<bool> m_processScheduled;   /**< Set by workers executing other stages as well */
+    bool m_memoized;
+    ThreadAffinity m_threadAffinity;
+    OutputCache * m_outputCache;
+    TransientResourcePool * m_transientPool;
+    StateCache * m_stateCache;
+    BackgroundWorkers * m_backgroundWorkers;
+    InvalidationTransaction::Scope * m_transactionScope;
+    std::unique_ptr<CommandList> m_commands;    /**< Created on first use, most stages call OpenGL directly */
     std::string m_name;
     globjects::CachedValue<bool> m_usable;
 
-    std::set<AbstractData*> m_outputs;
-    std::set<AbstractData*> m_sharedOutputs;
-    std::set<AbstractInputSlot*> m_inputs;
-    std::set<AbstractInputSlot*> m_sharedInputs;
-    std::set<AbstractStage*> m_dependencies;    /**< Additional manual dependencies not expressed by data connections */
+    // Owned and shared slots are merged when added, so execution does not need to allocate
+    std::vector<AbstractData*> m_outputs;
+    std::vector<AbstractData*> m_sharedOutputs;
+    std::vector<AbstractData*> m_allOutputs;
+    std::vector<AbstractInputSlot*> m_inputs;
+    std::vector<AbstractInputSlot*> m_sharedInputs;
+    std::vector<AbstractInputSlot*> m_allInputs;
+    std::vector<AbstractStage*> m_dependencies;  /**< Additional manual dependencies not expressed by data connections */
+    std::vector<TransientResource*> m_transientResources;
+
+    // Kept alongside the vectors for the accessors
+    std::set<AbstractData*> m_outputSet;
+    std::set<AbstractData*> m_allOutputSet;
+    std::set<AbstractInputSlot*> m_inputSet;
+    std::set<AbstractInputSlot*> m_allInputSet;
 
 private:
     AbstractStage(const AbstractStage&) = delete;
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <signalzeug/Signal.h>
+
+#include <gloperate/gloperate_api.h>
+
+#include <gloperate/pipeline/AbstractStage.h>
+#include <gloperate/pipeline/Data.h>
+
+
+namespace gloperate
+{
+
+/** \brief Stage that processes on a background worker without blocking pipeline execution.
+
+    When its inputs change, prepare() copies what the stage needs into a job, which
+    is run on the BackgroundWorkers of the pipeline. Until the job finishes, the outputs
+    keep their last valid values, so downstream stages continue with them. A finished job
+    posts its completion to the context thread: the next execution schedules the stage
+    and emits finished, then publish() writes the results to the outputs and they are
+    invalidated together. Hosts rendering on demand connect to BackgroundWorkers::posted
+    to execute again.
+
+    If inputs change while a job runs, the job is cancelled and a new one is started
+    as soon as it returned. Only one job runs at a time.
+
+    The job must only use the state it captured, e.g., copies of the inputs and a
+    shared result, but no members of the stage. The stage may then be destroyed while
+    the job runs: it cancels the job and waits for it to return.
+
+    The pending output is true while a job is running or waiting to be restarted.
+*/
+class GLOPERATE_API AsyncStage : public AbstractStage
+{
+public:
+    /** Runs on the worker thread, should return early once cancelled is set */
+    using Job = std::function<void(const std::atomic<bool> & cancelled)>;
+
+public:
+    AsyncStage(const std::string & name = "");
+    virtual ~AsyncStage();
+
+    bool isPending() const;
+
+    /** Cancels a running job and blocks until it returned, the next execution starts a new one */
+    void cancelAndWait();
+
+public:
+    Data<bool> pending;
+
+    /** Emitted on the context thread by the execution following the return of a job */
+    signalzeug::Signal<> finished;
+
+protected:
+    virtual void process() override;
+
+    /** Called on the pipeline thread to start a job for the current inputs */
+    virtual Job prepare() = 0;
+
+    /** Called on the pipeline thread after a job finished without being cancelled.
+        Writes and invalidates the outputs, like process() of a synchronous stage.
+    */
+    virtual void publish() = 0;
+
+    bool inputsChanged() const;
+    void startJob();
+    void setPending(bool pending);
+
+protected:
+    /** State shared with the worker, outlives the stage if it is destroyed while the job runs */
+    struct JobState
+    {
+        std::atomic<bool> cancelled;
+        std::mutex mutex;
+        std::condition_variable finished;
+        bool done;
+        AsyncStage * stage;     /**< Reset when the stage is destroyed */
+    };
+
+protected:
+    std::shared_ptr<JobState> m_job;    /**< Running or finished job, not yet published */
+    bool m_restart;
+};
+
+} // namespace gloperate
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <signalzeug/Signal.h>
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace gloperate
+{
+
+class ThreadPool;
+
+
+/** \brief Worker threads for long-running jobs of the stages of a pipeline, see AsyncStage.
+
+    Jobs are run on a pool shared by all stages of the pipeline, which is created when the
+    first job is submitted. It is separate from the workers executing the stages, so a job
+    never delays an execution, neither on a worker nor on the context thread helping out.
+
+    Jobs hand their results back through post(). Posted tasks are run on the context thread
+    by the next execution of the pipeline, before any stage is executed, so they may schedule
+    stages and emit signals like any other change made on the context thread.
+
+    The workers are owned by the pipeline and joined when it is destroyed.
+*/
+class GLOPERATE_API BackgroundWorkers
+{
+public:
+    using Task = std::function<void()>;
+
+public:
+    BackgroundWorkers();
+    virtual ~BackgroundWorkers();
+
+    BackgroundWorkers(const BackgroundWorkers &) = delete;
+    BackgroundWorkers & operator=(const BackgroundWorkers &) = delete;
+
+    /** Runs a job on one of the workers */
+    void submit(Task job);
+
+    /** Thread-safe, queues a task for the context thread */
+    void post(Task task);
+    bool hasPosted() const;
+
+    /** Runs the posted tasks, called by the pipeline on the context thread */
+    void runPosted();
+
+public:
+    /** Emitted on the posting thread, e.g., to wake up a host that renders on demand.
+        Listeners must not block, a job may still hold its locks.
+    */
+    signalzeug::Signal<> posted;
+
+protected:
+    std::unique_ptr<ThreadPool> m_pool;
+
+    mutable std::mutex m_mutex;
+    std::vector<Task> m_posted;
+};
+
+} // namespace gloperate
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gloperate/gloperate_api.h>
+
+#include <gloperate/pipeline/DataSnapshot.h>
+
+
+namespace globjects
+{
+
+class Texture;
+
+}
+
+
+namespace gloperate
+{
+
+class AbstractPipeline;
+class AbstractData;
+class ParameterSweep;
+
+
+/** \brief Runs a pipeline headless over all combinations of a ParameterSweep.
+
+    For every combination, only the changed parameters are set (see ParameterSweep::apply),
+    the pipeline is executed and copies of the requested outputs are queued for the sink.
+    Combinations whose parameters cannot be set are reported and skipped. The sink runs
+    on a thread of its own, so storing results overlaps with the following executions.
+    The queue is bounded, a slow sink eventually throttles execution.
+
+    Outputs are copied on the thread executing the pipeline. A snapshot of a GPU resource
+    would only copy its reference, so textures are read back instead, and other resources
+    need a readback of their own (see setReadback()). Textures are copied into a ring of
+    pixel pack buffers guarded by fences: the copy of an execution is only mapped once
+    the following executions were issued (see setReadbackLatency()), so the GPU is not
+    stalled. Results are delayed accordingly but delivered in order.
+
+    The pipeline itself is executed on the calling thread, which has to own its context if
+    stages issue OpenGL calls. Work within an execution can be spread with
+    AbstractPipeline::setWorkerCount() as usual.
+
+    Pure CPU pipelines, i.e., with AnyThread stages only, can additionally be cloned: with
+    a clone factory, each clone runs on a thread of its own and takes the next combination
+    when done. Results are then delivered in the order they complete.
+*/
+class GLOPERATE_API BatchExecutor
+{
+public:
+    struct Result
+    {
+        std::size_t combination;
+        std::vector<std::unique_ptr<AbstractDataSnapshot>> outputs;    /**< nullptr for missing or uncopyable outputs */
+    };
+
+    using Sink = std::function<void(const Result &)>;
+    using Readback = std::function<std::unique_ptr<AbstractDataSnapshot>(const AbstractData &)>;
+    using PipelineFactory = std::function<std::unique_ptr<AbstractPipeline>()>;
+
+public:
+    BatchExecutor(AbstractPipeline & pipeline);
+    virtual ~BatchExecutor();
+
+    BatchExecutor(const BatchExecutor &) = delete;
+    BatchExecutor & operator=(const BatchExecutor &) = delete;
+
+    /** Names of the outputs copied into each Result, in that order (see AbstractPipeline::findOutputs) */
+    const std::vector<std::string> & outputNames() const;
+    void setOutputNames(const std::vector<std::string> & names);
+
+    /** Copies the output of the given name by readback instead of AbstractData::snapshot().
+        Textures are read back by default, as a DataSnapshot<std::vector<unsigned char>> of
+        their first level in RGBA8.
+    */
+    void setReadback(const std::string & name, Readback readback);
+
+    /** Number of results that may wait for the sink before executions block */
+    std::size_t queueCapacity() const;
+    void setQueueCapacity(std::size_t capacity);
+
+    /** Number of executions issued before the texture readbacks of an execution are mapped.
+        0 maps right after each execution, the default of 2 maps buffer N-2 while rendering N.
+    */
+    std::size_t readbackLatency() const;
+    void setReadbackLatency(std::size_t latency);
+
+    /** Executes numClones pipelines created by factory in parallel instead of the pipeline
+        passed on construction. Ignored if a clone has stages bound to the context.
+    */
+    void setClones(PipelineFactory factory, unsigned int numClones);
+
+    /** Executes all combinations and blocks until the sink received all results.
+        \return number of combinations executed, without the skipped ones
+    */
+    std::size_t run(const ParameterSweep & sweep, const Sink & sink);
+
+protected:
+    class ResultQueue;
+    class ReadbackRing;
+
+    std::size_t runSequential(const ParameterSweep & sweep, ResultQueue & queue);
+    std::size_t runClones(const ParameterSweep & sweep, std::vector<std::unique_ptr<AbstractPipeline>> & clones, ResultQueue & queue);
+
+    std::vector<AbstractData *> findOutputs(const AbstractPipeline & pipeline) const;
+    /** Texture outputs are left empty and read back through the ring, if one is given */
+    std::unique_ptr<Result> takeResult(std::size_t combination, const std::vector<AbstractData *> & outputs, ReadbackRing * ring = nullptr) const;
+    std::unique_ptr<AbstractDataSnapshot> takeOutput(const std::string & name, const AbstractData & output) const;
+
+    static bool applyCombination(const ParameterSweep & sweep, std::size_t combination, AbstractPipeline & pipeline, std::size_t & previous);
+    static std::unique_ptr<AbstractDataSnapshot> readTexture(const globjects::Texture * texture);
+    static bool isThreadSafe(const AbstractPipeline & pipeline);
+
+protected:
+    AbstractPipeline & m_pipeline;
+    std::vector<std::string> m_outputNames;
+    std::size_t m_queueCapacity;
+    std::size_t m_readbackLatency;
+    std::map<std::string, Readback> m_readbacks;
+
+    PipelineFactory m_factory;
+    unsigned int m_numClones;
+};
+
+} // namespace gloperate
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+
+#include <gloperate/pipeline/AbstractBufferedData.h>
+#include <gloperate/pipeline/Data.h>
+
+
+namespace gloperate
+{
+
+/** \brief Data with N rotating buffers, so a producer can work ahead of its consumers.
+
+    The inherited value is the front buffer read by consumers, so BufferedData<T, N>
+    connects to any InputSlot<T>. The producer writes back() and calls publish(),
+    acquire() then swaps the oldest published buffer to the front and invalidates.
+    Buffers are swapped, not copied, so back() holds an older value that has to be
+    overwritten completely.
+
+    publish() and acquire() may be called from different threads. Consumers must not
+    read the front value while acquire() runs, the pipeline acquires the buffered
+    outputs of its frame-ahead stages before executing the consumers (see
+    AbstractPipeline::setFramePipelining).
+*/
+template <typename T, std::size_t N = 2>
+class BufferedData : public Data<T>, public AbstractBufferedData
+{
+    static_assert(N >= 2, "BufferedData needs a front and at least one back buffer");
+
+public:
+    /** Initializes all buffers with the value constructed from args */
+    template <typename... Args>
+    explicit BufferedData(Args&&... args);
+
+    /** Buffer to be written by the producer, undefined while all buffers are pending */
+    T & back();
+    const T & back() const;
+
+    /** false while all back buffers are pending */
+    bool canPublish() const;
+
+    virtual bool publish() override;
+    virtual bool acquire() override;
+    virtual std::size_t numPending() const override;
+
+protected:
+    std::array<T, N - 1> m_buffers;     /**< Ring of back buffers */
+    std::size_t m_oldest;               /**< Oldest pending buffer */
+    std::size_t m_numPending;
+    mutable std::mutex m_mutex;
+};
+
+} // namespace gloperate
+
+
+#include <gloperate/pipeline/BufferedData.hpp>
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <gloperate/pipeline/BufferedData.h>
+
+#include <utility>
+
+
+namespace gloperate
+{
+
+template <typename T, std::size_t N>
+template <typename... Args>
+BufferedData<T, N>::BufferedData(Args&&... args)
+: Data<T>(std::forward<Args>(args)...)
+, m_oldest(0)
+, m_numPending(0)
+{
+    for (auto & buffer : m_buffers)
+    {
+        buffer = this->m_data;
+    }
+}
+
+template <typename T, std::size_t N>
+T & BufferedData<T, N>::back()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_buffers[(m_oldest + m_numPending) % m_buffers.size()];
+}
+
+template <typename T, std::size_t N>
+const T & BufferedData<T, N>::back() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_buffers[(m_oldest + m_numPending) % m_buffers.size()];
+}
+
+template <typename T, std::size_t N>
+bool BufferedData<T, N>::canPublish() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_numPending < m_buffers.size();
+}
+
+template <typename T, std::size_t N>
+bool BufferedData<T, N>::publish()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_numPending == m_buffers.size())
+            return false;
+
+        ++m_numPending;
+    }
+
+    this->published();
+
+    return true;
+}
+
+template <typename T, std::size_t N>
+bool BufferedData<T, N>::acquire()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_numPending == 0)
+            return false;
+
+        // The previous front value becomes the last buffer of the ring
+        std::swap(this->m_data, m_buffers[m_oldest]);
+
+        m_oldest = (m_oldest + 1) % m_buffers.size();
+        --m_numPending;
+    }
+
+    this->invalidate();
+
+    return true;
+}
+
+template <typename T, std::size_t N>
+std::size_t BufferedData<T, N>::numPending() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_numPending;
+}
+
+} // namespace gloperate
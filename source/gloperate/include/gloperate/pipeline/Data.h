@@ -1,10 +1,13 @@
 #pragma once
 
+#include <memory>
 #include <string>
+#include <type_traits>
 
 #include <gloperate/gloperate_api.h>
 
 #include <gloperate/pipeline/AbstractData.h>
+#include <gloperate/pipeline/DataSnapshot.h>
 
 
 namespace gloperate 
@@ -29,11 +32,32 @@ public:
 
     Data<T> & operator=(const Data<T> & data);
     const T & operator=(const T & value);
+    const T & operator=(T && value);
 
     void setData(const T & value);
+    void setData(T && value);
+
+    /** Move-assigns a value constructed from args and invalidates */
+    template <typename... Args>
+    T & assign(Args&&... args);
 
     virtual std::string type() const override;
+
+    virtual bool hashValue(std::size_t & hash) const override;
+    virtual bool equals(const AbstractDataSnapshot & snapshot) const override;
+    virtual std::unique_ptr<AbstractDataSnapshot> snapshot() const override;
+    virtual bool restore(const AbstractDataSnapshot & snapshot) override;
     
+protected:
+    bool hashValue(std::size_t & hash, std::true_type) const;
+    bool hashValue(std::size_t & hash, std::false_type) const;
+    bool equals(const AbstractDataSnapshot & snapshot, std::true_type) const;
+    bool equals(const AbstractDataSnapshot & snapshot, std::false_type) const;
+    std::unique_ptr<AbstractDataSnapshot> snapshot(std::true_type) const;
+    std::unique_ptr<AbstractDataSnapshot> snapshot(std::false_type) const;
+    bool restore(const AbstractDataSnapshot & snapshot, std::true_type);
+    bool restore(const AbstractDataSnapshot & snapshot, std::false_type);
+
 protected:
     T m_data;
 };
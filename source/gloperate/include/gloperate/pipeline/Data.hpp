@@ -2,6 +2,8 @@
 
 #include <gloperate/pipeline/Data.h>
 
+#include <utility>
+
 
 namespace gloperate 
 {
@@ -72,6 +74,15 @@ const T & Data<T>::operator=(const T & value)
     return value;
 }
 
+template <typename T>
+const T & Data<T>::operator=(T && value)
+{
+    m_data = std::move(value);
+    invalidate();
+
+    return m_data;
+}
+
 template <typename T>
 void Data<T>::setData(const T & value)
 {
@@ -79,10 +90,109 @@ void Data<T>::setData(const T & value)
     invalidate();
 }
 
+template <typename T>
+void Data<T>::setData(T && value)
+{
+    m_data = std::move(value);
+    invalidate();
+}
+
+template <typename T>
+template <typename... Args>
+T & Data<T>::assign(Args&&... args)
+{
+    m_data = T(std::forward<Args>(args)...);
+    invalidate();
+
+    return m_data;
+}
+
 template <typename T>
 std::string Data<T>::type() const 
 {
     return typeid(T).name(); 
 }
+
+template <typename T>
+bool Data<T>::hashValue(std::size_t & hash) const
+{
+    return hashValue(hash, IsKeyable<T>());
+}
+
+template <typename T>
+bool Data<T>::equals(const AbstractDataSnapshot & snapshot) const
+{
+    return equals(snapshot, IsKeyable<T>());
+}
+
+template <typename T>
+std::unique_ptr<AbstractDataSnapshot> Data<T>::snapshot() const
+{
+    return snapshot(IsCopyable<T>());
+}
+
+template <typename T>
+bool Data<T>::restore(const AbstractDataSnapshot & snapshot)
+{
+    return restore(snapshot, IsCopyable<T>());
+}
+
+template <typename T>
+bool Data<T>::hashValue(std::size_t & hash, std::true_type) const
+{
+    hash = std::hash<T>()(m_data);
+    return true;
+}
+
+template <typename T>
+bool Data<T>::hashValue(std::size_t &, std::false_type) const
+{
+    return false;
+}
+
+template <typename T>
+bool Data<T>::equals(const AbstractDataSnapshot & snapshot, std::true_type) const
+{
+    const DataSnapshot<T> * typedSnapshot = dynamic_cast<const DataSnapshot<T> *>(&snapshot);
+
+    return typedSnapshot && typedSnapshot->value() == m_data;
+}
+
+template <typename T>
+bool Data<T>::equals(const AbstractDataSnapshot &, std::false_type) const
+{
+    return false;
+}
+
+template <typename T>
+std::unique_ptr<AbstractDataSnapshot> Data<T>::snapshot(std::true_type) const
+{
+    return std::unique_ptr<AbstractDataSnapshot>(new DataSnapshot<T>(m_data));
+}
+
+template <typename T>
+std::unique_ptr<AbstractDataSnapshot> Data<T>::snapshot(std::false_type) const
+{
+    return nullptr;
+}
+
+template <typename T>
+bool Data<T>::restore(const AbstractDataSnapshot & snapshot, std::true_type)
+{
+    const DataSnapshot<T> * typedSnapshot = dynamic_cast<const DataSnapshot<T> *>(&snapshot);
+
+    if (!typedSnapshot)
+        return false;
+
+    setData(typedSnapshot->value());
+
+    return true;
+}
+
+template <typename T>
+bool Data<T>::restore(const AbstractDataSnapshot &, std::false_type)
+{
+    return false;
+}
     
 } // namespace gloperate
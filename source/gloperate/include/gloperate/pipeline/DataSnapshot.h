@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace gloperate
+{
+
+/** \brief Type-erased copy of the value of a Data, see AbstractData::snapshot(). */
+class GLOPERATE_API AbstractDataSnapshot
+{
+public:
+    AbstractDataSnapshot();
+    virtual ~AbstractDataSnapshot();
+
+    /** Approximate memory footprint in bytes, used for cache budgets */
+    virtual std::size_t size() const = 0;
+};
+
+
+template <typename T>
+class DataSnapshot : public AbstractDataSnapshot
+{
+public:
+    DataSnapshot(const T & value);
+
+    const T & value() const;
+
+    virtual std::size_t size() const override;
+
+protected:
+    T m_value;
+};
+
+
+/** Approximate memory footprint of a value, overload for types owning heap memory */
+template <typename T>
+std::size_t memoryFootprint(const T & value);
+
+template <typename T, typename Allocator>
+std::size_t memoryFootprint(const std::vector<T, Allocator> & value);
+
+template <typename Char, typename Traits, typename Allocator>
+std::size_t memoryFootprint(const std::basic_string<Char, Traits, Allocator> & value);
+
+
+template <typename T>
+struct IsCopyable : std::integral_constant<bool, std::is_copy_constructible<T>::value && std::is_copy_assignable<T>::value>
+{
+};
+
+template <typename T, typename Enable = void>
+struct IsHashable : std::false_type
+{
+};
+
+template <typename T>
+struct IsHashable<T, decltype(void(std::hash<T>()(std::declval<const T &>())))> : std::true_type
+{
+};
+
+template <typename T, typename Enable = void>
+struct IsEqualityComparable : std::false_type
+{
+};
+
+template <typename T>
+struct IsEqualityComparable<T, decltype(void(std::declval<const T &>() == std::declval<const T &>()))> : std::true_type
+{
+};
+
+/** Whether values can key an OutputCache: hashed for the lookup, copied and compared to rule out collisions */
+template <typename T>
+struct IsKeyable : std::integral_constant<bool, IsHashable<T>::value && IsEqualityComparable<T>::value && IsCopyable<T>::value>
+{
+};
+
+} // namespace gloperate
+
+#include <gloperate/pipeline/DataSnapshot.hpp>
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <gloperate/pipeline/DataSnapshot.h>
+
+
+namespace gloperate
+{
+
+template <typename T>
+DataSnapshot<T>::DataSnapshot(const T & value)
+: m_value(value)
+{
+}
+
+template <typename T>
+const T & DataSnapshot<T>::value() const
+{
+    return m_value;
+}
+
+template <typename T>
+std::size_t DataSnapshot<T>::size() const
+{
+    return memoryFootprint(m_value);
+}
+
+template <typename T>
+std::size_t memoryFootprint(const T &)
+{
+    return sizeof(T);
+}
+
+template <typename T, typename Allocator>
+std::size_t memoryFootprint(const std::vector<T, Allocator> & value)
+{
+    return sizeof(value) + value.capacity() * sizeof(T);
+}
+
+template <typename Char, typename Traits, typename Allocator>
+std::size_t memoryFootprint(const std::basic_string<Char, Traits, Allocator> & value)
+{
+    return sizeof(value) + value.capacity() * sizeof(Char);
+}
+
+} // namespace gloperate
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <glbinding/gl/enum.h>
+
+#include <globjects/base/ref_ptr.h>
+
+#include <gloperate/gloperate_api.h>
+
+#include <gloperate/pipeline/AbstractStage.h>
+#include <gloperate/pipeline/Data.h>
+#include <gloperate/pipeline/InputSlot.h>
+#include <gloperate/pipeline/TransientResource.h>
+
+
+namespace globjects
+{
+
+class Framebuffer;
+class Program;
+class Texture;
+
+}
+
+
+namespace gloperate
+{
+
+class ScreenAlignedQuad;
+
+
+/** \brief Full-screen per-pixel pass that can be fused with adjacent passes into one.
+
+    Instead of a complete shader, a fusible stage supplies a GLSL snippet that transforms
+    the color of a single pixel: it reads and writes the vec4 color and may read the
+    vec2 uv. Uniforms and helper functions go to declarations(). Each identifier starting
+    with $ is replaced by a prefix unique to the stage, so the snippets of several stages
+    do not collide, and setUniforms() receives the same prefix.
+
+    The pipeline fuses linear chains: a fusible stage is appended to the chain of the
+    fusible stage producing its source if it is the only consumer of that target and
+    both render at the same scale relative to the viewport. The
+    last stage of a chain, its tail, renders the snippets of all stages in one pass from
+    the source of the first stage into its own target. The other stages of the chain
+    neither allocate a target nor render, they only pass their invalidation on to the
+    tail. Fusion can be disabled per pipeline, see AbstractPipeline::setFusionEnabled().
+*/
+class GLOPERATE_API FusibleStage : public AbstractStage
+{
+public:
+    /** Fuses the chains of the given stages, which have to be in topological order.
+        With fusion disabled, every fusible stage is a chain of its own.
+    */
+    static void fuseChains(const std::vector<AbstractStage *> & stages, bool enabled);
+
+    /** Fragment shader applying the snippets of the chain in order */
+    static std::string fragmentShaderSource(const std::vector<FusibleStage *> & chain);
+
+    /** Prefix replacing $ in the snippet of the stage at the given chain position */
+    static std::string prefix(std::size_t position);
+
+public:
+    FusibleStage(
+        const std::string & name = "",
+        gl::GLenum internalFormat = gl::GL_RGBA8,
+        gl::GLenum format = gl::GL_RGBA,
+        gl::GLenum type = gl::GL_UNSIGNED_BYTE,
+        float scale = 1.0f);
+    virtual ~FusibleStage();
+
+    /** Stages rendered by this stage in one pass, from the head to this stage.
+        Empty if this stage is fused into a later one.
+    */
+    const std::vector<FusibleStage *> & chain() const;
+
+    /** Tail of the chain this stage is fused into, nullptr if it renders itself */
+    FusibleStage * fusedInto() const;
+
+    virtual const AbstractStage * processedBy() const override;
+
+public:
+    InputSlot<globjects::ref_ptr<globjects::Texture>> source;
+    Data<globjects::ref_ptr<globjects::Texture>> target;
+
+protected:
+    /** Uniforms and functions used by the snippet */
+    virtual std::string declarations() const;
+
+    /** Statements modifying vec4 color at vec2 uv */
+    virtual std::string snippet() const = 0;
+
+    /** Sets the uniforms declared by declarations(), with $ replaced by prefix */
+    virtual void setUniforms(globjects::Program * program, const std::string & prefix) const;
+
+    virtual void process() override;
+
+    void setChain(const std::vector<FusibleStage *> & chain);
+    void setFusedInto(FusibleStage * tail);
+
+    void createPass();
+
+protected:
+    TransientResource m_target;
+    std::vector<FusibleStage *> m_chain;
+    FusibleStage * m_fusedInto;
+    bool m_chainChanged;    /**< The pass has to be recreated */
+
+    globjects::ref_ptr<globjects::Framebuffer> m_fbo;
+    globjects::ref_ptr<ScreenAlignedQuad> m_quad;
+};
+
+} // namespace gloperate
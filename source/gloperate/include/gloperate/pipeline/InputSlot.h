@@ -2,8 +2,6 @@
 
 #include <gloperate/gloperate_api.h>
 
-#include <signalzeug/ScopedConnection.h>
-
 #include <gloperate/pipeline/AbstractInputSlot.h>
 #include <gloperate/pipeline/Data.h>
 
@@ -40,7 +38,6 @@ public:
 
 protected:
     const Data<T> * m_data;
-    signalzeug::ScopedConnection m_connection;
 
     static const T s_defaultValue;
 
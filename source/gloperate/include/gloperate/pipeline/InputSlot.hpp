@@ -97,7 +97,7 @@ void InputSlot<T>::connect(const Data<U> & data)
     static_assert(std::is_same<T, U>::value || (std::is_pointer<T>::value && std::is_pointer<U>::value && std::is_base_of<Tp, Up>::value), "Types incompatible");
 
     m_data = reinterpret_cast<const Data<T> *>(&data);
-    m_connection = data.invalidated.connect([this]() { this->changed(); });
+    attach(m_data);
     connectionChanged();
     changed();
 }
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace gloperate
+{
+
+class AbstractData;
+class AbstractPipeline;
+class AbstractStage;
+
+
+/** \brief Scope that coalesces the invalidations of data on the current thread.
+
+    While a transaction is open, AbstractData::invalidate() still advances the
+    generation of the data, so hasChanged() of connected input slots is correct
+    immediately. Scheduling the stages of the connected slots and emitting the
+    invalidated signal are deferred to the commit of the outermost transaction and
+    happen once per data, no matter how often it was invalidated.
+
+    Transactions nest and are bound to the thread that opened them. The processScheduled
+    signal of stages scheduled directly, e.g., stages that always process, is deferred as well.
+
+    A transaction opened for a pipeline only defers the invalidations of data consumed
+    by its stages, see AbstractPipeline::beginTransaction().
+*/
+class GLOPERATE_API InvalidationTransaction
+{
+public:
+    /** Notifications of a transaction detached from its thread, see detach() */
+    struct Notifications
+    {
+        std::vector<AbstractData *> invalidated;
+        std::vector<AbstractStage *> scheduled;
+    };
+
+    /** Transaction of a pipeline, shared with its stages */
+    struct Scope
+    {
+        std::atomic<unsigned int> depth{0};
+        std::atomic<std::thread::id> thread{std::thread::id()};    /**< Only invalidations on the opening thread are deferred, read by other threads */
+        Notifications notifications;    /**< Only accessed on the opening thread */
+
+        bool isActive() const;
+    };
+
+public:
+    /** Opens a transaction that is committed on destruction */
+    InvalidationTransaction();
+    /** Opens a transaction of the pipeline that is committed on destruction */
+    explicit InvalidationTransaction(AbstractPipeline & pipeline);
+    ~InvalidationTransaction();
+
+    InvalidationTransaction(const InvalidationTransaction &) = delete;
+    InvalidationTransaction & operator=(const InvalidationTransaction &) = delete;
+
+    static void begin();
+
+    /** Closes the innermost transaction, delivers the recorded invalidations if it was the outermost */
+    static void commit();
+
+    static bool isActive();
+
+    /** Closes the innermost transaction like commit(), but appends the recorded notifications
+        of the outermost one to notifications instead of delivering them. Lets worker threads
+        hand their notifications to the thread the observers expect them on.
+    */
+    static void detach(Notifications & notifications);
+
+    /** Delivers and clears notifications taken by detach() on the current thread */
+    static void deliver(Notifications & notifications);
+
+protected:
+    AbstractPipeline * m_pipeline;
+};
+
+} // namespace gloperate
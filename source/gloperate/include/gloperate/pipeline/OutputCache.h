@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace gloperate
+{
+
+class AbstractStage;
+class AbstractData;
+class AbstractDataSnapshot;
+
+
+/** \brief Least-recently-used cache of stage outputs keyed by input values.
+
+    Memoized stages (see AbstractStage::setMemoized) look up the hashes of their
+    input values before processing. Entries keep copies of the inputs, so hash
+    collisions are ruled out by comparing them. On a hit, the cached output
+    snapshots are restored instead of calling process(). The cache evicts the least recently
+    used entries to stay within its memory budget.
+
+    The cache is owned by the pipeline and may be accessed from several worker threads.
+*/
+class GLOPERATE_API OutputCache
+{
+public:
+    struct Statistics
+    {
+        std::size_t hits;
+        std::size_t misses;
+        std::size_t uncacheable;    /**< Executions with unhashable inputs or uncopyable outputs */
+        std::size_t evictions;
+        std::size_t entries;
+        std::size_t bytes;
+    };
+
+    using Key = std::vector<std::size_t>;
+
+public:
+    OutputCache(std::size_t budget = 64 * 1024 * 1024);
+    virtual ~OutputCache();
+
+    OutputCache(const OutputCache &) = delete;
+    OutputCache & operator=(const OutputCache &) = delete;
+
+    /** Memory budget in bytes */
+    std::size_t budget() const;
+    void setBudget(std::size_t budget);
+
+    Statistics statistics() const;
+    void resetStatistics();
+
+    void clear();
+    void remove(const AbstractStage * stage);
+
+    /** Restores the outputs memoized for the stage and the current values of the inputs.
+        \param key Hashes of the inputs
+        \param inputs Data connected to the inputs, nullptr for unconnected inputs
+        \return true on a cache hit
+    */
+    bool restore(const AbstractStage * stage, const Key & key, const std::vector<const AbstractData *> & inputs, const std::vector<AbstractData *> & outputs);
+
+    /** Memoizes the current values of the outputs, ignored if an input or output cannot be copied */
+    void store(const AbstractStage * stage, Key key, const std::vector<const AbstractData *> & inputs, const std::vector<AbstractData *> & outputs);
+
+    void countUncacheable();
+
+protected:
+    using Snapshots = std::vector<std::shared_ptr<const AbstractDataSnapshot>>;
+
+    struct Entry
+    {
+        const AbstractStage * stage;
+        Key key;
+        std::size_t hash;
+        Snapshots inputs;   /**< nullptr for unconnected inputs */
+        Snapshots outputs;
+        std::size_t bytes;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    static std::size_t hashKey(const AbstractStage * stage, const Key & key);
+
+    EntryList::iterator find(const AbstractStage * stage, const Key & key, std::size_t hash);
+    void erase(EntryList::iterator entry);
+    void evict(std::size_t budget);
+
+protected:
+    mutable std::mutex m_mutex;
+
+    std::size_t m_budget;
+    Statistics m_statistics;
+
+    EntryList m_entries;    /**< Most recently used first */
+    std::unordered_multimap<std::size_t, EntryList::iterator> m_index;
+};
+
+} // namespace gloperate
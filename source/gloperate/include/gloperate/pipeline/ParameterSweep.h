@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace gloperate
+{
+
+class AbstractPipeline;
+
+
+/** \brief Cartesian product of value lists for named pipeline parameters.
+
+    Combinations are enumerated by index without being materialized. The last added
+    parameter varies fastest, so consecutive combinations differ in few parameters.
+    apply() only sets the parameters whose value differs from the previously applied
+    combination, keeping invalidation (and thereby re-processing) to the affected stages.
+*/
+class GLOPERATE_API ParameterSweep
+{
+public:
+    static const std::size_t npos;
+
+public:
+    ParameterSweep();
+    virtual ~ParameterSweep();
+
+    /** Adds a parameter, found by AbstractPipeline::getParameter<T>(name) when applied */
+    template <typename T>
+    void addParameter(const std::string & name, const std::vector<T> & values);
+
+    /** Number of combinations */
+    std::size_t size() const;
+
+    std::size_t numParameters() const;
+    const std::string & parameterName(std::size_t parameter) const;
+
+    /** Index into the value list of a parameter for a combination */
+    std::size_t valueIndex(std::size_t combination, std::size_t parameter) const;
+
+    /** Sets the parameters of a combination on a pipeline.
+        \param previous combination applied to the pipeline before, npos to set all parameters
+        \return false if a parameter was not found or had another type
+    */
+    bool apply(std::size_t combination, AbstractPipeline & pipeline, std::size_t previous = npos) const;
+
+protected:
+    struct Dimension
+    {
+        std::string name;
+        std::size_t numValues;
+        std::size_t stride;
+        std::function<bool(AbstractPipeline &, std::size_t)> apply;
+    };
+
+    void addDimension(const std::string & name, std::size_t numValues, std::function<bool(AbstractPipeline &, std::size_t)> apply);
+
+protected:
+    std::vector<Dimension> m_dimensions;
+};
+
+} // namespace gloperate
+
+
+#include <gloperate/pipeline/ParameterSweep.hpp>
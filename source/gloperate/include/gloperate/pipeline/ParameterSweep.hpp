@@ -0,0 +1,28 @@
+#pragma once
+
+#include <gloperate/pipeline/ParameterSweep.h>
+
+#include <gloperate/pipeline/AbstractPipeline.h>
+#include <gloperate/pipeline/Data.h>
+
+
+namespace gloperate
+{
+
+template <typename T>
+void ParameterSweep::addParameter(const std::string & name, const std::vector<T> & values)
+{
+    addDimension(name, values.size(), [name, values](AbstractPipeline & pipeline, std::size_t index)
+    {
+        auto parameter = pipeline.getParameter<T>(name);
+
+        if (!parameter)
+            return false;
+
+        parameter->setData(values[index]);
+
+        return true;
+    });
+}
+
+} // namespace gloperate
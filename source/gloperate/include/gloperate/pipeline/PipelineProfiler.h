@@ -0,0 +1,152 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gloperate/gloperate_api.h>
+
+#include <gloperate/base/ChronoTimer.h>
+
+
+namespace gloperate
+{
+
+class AbstractStage;
+
+
+/** \brief Per-stage CPU and GPU timings of a pipeline.
+
+    The pipeline reports the execution of every visited stage (see
+    AbstractPipeline::setProfilingEnabled). CPU durations are measured around the
+    stage execution on the thread it runs on. GPU durations of stages bound to the
+    context are measured with timestamp queries, which are kept in a ring of frames
+    in flight and only read once their results are available, so profiling never
+    waits for the GPU. Results that are not available when their slot is reused
+    are dropped.
+
+    Statistics are computed over the samples of the last numFrames() frames, the
+    same frames can be exported as Chrome trace events (chrome://tracing).
+*/
+class GLOPERATE_API PipelineProfiler
+{
+public:
+    struct Statistics
+    {
+        std::size_t numSamples;
+        double min;         /**< In milliseconds */
+        double average;     /**< In milliseconds */
+        double p95;         /**< 95th percentile in milliseconds */
+    };
+
+    struct StageStatistics
+    {
+        const AbstractStage * stage;
+        Statistics cpu;
+        Statistics gpu;
+    };
+
+    static const std::size_t numQuerySlots = 4; /**< Frames of GPU queries in flight */
+
+public:
+    PipelineProfiler(std::size_t numFrames = 120);
+    virtual ~PipelineProfiler();
+
+    PipelineProfiler(const PipelineProfiler &) = delete;
+    PipelineProfiler & operator=(const PipelineProfiler &) = delete;
+
+    std::size_t numFrames() const;
+
+    /** Requires a current context providing timer queries (OpenGL 3.3 or ARB_timer_query) */
+    bool isGpuTimingEnabled() const;
+    void setGpuTimingEnabled(bool enabled);
+
+    /** Stages are referred to by the order they were added, matching the StageGraph indices of the pipeline */
+    void addStage(const AbstractStage * stage);
+    std::size_t numStages() const;
+
+    void beginFrame();
+    void endFrame();
+
+    /** May be called concurrently for different stages. GPU queries are only issued for stages on the context thread. */
+    void beginStage(std::size_t index, bool contextThread);
+    void endStage(std::size_t index, bool processed);
+
+    StageStatistics statistics(std::size_t index) const;
+    std::vector<StageStatistics> statistics() const;
+
+    /** Writes the recorded frames as Chrome trace-event JSON. GPU events are aligned to the start of their frame. */
+    void writeChromeTrace(std::ostream & stream) const;
+    bool saveChromeTrace(const std::string & filename) const;
+
+    void clear();
+
+protected:
+    using clock = std::chrono::high_resolution_clock;
+
+    struct Event
+    {
+        std::size_t stage;
+        std::thread::id thread;
+        ChronoTimer::Duration start;    /**< Relative to the start of the frame */
+        ChronoTimer::Duration duration;
+    };
+
+    struct Frame
+    {
+        std::size_t number;
+        ChronoTimer::Duration start;    /**< Relative to the creation of the profiler */
+        ChronoTimer::Duration duration;
+        std::vector<Event> cpuEvents;
+        std::vector<Event> gpuEvents;
+    };
+
+    struct Samples
+    {
+        std::vector<double> values;
+        std::size_t next;
+
+        void add(double value, std::size_t capacity);
+        Statistics statistics() const;
+    };
+
+    struct StageRecord
+    {
+        const AbstractStage * stage;
+        std::size_t frame;          /**< Frame of the last event, events are collected in endFrame() */
+        bool queried;               /**< Were GPU queries issued in the current frame? */
+        Event event;
+        Samples cpuSamples;
+        Samples gpuSamples;
+    };
+
+    struct QuerySlot
+    {
+        std::size_t frame;
+        bool pending;
+        std::vector<unsigned int> queries;  /**< Begin and end timestamp per stage */
+        std::vector<bool> issued;
+    };
+
+    void resolveQueries(QuerySlot & slot);
+    void releaseQueries();
+    std::string stageName(std::size_t index) const;
+
+protected:
+    std::size_t m_numFrames;
+    bool m_gpuTimingEnabled;
+
+    clock::time_point m_epoch;
+    clock::time_point m_frameStart;
+    std::size_t m_frameNumber;
+    bool m_inFrame;
+
+    std::vector<StageRecord> m_stages;
+    std::vector<Frame> m_frames;            /**< Ring of the last numFrames() frames */
+    QuerySlot m_querySlots[numQuerySlots];
+};
+
+} // namespace gloperate
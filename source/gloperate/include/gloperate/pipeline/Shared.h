@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace gloperate
+{
+
+/** \brief Immutable, reference-counted value with copy-on-write.
+
+    Copying a Shared<T> only copies a reference, so Data<Shared<T>> hands large values
+    (vertex arrays, geometry) between stages without copying them. Readers may keep a
+    snapshot() beyond the next execution, e.g., for an AsyncStage job. write() copies
+    the value only if such a snapshot or another Shared<T> still refers to it.
+
+    Each value carries a version, which changes on write(). Comparison and std::hash use
+    the version, so a value modified in place is not mistaken for its former state.
+*/
+template <typename T>
+class Shared
+{
+public:
+    Shared();
+    Shared(const T & value);
+    Shared(T && value);
+
+    /** Constructs the value in place, T does not need to be default-constructible */
+    template <typename... Args>
+    static Shared<T> make(Args&&... args);
+
+    const T & get() const;
+    const T & operator*() const;
+    const T * operator->() const;
+
+    /** Value for modification, copied first if it is referred to elsewhere.
+        Changes the version, so the reference must not be kept beyond the modification.
+    */
+    T & write();
+
+    /** Identifies the current state of the value, shared by copies until one is written */
+    std::uint64_t version() const;
+
+    /** Keeps the current value alive and unchanged regardless of later writes */
+    std::shared_ptr<const T> snapshot() const;
+
+    /** Whether this is the only reference to the value */
+    bool isUnique() const;
+
+    bool operator==(const Shared<T> & other) const;
+    bool operator!=(const Shared<T> & other) const;
+
+protected:
+    std::shared_ptr<T> m_value;
+    std::uint64_t m_version;
+
+private:
+    explicit Shared(std::shared_ptr<T> value);
+};
+
+
+/** Unique version for a new or written Shared value, thread-safe */
+GLOPERATE_API std::uint64_t nextSharedVersion();
+
+template <typename T>
+std::size_t memoryFootprint(const Shared<T> & value);
+
+} // namespace gloperate
+
+
+namespace std
+{
+
+/** Hashes the version of the value, equal values of different versions hash differently */
+template <typename T>
+struct hash<gloperate::Shared<T>>
+{
+    std::size_t operator()(const gloperate::Shared<T> & value) const
+    {
+        return std::hash<std::uint64_t>()(value.version());
+    }
+};
+
+} // namespace std
+
+
+#include <gloperate/pipeline/Shared.hpp>
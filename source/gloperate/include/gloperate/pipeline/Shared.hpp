@@ -0,0 +1,114 @@
+#pragma once
+
+#include <gloperate/pipeline/Shared.h>
+
+#include <utility>
+
+#include <gloperate/pipeline/DataSnapshot.h>
+
+
+namespace gloperate
+{
+
+template <typename T>
+Shared<T>::Shared()
+: m_value(std::make_shared<T>())
+, m_version(nextSharedVersion())
+{
+}
+
+template <typename T>
+Shared<T>::Shared(const T & value)
+: m_value(std::make_shared<T>(value))
+, m_version(nextSharedVersion())
+{
+}
+
+template <typename T>
+Shared<T>::Shared(T && value)
+: m_value(std::make_shared<T>(std::move(value)))
+, m_version(nextSharedVersion())
+{
+}
+
+template <typename T>
+Shared<T>::Shared(std::shared_ptr<T> value)
+: m_value(std::move(value))
+, m_version(nextSharedVersion())
+{
+}
+
+template <typename T>
+template <typename... Args>
+Shared<T> Shared<T>::make(Args&&... args)
+{
+    return Shared<T>(std::make_shared<T>(std::forward<Args>(args)...));
+}
+
+template <typename T>
+const T & Shared<T>::get() const
+{
+    return *m_value;
+}
+
+template <typename T>
+const T & Shared<T>::operator*() const
+{
+    return *m_value;
+}
+
+template <typename T>
+const T * Shared<T>::operator->() const
+{
+    return m_value.get();
+}
+
+template <typename T>
+T & Shared<T>::write()
+{
+    if (!isUnique())
+        m_value = std::make_shared<T>(*m_value);
+
+    m_version = nextSharedVersion();
+
+    return *m_value;
+}
+
+template <typename T>
+std::uint64_t Shared<T>::version() const
+{
+    return m_version;
+}
+
+template <typename T>
+std::shared_ptr<const T> Shared<T>::snapshot() const
+{
+    return m_value;
+}
+
+template <typename T>
+bool Shared<T>::isUnique() const
+{
+    return m_value.use_count() == 1;
+}
+
+template <typename T>
+bool Shared<T>::operator==(const Shared<T> & other) const
+{
+    return m_version == other.m_version;
+}
+
+template <typename T>
+bool Shared<T>::operator!=(const Shared<T> & other) const
+{
+    return m_version != other.m_version;
+}
+
+template <typename T>
+std::size_t memoryFootprint(const Shared<T> & value)
+{
+    // Cached snapshots keep the payload alive, so it is accounted for
+    return sizeof(value) + memoryFootprint(value.get());
+}
+
+} // namespace gloperate
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace gloperate
+{
+
+class AbstractStage;
+
+
+/** \brief Dependency graph of the stages of a pipeline with a maintained topological order.
+
+    The graph keeps explicit predecessor and successor lists per stage, built from
+    the input slot connections and manual dependencies of the stages (see
+    AbstractStage::dependencies()). The topological order is computed with Kahn's
+    algorithm in O(V + E).
+
+    When the connections of a single stage change, updateStage() adjusts the
+    adjacency lists of that stage only and repairs the order locally (Pearce-Kelly),
+    touching just the stages between the two ends of a violating edge.
+
+    Stages are referred to by their index, i.e., the order in which they were added.
+*/
+class GLOPERATE_API StageGraph
+{
+public:
+    static const std::size_t npos;
+
+public:
+    StageGraph();
+    virtual ~StageGraph();
+
+    void clear();
+    void addStage(AbstractStage * stage);
+
+    std::size_t size() const;
+    std::size_t indexOf(const AbstractStage * stage) const;
+    AbstractStage * stage(std::size_t index) const;
+
+    const std::vector<std::size_t> & predecessors(std::size_t index) const;
+    const std::vector<std::size_t> & successors(std::size_t index) const;
+
+    /** Re-reads the dependencies of a single stage.
+        \return true if the topological order changed or has to be recomputed
+    */
+    bool updateStage(const AbstractStage * stage);
+
+    bool isSorted() const;
+
+    /** Rebuilds the adjacency lists if necessary and computes the topological order.
+        \return false if the graph contains cycles, see cyclicStages()
+    */
+    bool sort();
+
+    /** Stage indices in topological order. If the graph is cyclic, the stages that
+        could not be sorted are appended in insertion order.
+    */
+    const std::vector<std::size_t> & order() const;
+    std::size_t position(std::size_t index) const;
+
+    std::vector<AbstractStage *> sortedStages() const;
+
+    /** Stages that lie on or between dependency cycles, empty if the graph is acyclic */
+    std::vector<AbstractStage *> cyclicStages() const;
+
+protected:
+    struct Node
+    {
+        AbstractStage * stage;
+        std::vector<std::size_t> predecessors;
+        std::vector<std::size_t> successors;
+    };
+
+    void build();
+    void collectPredecessors(std::size_t index, std::vector<std::size_t> & predecessors) const;
+    bool reorder(std::size_t from, std::size_t to);
+    void findCycles(const std::vector<std::size_t> & inDegrees);
+
+protected:
+    std::vector<Node> m_nodes;
+    std::unordered_map<const AbstractStage *, std::size_t> m_indices;
+
+    std::vector<std::size_t> m_order;       /**< Position -> stage index */
+    std::vector<std::size_t> m_positions;   /**< Stage index -> position */
+    std::vector<std::size_t> m_cyclic;      /**< Stage indices on or between cycles */
+
+    bool m_built;       /**< Are the adjacency lists up to date? */
+    bool m_sorted;      /**< Is m_order a valid topological order? */
+    bool m_orderDirty;  /**< Has the order to be recomputed by sort()? */
+};
+
+} // namespace gloperate
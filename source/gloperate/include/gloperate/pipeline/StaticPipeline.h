@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+#include <gloperate/pipeline/AbstractPipeline.h>
+#include <gloperate/pipeline/Data.h>
+#include <gloperate/pipeline/InputSlot.h>
+
+
+namespace gloperate
+{
+
+/** \brief Pipeline with a fixed set of stages, wired through their typed members.
+
+    The stages are default-constructed and owned by the pipeline. Subclasses connect
+    them with connect(), which fails to compile for mismatching InputSlot and Data types
+    like assigning the data to the slot.
+
+    Stages are executed in the order of the template arguments, which has to be a
+    topological order (checked on initialization). Execution is an unrolled sequence
+    over the typed stages without sorting, worklist or signal-based scheduling. The
+    stages still reuse AbstractStage::process() and are registered with AbstractPipeline,
+    so stages(), parameters() and findOutputs() work as for any other pipeline.
+
+    Settings that rely on the worklist are not supported: worker threads (setWorkerCount()),
+    profiling, demand-driven execution and frame pipelining. Like within an invalidation
+    transaction, execute() reports them and returns without executing.
+*/
+template <typename... Stages>
+class StaticPipeline : public AbstractPipeline
+{
+public:
+    static const std::size_t numStages = sizeof...(Stages);
+
+    template <std::size_t Index>
+    using StageType = typename std::tuple_element<Index, std::tuple<Stages...>>::type;
+
+public:
+    StaticPipeline(const std::string & name = "");
+    virtual ~StaticPipeline();
+
+    template <std::size_t Index>
+    StageType<Index> & stage();
+    template <std::size_t Index>
+    const StageType<Index> & stage() const;
+
+    /** Executes the enabled stages that need to process in declaration order, on the calling thread */
+    virtual void execute() override;
+
+    /** Stages are fixed by the template arguments, added stages are owned but never executed */
+    virtual void addStage(AbstractStage * stage) override;
+
+    template <typename T, typename U>
+    static void connect(InputSlot<T> & slot, const Data<U> & data);
+
+protected:
+    virtual bool initializeStages() override;
+
+    template <std::size_t Index>
+    typename std::enable_if<Index < sizeof...(Stages)>::type registerStages();
+    template <std::size_t Index>
+    typename std::enable_if<Index == sizeof...(Stages)>::type registerStages();
+
+    template <std::size_t Index>
+    typename std::enable_if<Index < sizeof...(Stages), std::size_t>::type executeStages();
+    template <std::size_t Index>
+    typename std::enable_if<Index == sizeof...(Stages), std::size_t>::type executeStages();
+
+    static bool executeStage(AbstractStage & stage);
+
+    bool isDeclarationOrderSorted() const;
+
+protected:
+    std::tuple<Stages *...> m_typedStages;
+};
+
+} // namespace gloperate
+
+
+#include <gloperate/pipeline/StaticPipeline.hpp>
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <gloperate/pipeline/StaticPipeline.h>
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+#include <gloperate/pipeline/AbstractStage.h>
+
+
+namespace gloperate
+{
+
+template <typename... Stages>
+StaticPipeline<Stages...>::StaticPipeline(const std::string & name)
+: AbstractPipeline(name)
+, m_typedStages(new Stages()...)
+{
+    registerStages<0>();
+}
+
+template <typename... Stages>
+StaticPipeline<Stages...>::~StaticPipeline()
+{
+}
+
+template <typename... Stages>
+template <std::size_t Index>
+auto StaticPipeline<Stages...>::stage() -> StageType<Index> &
+{
+    return *std::get<Index>(m_typedStages);
+}
+
+template <typename... Stages>
+template <std::size_t Index>
+auto StaticPipeline<Stages...>::stage() const -> const StageType<Index> &
+{
+    return *std::get<Index>(m_typedStages);
+}
+
+template <typename... Stages>
+void StaticPipeline<Stages...>::execute()
+{
+    if (!m_initialized)
+        return;
+
+    // Stages would not see the invalidations of their predecessors until the commit
+    if (isTransactionActive() || InvalidationTransaction::isActive())
+    {
+        std::cerr << "Pipeline " << asPrintable() << " is not executed within an invalidation transaction" << std::endl;
+        return;
+    }
+
+    // The unrolled execution bypasses the worklist these rely on
+    if (m_workerCount > 1 || m_profiler || m_demandDriven || m_framePipelining)
+    {
+        std::cerr << "Pipeline " << asPrintable() << " is static and does not support workers, profiling, demand-driven execution or frame pipelining" << std::endl;
+        return;
+    }
+
+    // Completes finished background jobs, their stages are executed anyway
+    m_backgroundWorkers.runPosted();
+
+    if (!m_fusionComputed)
+    {
+        computeFusion();
+        m_transientResources.invalidatePlan();
+    }
+
+    if (!m_transientResources.isPlanned())
+    {
+        // Stages are executed in the order they were declared and registered
+        std::vector<std::size_t> times(m_graph.size());
+        std::iota(times.begin(), times.end(), std::size_t(0));
+
+        m_transientResources.plan(m_graph, times);
+    }
+
+    m_stateCache.beginFrame();
+
+    m_visitedStages = numStages;
+    m_processedStages = executeStages<0>();
+}
+
+template <typename... Stages>
+void StaticPipeline<Stages...>::addStage(AbstractStage * stage)
+{
+    std::cout << "Stage " << stage->asPrintable() << " added to static pipeline " << asPrintable() << " will not be executed" << std::endl;
+
+    registerStage(stage);
+}
+
+template <typename... Stages>
+template <typename T, typename U>
+void StaticPipeline<Stages...>::connect(InputSlot<T> & slot, const Data<U> & data)
+{
+    slot = data;
+}
+
+template <typename... Stages>
+bool StaticPipeline<Stages...>::initializeStages()
+{
+    if (!AbstractPipeline::initializeStages())
+        return false;
+
+    if (!isDeclarationOrderSorted())
+    {
+        std::cout << "Stages of static pipeline " << asPrintable() << " are not declared in dependency order" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+template <typename... Stages>
+template <std::size_t Index>
+auto StaticPipeline<Stages...>::registerStages() -> typename std::enable_if<Index < sizeof...(Stages)>::type
+{
+    registerStage(std::get<Index>(m_typedStages));
+    registerStages<Index + 1>();
+}
+
+template <typename... Stages>
+template <std::size_t Index>
+auto StaticPipeline<Stages...>::registerStages() -> typename std::enable_if<Index == sizeof...(Stages)>::type
+{
+}
+
+template <typename... Stages>
+template <std::size_t Index>
+auto StaticPipeline<Stages...>::executeStages() -> typename std::enable_if<Index < sizeof...(Stages), std::size_t>::type
+{
+    const std::size_t processed = executeStage(*std::get<Index>(m_typedStages)) ? 1 : 0;
+    std::get<Index>(m_typedStages)->replayCommands();
+
+    return processed + executeStages<Index + 1>();
+}
+
+template <typename... Stages>
+template <std::size_t Index>
+auto StaticPipeline<Stages...>::executeStages() -> typename std::enable_if<Index == sizeof...(Stages), std::size_t>::type
+{
+    return 0;
+}
+
+template <typename... Stages>
+bool StaticPipeline<Stages...>::executeStage(AbstractStage & stage)
+{
+    if (!stage.beginProcess())
+        return false;
+
+    if (stage.m_memoized && stage.m_outputCache)
+        stage.processMemoized();
+    else
+        stage.process();
+
+    stage.endProcess();
+
+    return true;
+}
+
+template <typename... Stages>
+bool StaticPipeline<Stages...>::isDeclarationOrderSorted() const
+{
+    // Registered stages keep their declaration index in the graph
+    for (std::size_t index = 0; index < numStages; ++index)
+    {
+        for (auto predecessor : m_graph.predecessors(index))
+        {
+            if (predecessor >= index)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace gloperate
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+
+#include <glm/vec2.hpp>
+
+#include <glbinding/gl/types.h>
+
+#include <globjects/base/ref_ptr.h>
+
+#include <gloperate/gloperate_api.h>
+
+
+namespace globjects
+{
+
+class Texture;
+class Renderbuffer;
+
+}
+
+
+namespace gloperate
+{
+
+class AbstractStage;
+class AbstractData;
+class TransientResourcePool;
+
+
+/** \brief Texture or renderbuffer a stage needs only while the pipeline executes.
+
+    A stage declares its transient resources by description (see AbstractStage::addTransientResource)
+    instead of owning the GPU objects. The TransientResourcePool of the pipeline assigns them to
+    pooled objects, and resources with non-overlapping lifetimes share the same object.
+
+    A resource lives while its stage processes. If it is passed to other stages through an output,
+    it lives until the last consumer of that output is processed. The objects are only valid from
+    the start of process() and may change between executions, so stages must not keep them.
+*/
+class GLOPERATE_API TransientResource
+{
+    friend class AbstractStage;
+    friend class TransientResourcePool;
+
+public:
+    enum class Type
+    {
+        Texture
+    ,   Renderbuffer
+    };
+
+public:
+    /** Describes a renderbuffer, scaled relative to the viewport */
+    TransientResource(gl::GLenum internalFormat, float scale = 1.0f);
+    /** Describes a 2D texture, scaled relative to the viewport */
+    TransientResource(gl::GLenum internalFormat, gl::GLenum format, gl::GLenum type, float scale = 1.0f);
+    virtual ~TransientResource();
+
+    TransientResource(const TransientResource &) = delete;
+    TransientResource & operator=(const TransientResource &) = delete;
+
+    Type type() const;
+    gl::GLenum internalFormat() const;
+    gl::GLenum format() const;
+    gl::GLenum dataType() const;
+    float scale() const;
+
+    /** A fixed size overrides the scale, (0, 0) makes the resource relative to the viewport again */
+    const glm::ivec2 & fixedSize() const;
+    void setFixedSize(const glm::ivec2 & size);
+
+    /** Resolved size for the given viewport, at least 1x1 */
+    glm::ivec2 sizeFor(const glm::ivec2 & viewport) const;
+
+    /** Resources of equal descriptions may share a pooled object */
+    bool isCompatible(const TransientResource & other) const;
+
+    AbstractStage * owner() const;
+    const AbstractData * exportedAs() const;
+
+    /** Index of the pooled object the resource is assigned to, TransientResourcePool::npos if not planned yet */
+    std::size_t slot() const;
+
+    /** Current size of the pooled object */
+    const glm::ivec2 & size() const;
+
+    globjects::Texture * texture() const;
+    globjects::Renderbuffer * renderbuffer() const;
+
+protected:
+    Type m_type;
+    gl::GLenum m_internalFormat;
+    gl::GLenum m_format;
+    gl::GLenum m_dataType;
+    float m_scale;
+    glm::ivec2 m_fixedSize;
+
+    AbstractStage * m_owner;
+    const AbstractData * m_exportedAs;  /**< Output passing the resource on, extends the lifetime to its consumers */
+
+    std::size_t m_slot;
+    glm::ivec2 m_size;
+    globjects::ref_ptr<globjects::Texture> m_texture;
+    globjects::ref_ptr<globjects::Renderbuffer> m_renderbuffer;
+};
+
+} // namespace gloperate
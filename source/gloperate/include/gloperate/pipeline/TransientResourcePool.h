@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include <globjects/base/ref_ptr.h>
+
+#include <gloperate/gloperate_api.h>
+
+#include <gloperate/pipeline/TransientResource.h>
+
+
+namespace globjects
+{
+
+class Texture;
+class Renderbuffer;
+
+}
+
+
+namespace gloperate
+{
+
+class AbstractStage;
+class StageGraph;
+
+
+/** \brief Pooled GPU objects for the transient resources of the stages of a pipeline.
+
+    plan() derives the lifetime of each TransientResource from the execution order of
+    the stages: it starts when its stage is processed and ends when the last consumer of
+    the output it is exported through is processed. Compatible resources whose lifetimes
+    do not overlap are aliased onto the same pooled object (greedy interval partitioning,
+    which needs the minimal number of objects per description).
+
+    The objects are created and resized lazily when a stage acquires its resources right
+    before processing, so storage is only re-specified after the viewport changed.
+
+    An exported resource keeps its contents across executions as long as no other resource
+    is acquired on its object. If that happens, e.g. because only a later stage is processed,
+    its stage is scheduled again for the next execution.
+
+    The pool is owned by the pipeline. Acquiring issues OpenGL calls, so stages with
+    transient resources have to run on the context thread.
+*/
+class GLOPERATE_API TransientResourcePool
+{
+public:
+    static const std::size_t npos;
+
+public:
+    TransientResourcePool();
+    virtual ~TransientResourcePool();
+
+    TransientResourcePool(const TransientResourcePool &) = delete;
+    TransientResourcePool & operator=(const TransientResourcePool &) = delete;
+
+    const glm::ivec2 & viewport() const;
+    void setViewport(const glm::ivec2 & viewport);
+
+    /** Aliasing can be disabled for debugging, every resource gets an object of its own then */
+    bool isAliasing() const;
+    void setAliasing(bool enabled);
+
+    bool isPlanned() const;
+    void invalidatePlan();
+
+    /** Assigns the transient resources of all stages in the graph to pooled objects.
+        \param times
+            Execution time of each stage index, i.e., its position for sequential execution
+            or its level if stages of a level may run in any order
+    */
+    void plan(const StageGraph & graph, const std::vector<std::size_t> & times);
+
+    /** Binds the resources of the stage to their pooled objects, (re-)allocating them if necessary */
+    void acquire(AbstractStage * stage);
+
+    /** Forgets a resource that is removed from its stage or destroyed with it, invalidates the plan */
+    void remove(const TransientResource * resource);
+
+    /** Number of pooled objects, i.e., resources that are alive at the same time */
+    std::size_t slotCount() const;
+    /** Number of resources assigned to pooled objects */
+    std::size_t resourceCount() const;
+    /** Number of storage (re-)specifications so far */
+    std::size_t allocationCount() const;
+
+    /** Releases all pooled objects, they are recreated on the next acquire */
+    void clear();
+
+protected:
+    /** Copy of the description of a resource, see TransientResource::isCompatible() */
+    struct Description
+    {
+        TransientResource::Type type;
+        gl::GLenum internalFormat;
+        gl::GLenum format;
+        gl::GLenum dataType;
+        float scale;
+        glm::ivec2 fixedSize;
+
+        Description(const TransientResource & resource);
+
+        bool operator==(const Description & other) const;
+    };
+
+    struct Slot
+    {
+        Description description;                /**< Of the first resource assigned, all others are compatible */
+        std::size_t end;                        /**< Time of the end of the last assigned lifetime */
+        const TransientResource * occupant;     /**< Resource whose contents the object holds, cleared on remove() */
+        glm::ivec2 size;
+        globjects::ref_ptr<globjects::Texture> texture;
+        globjects::ref_ptr<globjects::Renderbuffer> renderbuffer;
+    };
+
+    struct Lifetime
+    {
+        TransientResource * resource;
+        std::size_t start;
+        std::size_t end;
+    };
+
+    void allocate(Slot & slot, const glm::ivec2 & size);
+
+protected:
+    glm::ivec2 m_viewport;
+    bool m_aliasing;
+    bool m_planned;
+
+    std::vector<Slot> m_slots;
+    std::vector<Lifetime> m_lifetimes;  /**< Sorted by start */
+    std::size_t m_allocations;
+};
+
+} // namespace gloperate
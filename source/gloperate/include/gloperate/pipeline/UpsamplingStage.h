@@ -0,0 +1,93 @@
+#pragma once
+
+#include <string>
+
+#include <glbinding/gl/enum.h>
+
+#include <globjects/base/ref_ptr.h>
+
+#include <gloperate/gloperate_api.h>
+
+#include <gloperate/pipeline/AbstractStage.h>
+#include <gloperate/pipeline/Data.h>
+#include <gloperate/pipeline/InputSlot.h>
+#include <gloperate/pipeline/TransientResource.h>
+
+
+namespace globjects
+{
+
+class Framebuffer;
+class Texture;
+
+}
+
+
+namespace gloperate
+{
+
+class ScreenAlignedQuad;
+
+
+/** \brief Resamples the output of a reduced-resolution stage for a stage of higher resolution.
+
+    Stages declare the resolution of their render targets as a scale of the viewport (see
+    TransientResource), so expensive passes like ambient occlusion or blur can run at half or
+    quarter resolution. An upsampling stage is connected between such a stage and its
+    full-resolution consumer and renders the source into a target of the given scale.
+
+    Bilinear filtering blurs across edges, which shows as halos around foreground objects.
+    The bilateral filter additionally weights the four nearest source texels by how similar
+    their depth (sourceDepth, at the resolution of the source) is to the depth of the target
+    pixel (depth, at the resolution of the target). Without connected depth inputs it falls
+    back to bilinear filtering.
+*/
+class GLOPERATE_API UpsamplingStage : public AbstractStage
+{
+public:
+    enum class Filter
+    {
+        Bilinear
+    ,   Bilateral
+    };
+
+public:
+    /** Fragment shader for the given filter, reading the uniforms source, sourceDepth, depth and depthSharpness */
+    static std::string fragmentShaderSource(Filter filter);
+
+public:
+    UpsamplingStage(
+        Filter filter = Filter::Bilinear,
+        gl::GLenum internalFormat = gl::GL_RGBA8,
+        gl::GLenum format = gl::GL_RGBA,
+        gl::GLenum type = gl::GL_UNSIGNED_BYTE,
+        float scale = 1.0f);
+    virtual ~UpsamplingStage();
+
+    virtual void initialize() override;
+
+    Filter filter() const;
+
+public:
+    InputSlot<globjects::ref_ptr<globjects::Texture>> source;
+    InputSlot<globjects::ref_ptr<globjects::Texture>> sourceDepth;
+    InputSlot<globjects::ref_ptr<globjects::Texture>> depth;
+
+    /** Falloff of the depth weights, higher values preserve edges more strictly */
+    InputSlot<float> depthSharpness;
+
+    Data<globjects::ref_ptr<globjects::Texture>> target;
+
+protected:
+    virtual void process() override;
+
+protected:
+    Filter m_filter;
+    TransientResource m_target;
+
+    globjects::ref_ptr<globjects::Framebuffer> m_fbo;
+    globjects::ref_ptr<ScreenAlignedQuad> m_bilinearQuad;
+    globjects::ref_ptr<ScreenAlignedQuad> m_bilateralQuad;
+};
+
+} // namespace gloperate
@@ -16,6 +16,9 @@
 namespace gloperate
 {
 
+class StateCache;
+
+
 class GLOPERATE_API ScreenAlignedQuad : public globjects::Referenced
 {
 public:
@@ -25,6 +28,8 @@ public:
     ScreenAlignedQuad(globjects::Program * program);
 
     void draw();
+    /** Binds the texture and program through the cache and leaves them bound for the next draw */
+    void draw(StateCache & stateCache);
 
     globjects::Program * program();
 
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+#include <gloperate/gloperate_api.h>
+
+namespace gloperate
+{
+
+class Painter;
+class AbstractVirtualTimeCapability;
+
+
+/** \brief Steps the virtual time of a painter frame by frame, as fast as possible.
+
+    Instead of wall-clock deltas, every frame advances the painter's virtual time
+    by exactly one fixed step, starting at 0. Each run therefore renders the same
+    sequence of frames regardless of machine load, for benchmarks and offline captures.
+
+    The fixed step of the capability is set on construction and restored on destruction.
+*/
+class GLOPERATE_API FixedStepDriver
+{
+public:
+    /** Called for each frame after time has advanced, renders the frame */
+    using PaintFunction = std::function<void(std::size_t frameNumber)>;
+
+    static bool isApplicableTo(Painter * painter);
+
+public:
+    FixedStepDriver(Painter * painter, float step = 1.0f / 60.0f);
+    ~FixedStepDriver();
+
+    FixedStepDriver(const FixedStepDriver &) = delete;
+    FixedStepDriver & operator=(const FixedStepDriver &) = delete;
+
+    float step() const;
+    std::size_t frameNumber() const;
+
+    /** Resets virtual time to 0 and the frame number to 0 */
+    void rewind();
+
+    /** Advances virtual time by one step without painting */
+    void advance();
+
+    /** Advances and paints numFrames frames, with Painter::paint() if paint is empty */
+    void run(std::size_t numFrames, const PaintFunction & paint = PaintFunction());
+
+protected:
+    Painter * m_painter;
+    AbstractVirtualTimeCapability * m_timeCapability;
+
+    float m_step;
+    float m_previousStep;   /**< Fixed step of the capability before the driver took over */
+    std::size_t m_frameNumber;
+};
+
+} // namespace gloperate
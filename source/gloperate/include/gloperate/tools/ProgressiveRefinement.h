@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+
+#include <signalzeug/Signal.h>
+
+#include <gloperate/gloperate_api.h>
+
+namespace gloperate
+{
+
+class Painter;
+class AbstractProgressiveCapability;
+
+
+/** \brief Counts the frames a painter's view stays unchanged, for progressive rendering.
+
+    Hosts paint between beginPaint() and endPaint(). beginPaint() hands the index of
+    the frame since the view last changed to the painter's AbstractProgressiveCapability.
+    Any change of another capability of the painter (camera, projection, viewport,
+    virtual time, target framebuffer, resolution scale, ...) restarts at frame 0, also
+    during painting, e.g., when a ResolutionScaler changes the viewport.
+
+    While isRefining(), a still view has not converged yet, and hosts rendering on
+    demand have to keep repainting. Painters without the capability are never refining.
+
+    The painter has to outlive the refinement or be replaced through setPainter() before
+    it is deleted.
+*/
+class GLOPERATE_API ProgressiveRefinement
+{
+public:
+    ProgressiveRefinement(Painter * painter = nullptr);
+    ~ProgressiveRefinement();
+
+    ProgressiveRefinement(const ProgressiveRefinement &) = delete;
+    ProgressiveRefinement & operator=(const ProgressiveRefinement &) = delete;
+
+    Painter * painter() const;
+    void setPainter(Painter * painter);
+
+    unsigned int frameIndex() const;
+    bool isRefining() const;
+
+    /** Restarts at frame 0, e.g., when the host changed something the capabilities do not reflect */
+    void restart();
+
+    void beginPaint();
+    void endPaint();
+
+protected:
+    void connect();
+    void disconnect();
+
+protected:
+    Painter * m_painter;
+    AbstractProgressiveCapability * m_capability;
+    std::vector<signalzeug::Connection> m_connections;
+
+    unsigned int m_frameIndex;
+};
+
+} // namespace gloperate
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <signalzeug/Signal.h>
+
+#include <gloperate/gloperate_api.h>
+
+namespace gloperate
+{
+
+class Painter;
+
+
+/** \brief Tells a host when a painter has to be repainted, for rendering on demand.
+
+    A repaint is required when one of the painter's capabilities signals a change
+    (viewport, camera, projection, virtual time, target framebuffer, ...), when one
+    of the outputs of its AbstractOutputCapability is invalidated or, for BufferedData
+    written by frame-ahead stages, published, or when the host
+    calls requestRepaint(), e.g., for input events. Hosts render between beginPaint()
+    and endPaint(), and sleep while isRepaintRequired() is false.
+
+    Changes made by the painting thread during painting are ignored, as they result from
+    the frame itself, e.g., a pipeline writing its outputs or a painter adapting its
+    projection to the viewport. Changes from other threads always require a repaint.
+    Changes from outside the painter need an explicit requestRepaint(), e.g., connected
+    to BackgroundWorkers::posted of a pipeline with AsyncStages.
+
+    The painter has to outlive the monitor or be replaced through setPainter() before
+    it is deleted.
+*/
+class GLOPERATE_API RepaintMonitor
+{
+public:
+    RepaintMonitor(Painter * painter = nullptr);
+    ~RepaintMonitor();
+
+    RepaintMonitor(const RepaintMonitor &) = delete;
+    RepaintMonitor & operator=(const RepaintMonitor &) = delete;
+
+    Painter * painter() const;
+    void setPainter(Painter * painter);
+
+    bool isRepaintRequired() const;
+
+    /** Thread-safe, so outputs may be invalidated on worker threads */
+    void requestRepaint();
+
+    void beginPaint();
+    void endPaint();
+
+public:
+    /** Emitted when a repaint becomes required, possibly on a worker thread */
+    signalzeug::Signal<> repaintRequested;
+
+protected:
+    void connect();
+    void disconnect();
+
+    void onChanged();
+
+protected:
+    Painter * m_painter;
+    std::vector<signalzeug::Connection> m_connections;
+
+    std::atomic<bool> m_repaintRequired;
+    std::atomic<std::thread::id> m_paintingThread;  /**< Default id while not painting */
+};
+
+} // namespace gloperate
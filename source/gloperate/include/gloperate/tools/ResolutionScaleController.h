@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <gloperate/gloperate_api.h>
+
+namespace gloperate
+{
+
+/** \brief Chooses a render scale that holds a target frame time.
+
+    The controller is fed the time of every frame rendered at the current scale. After
+    numSamples frames, it compares their mean to the target. Frames over the target lower
+    the scale right away, assuming the frame time is proportional to the pixel count,
+    i.e., to the square of the scale. The scale is raised one step at a time, and only
+    if the raised frame is predicted to stay below headroom times the target. The band
+    between both keeps the scale from oscillating.
+
+    Scales are multiples of step, so the rendered resolution only changes in noticeable
+    steps, and samples are collected anew after every change.
+*/
+class GLOPERATE_API ResolutionScaleController
+{
+public:
+    static const std::size_t numSamples = 8;
+    static const float step;
+    static const float headroom;
+
+public:
+    ResolutionScaleController(float targetFrameTime = 1.0f / 60.0f);
+
+    /** In seconds */
+    float targetFrameTime() const;
+    void setTargetFrameTime(float targetFrameTime);
+
+    float minimumScale() const;
+    float maximumScale() const;
+    /** Clamps the current scale to the range */
+    void setScaleRange(float minimum, float maximum);
+
+    float scale() const;
+
+    /** Sets the scale and discards the collected samples */
+    void reset(float scale = 1.0f);
+
+    /** Adds the time of a frame rendered at scale(), in seconds, and returns the new scale */
+    float update(float frameTime);
+
+protected:
+    float clamp(float scale) const;
+
+protected:
+    float m_targetFrameTime;
+    float m_minimumScale;
+    float m_maximumScale;
+    float m_scale;
+    std::vector<float> m_samples;
+};
+
+} // namespace gloperate
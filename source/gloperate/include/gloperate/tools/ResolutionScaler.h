@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+
+#include <glm/glm.hpp>
+
+#include <globjects/base/ref_ptr.h>
+#include <globjects/Texture.h>
+#include <globjects/Framebuffer.h>
+#include <globjects/Renderbuffer.h>
+
+#include <gloperate/gloperate_api.h>
+#include <gloperate/tools/ResolutionScaleController.h>
+
+namespace gloperate
+{
+
+class Painter;
+class AbstractResolutionScaleCapability;
+class AbstractViewportCapability;
+class AbstractTargetFramebufferCapability;
+
+
+/** \brief Paints a painter at a reduced resolution and upsamples it to the output.
+
+    The viewport the host sets on the painter is the output. While the scale of the
+    painter's ResolutionScaleCapability is below 1, the painter gets a scaled viewport
+    and a framebuffer of that size as target. After painting, the framebuffer is
+    upsampled bilinearly into the host's target framebuffer (or the default one).
+    The scaled viewport stays set between frames, so the painter only sees a change
+    when the scale or the output size changed. Input coordinates have to be mapped
+    with mapToViewport() accordingly.
+
+    If adaptive, the GPU time of every frame is measured and the controller adjusts the
+    scale to hold its target frame time. Measuring requires timer queries (OpenGL 3.3
+    or ARB_timer_query), results are read a few frames later, so the GPU is never waited for.
+    Without timer queries, which initialize() detects, the scaler keeps the scale set on the
+    painter and cannot be made adaptive.
+*/
+class GLOPERATE_API ResolutionScaler
+{
+public:
+    static bool isApplicableTo(Painter * painter);
+
+public:
+    ResolutionScaler(Painter * painter);
+    virtual ~ResolutionScaler();
+
+    ResolutionScaler(const ResolutionScaler &) = delete;
+    ResolutionScaler & operator=(const ResolutionScaler &) = delete;
+
+    ResolutionScaleController & controller();
+    const ResolutionScaleController & controller() const;
+
+    bool isAdaptive() const;
+    void setAdaptive(bool adaptive);
+
+    /** Whether the context supports timer queries, known after initialize() */
+    bool hasTimerQueries() const;
+
+    /** Requires the painter's context to be current */
+    void initialize();
+
+    /** Paints the painter at the current scale, instead of Painter::paint() */
+    void paint();
+
+    /** Maps a position in the output viewport to the viewport the painter renders */
+    glm::ivec2 mapToViewport(const glm::ivec2 & position) const;
+
+protected:
+    static const std::size_t numQuerySlots = 4;
+
+    struct QuerySlot
+    {
+        bool pending;
+        float scale;            /**< Scale the frame was rendered at */
+        unsigned int queries[2];
+    };
+
+    void updateViewport(float scale);
+    void resizeTarget(const glm::ivec2 & size);
+    void upsample();
+    void resolveQueries(QuerySlot & slot);
+
+protected:
+    Painter * m_painter;
+    AbstractResolutionScaleCapability * m_scaleCapability;
+    AbstractViewportCapability * m_viewportCapability;
+    AbstractTargetFramebufferCapability * m_framebufferCapability;
+
+    ResolutionScaleController m_controller;
+    bool m_adaptive;
+    bool m_timerQueries;
+
+    glm::ivec4 m_output;    /**< Viewport set by the host */
+    glm::ivec4 m_applied;   /**< Viewport last set by the scaler */
+    bool m_scaled;          /**< Is the painter rendering into m_fbo? */
+
+    globjects::ref_ptr<globjects::Framebuffer> m_target;  /**< The host's target framebuffer while scaling, can be nullptr */
+    globjects::ref_ptr<globjects::Framebuffer> m_fbo;
+    globjects::ref_ptr<globjects::Texture> m_color;
+    globjects::ref_ptr<globjects::Renderbuffer> m_depth;
+    glm::ivec2 m_size;
+
+    std::array<QuerySlot, numQuerySlots> m_querySlots;
+    std::size_t m_frameNumber;
+};
+
+} // namespace gloperate
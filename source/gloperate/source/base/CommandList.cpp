@@ -0,0 +1,267 @@
+#include <gloperate/base/CommandList.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <glbinding/gl/enum.h>
+#include <glbinding/gl/boolean.h>
+#include <glbinding/gl/functions.h>
+
+#include <globjects/Framebuffer.h>
+#include <globjects/Program.h>
+#include <globjects/Texture.h>
+#include <globjects/VertexArray.h>
+
+#include <gloperate/base/StateCache.h>
+
+
+namespace gloperate
+{
+
+CommandList::Functions CommandList::glFunctions()
+{
+    Functions functions;
+
+    functions.clear = [](gl::ClearBufferMask mask) { gl::glClear(mask); };
+    functions.bindVertexArray = [](gl::GLuint vertexArray) { gl::glBindVertexArray(vertexArray); };
+    functions.uniform1i = [](gl::GLint location, gl::GLint value) { gl::glUniform1i(location, value); };
+    functions.uniform1fv = [](gl::GLint location, gl::GLsizei count, const gl::GLfloat * values) { gl::glUniform1fv(location, count, values); };
+    functions.uniform2fv = [](gl::GLint location, gl::GLsizei count, const gl::GLfloat * values) { gl::glUniform2fv(location, count, values); };
+    functions.uniform3fv = [](gl::GLint location, gl::GLsizei count, const gl::GLfloat * values) { gl::glUniform3fv(location, count, values); };
+    functions.uniform4fv = [](gl::GLint location, gl::GLsizei count, const gl::GLfloat * values) { gl::glUniform4fv(location, count, values); };
+    functions.uniformMatrix4fv = [](gl::GLint location, gl::GLsizei count, gl::GLboolean transpose, const gl::GLfloat * values) { gl::glUniformMatrix4fv(location, count, transpose, values); };
+    functions.drawArrays = [](gl::GLenum mode, gl::GLint first, gl::GLsizei count) { gl::glDrawArrays(mode, first, count); };
+    functions.drawElements = [](gl::GLenum mode, gl::GLsizei count, gl::GLenum type, const void * indices) { gl::glDrawElements(mode, count, type, indices); };
+
+    return functions;
+}
+
+CommandList::CommandList()
+:   CommandList(glFunctions())
+{
+}
+
+CommandList::CommandList(const Functions & functions)
+:   m_functions(functions)
+{
+}
+
+CommandList::~CommandList()
+{
+}
+
+void CommandList::enable(gl::GLenum capability)
+{
+    record(Opcode::Enable).enums[0] = capability;
+}
+
+void CommandList::disable(gl::GLenum capability)
+{
+    record(Opcode::Disable).enums[0] = capability;
+}
+
+void CommandList::viewport(gl::GLint x, gl::GLint y, gl::GLsizei width, gl::GLsizei height)
+{
+    auto & command = record(Opcode::Viewport);
+    command.arguments[0] = x;
+    command.arguments[1] = y;
+    command.arguments[2] = width;
+    command.arguments[3] = height;
+}
+
+void CommandList::clearColor(gl::GLfloat red, gl::GLfloat green, gl::GLfloat blue, gl::GLfloat alpha)
+{
+    const gl::GLfloat values[] = { red, green, blue, alpha };
+    recordFloats(Opcode::ClearColor, 0, values, 4);
+}
+
+void CommandList::depthMask(bool enabled)
+{
+    record(Opcode::DepthMask).arguments[0] = enabled ? 1 : 0;
+}
+
+void CommandList::bindFramebuffer(gl::GLenum target, const globjects::Framebuffer * framebuffer)
+{
+    auto & command = record(Opcode::BindFramebuffer);
+    command.enums[0] = target;
+    command.name = framebuffer ? framebuffer->id() : 0;
+}
+
+void CommandList::bindTexture(gl::GLenum unit, const globjects::Texture * texture)
+{
+    auto & command = record(Opcode::BindTexture);
+    command.enums[0] = unit;
+    command.enums[1] = texture ? texture->target() : gl::GL_TEXTURE_2D;
+    command.name = texture ? texture->id() : 0;
+}
+
+void CommandList::useProgram(const globjects::Program * program)
+{
+    record(Opcode::UseProgram).name = program ? program->id() : 0;
+}
+
+void CommandList::clear(gl::ClearBufferMask mask)
+{
+    record(Opcode::Clear).arguments[0] = static_cast<gl::GLint>(mask);
+}
+
+void CommandList::bindVertexArray(const globjects::VertexArray * vertexArray)
+{
+    record(Opcode::BindVertexArray).name = vertexArray ? vertexArray->id() : 0;
+}
+
+void CommandList::uniform(gl::GLint location, gl::GLint value)
+{
+    auto & command = record(Opcode::Uniform1i);
+    command.arguments[0] = location;
+    command.arguments[1] = value;
+}
+
+void CommandList::uniform(gl::GLint location, gl::GLfloat value)
+{
+    recordFloats(Opcode::Uniform1f, location, &value, 1);
+}
+
+void CommandList::uniform(gl::GLint location, const glm::vec2 & value)
+{
+    recordFloats(Opcode::Uniform2f, location, glm::value_ptr(value), 2);
+}
+
+void CommandList::uniform(gl::GLint location, const glm::vec3 & value)
+{
+    recordFloats(Opcode::Uniform3f, location, glm::value_ptr(value), 3);
+}
+
+void CommandList::uniform(gl::GLint location, const glm::vec4 & value)
+{
+    recordFloats(Opcode::Uniform4f, location, glm::value_ptr(value), 4);
+}
+
+void CommandList::uniform(gl::GLint location, const glm::mat4 & value)
+{
+    recordFloats(Opcode::UniformMatrix4f, location, glm::value_ptr(value), 16);
+}
+
+void CommandList::drawArrays(gl::GLenum mode, gl::GLint first, gl::GLsizei count)
+{
+    auto & command = record(Opcode::DrawArrays);
+    command.enums[0] = mode;
+    command.arguments[0] = first;
+    command.arguments[1] = count;
+}
+
+void CommandList::drawElements(gl::GLenum mode, gl::GLsizei count, gl::GLenum type, std::size_t offset)
+{
+    auto & command = record(Opcode::DrawElements);
+    command.enums[0] = mode;
+    command.enums[1] = type;
+    command.arguments[0] = count;
+    command.offset = offset;
+}
+
+void CommandList::replay(StateCache & stateCache) const
+{
+    for (const auto & command : m_commands)
+    {
+        const auto values = m_floats.data() + command.offset;
+
+        switch (command.opcode)
+        {
+        case Opcode::Enable:
+            stateCache.enable(command.enums[0]);
+            break;
+        case Opcode::Disable:
+            stateCache.disable(command.enums[0]);
+            break;
+        case Opcode::Viewport:
+            stateCache.viewport(command.arguments[0], command.arguments[1], command.arguments[2], command.arguments[3]);
+            break;
+        case Opcode::ClearColor:
+            stateCache.clearColor(values[0], values[1], values[2], values[3]);
+            break;
+        case Opcode::DepthMask:
+            stateCache.depthMask(command.arguments[0] != 0);
+            break;
+        case Opcode::BindFramebuffer:
+            stateCache.bindFramebuffer(command.enums[0], command.name);
+            break;
+        case Opcode::BindTexture:
+            stateCache.bindTexture(command.enums[0], command.enums[1], command.name);
+            break;
+        case Opcode::UseProgram:
+            stateCache.useProgram(command.name);
+            break;
+        case Opcode::Clear:
+            m_functions.clear(static_cast<gl::ClearBufferMask>(command.arguments[0]));
+            break;
+        case Opcode::BindVertexArray:
+            m_functions.bindVertexArray(command.name);
+            break;
+        case Opcode::Uniform1i:
+            m_functions.uniform1i(command.arguments[0], command.arguments[1]);
+            break;
+        case Opcode::Uniform1f:
+            m_functions.uniform1fv(command.arguments[0], 1, values);
+            break;
+        case Opcode::Uniform2f:
+            m_functions.uniform2fv(command.arguments[0], 1, values);
+            break;
+        case Opcode::Uniform3f:
+            m_functions.uniform3fv(command.arguments[0], 1, values);
+            break;
+        case Opcode::Uniform4f:
+            m_functions.uniform4fv(command.arguments[0], 1, values);
+            break;
+        case Opcode::UniformMatrix4f:
+            m_functions.uniformMatrix4fv(command.arguments[0], 1, gl::GL_FALSE, values);
+            break;
+        case Opcode::DrawArrays:
+            m_functions.drawArrays(command.enums[0], command.arguments[0], command.arguments[1]);
+            break;
+        case Opcode::DrawElements:
+            m_functions.drawElements(command.enums[0], command.arguments[0], command.enums[1], reinterpret_cast<const void *>(command.offset));
+            break;
+        }
+    }
+}
+
+void CommandList::reset()
+{
+    m_commands.clear();
+    m_floats.clear();
+}
+
+bool CommandList::empty() const
+{
+    return m_commands.empty();
+}
+
+std::size_t CommandList::size() const
+{
+    return m_commands.size();
+}
+
+CommandList::Command & CommandList::record(Opcode opcode)
+{
+    m_commands.push_back(Command());
+
+    auto & command = m_commands.back();
+    command.opcode = opcode;
+    command.enums[0] = gl::GL_NONE;
+    command.enums[1] = gl::GL_NONE;
+    command.name = 0;
+    command.offset = 0;
+
+    return command;
+}
+
+void CommandList::recordFloats(Opcode opcode, gl::GLint location, const gl::GLfloat * values, std::size_t count)
+{
+    auto & command = record(opcode);
+    command.arguments[0] = location;
+    command.offset = m_floats.size();
+
+    m_floats.insert(m_floats.end(), values, values + count);
+}
+
+} // namespace gloperate
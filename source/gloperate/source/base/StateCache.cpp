@@ -0,0 +1,282 @@
+#include <gloperate/base/StateCache.h>
+
+#include <algorithm>
+
+#include <glbinding/gl/enum.h>
+#include <glbinding/gl/boolean.h>
+#include <glbinding/gl/functions.h>
+
+
+namespace gloperate
+{
+
+StateCache::Functions StateCache::glFunctions()
+{
+    Functions functions;
+
+    functions.enable = [](gl::GLenum capability) { gl::glEnable(capability); };
+    functions.disable = [](gl::GLenum capability) { gl::glDisable(capability); };
+    functions.viewport = [](gl::GLint x, gl::GLint y, gl::GLsizei width, gl::GLsizei height) { gl::glViewport(x, y, width, height); };
+    functions.clearColor = [](gl::GLfloat red, gl::GLfloat green, gl::GLfloat blue, gl::GLfloat alpha) { gl::glClearColor(red, green, blue, alpha); };
+    functions.depthMask = [](gl::GLboolean enabled) { gl::glDepthMask(enabled); };
+    functions.bindFramebuffer = [](gl::GLenum target, gl::GLuint framebuffer) { gl::glBindFramebuffer(target, framebuffer); };
+    functions.activeTexture = [](gl::GLenum unit) { gl::glActiveTexture(unit); };
+    functions.bindTexture = [](gl::GLenum target, gl::GLuint texture) { gl::glBindTexture(target, texture); };
+    functions.useProgram = [](gl::GLuint program) { gl::glUseProgram(program); };
+
+    return functions;
+}
+
+StateCache::StateCache()
+:   StateCache(glFunctions())
+{
+}
+
+StateCache::StateCache(const Functions & functions)
+:   m_functions(functions)
+,   m_statistics{0, 0}
+{
+    invalidate();
+}
+
+StateCache::~StateCache()
+{
+}
+
+void StateCache::enable(gl::GLenum capability)
+{
+    setEnabled(capability, true);
+}
+
+void StateCache::disable(gl::GLenum capability)
+{
+    setEnabled(capability, false);
+}
+
+void StateCache::setEnabled(gl::GLenum cap, bool enabled)
+{
+    if (!changes(capability(cap), enabled))
+    {
+        filtered();
+        return;
+    }
+
+    if (enabled)
+        m_functions.enable(cap);
+    else
+        m_functions.disable(cap);
+
+    issued();
+}
+
+void StateCache::viewport(gl::GLint x, gl::GLint y, gl::GLsizei width, gl::GLsizei height)
+{
+    const std::array<gl::GLint, 4> value = {{ x, y, width, height }};
+
+    if (m_viewport.known && m_viewport.value == value)
+    {
+        filtered();
+        return;
+    }
+
+    m_viewport = { true, value };
+    m_functions.viewport(x, y, width, height);
+    issued();
+}
+
+void StateCache::clearColor(gl::GLfloat red, gl::GLfloat green, gl::GLfloat blue, gl::GLfloat alpha)
+{
+    const std::array<gl::GLfloat, 4> value = {{ red, green, blue, alpha }};
+
+    if (m_clearColor.known && m_clearColor.value == value)
+    {
+        filtered();
+        return;
+    }
+
+    m_clearColor = { true, value };
+    m_functions.clearColor(red, green, blue, alpha);
+    issued();
+}
+
+void StateCache::depthMask(bool enabled)
+{
+    if (!changes(m_depthMask, enabled))
+    {
+        filtered();
+        return;
+    }
+
+    m_functions.depthMask(enabled ? gl::GL_TRUE : gl::GL_FALSE);
+    issued();
+}
+
+void StateCache::bindFramebuffer(gl::GLenum target, gl::GLuint framebuffer)
+{
+    const auto draw = target == gl::GL_FRAMEBUFFER || target == gl::GL_DRAW_FRAMEBUFFER;
+    const auto read = target == gl::GL_FRAMEBUFFER || target == gl::GL_READ_FRAMEBUFFER;
+
+    const auto drawBound = !draw || (m_drawFramebuffer.known && m_drawFramebuffer.value == framebuffer);
+    const auto readBound = !read || (m_readFramebuffer.known && m_readFramebuffer.value == framebuffer);
+
+    if (drawBound && readBound)
+    {
+        filtered();
+        return;
+    }
+
+    if (draw)
+        m_drawFramebuffer = { true, framebuffer };
+
+    if (read)
+        m_readFramebuffer = { true, framebuffer };
+
+    m_functions.bindFramebuffer(target, framebuffer);
+    issued();
+}
+
+void StateCache::activeTexture(gl::GLenum unit)
+{
+    if (m_activeTexture.known && m_activeTexture.value == unit)
+    {
+        filtered();
+        return;
+    }
+
+    m_activeTexture = { true, unit };
+    m_functions.activeTexture(unit);
+    issued();
+}
+
+void StateCache::bindTexture(gl::GLenum target, gl::GLuint texture)
+{
+    // The binding cannot be shadowed without knowing the unit it belongs to
+    if (!m_activeTexture.known)
+    {
+        m_functions.bindTexture(target, texture);
+        issued();
+        return;
+    }
+
+    const auto unit = m_activeTexture.value;
+
+    auto it = std::find_if(m_textureBindings.begin(), m_textureBindings.end(), [unit, target](const TextureBinding & binding)
+    {
+        return binding.unit == unit && binding.target == target;
+    });
+
+    if (it != m_textureBindings.end() && it->texture == texture)
+    {
+        filtered();
+        return;
+    }
+
+    if (it != m_textureBindings.end())
+        it->texture = texture;
+    else
+        m_textureBindings.push_back({ unit, target, texture });
+
+    m_functions.bindTexture(target, texture);
+    issued();
+}
+
+void StateCache::bindTexture(gl::GLenum unit, gl::GLenum target, gl::GLuint texture)
+{
+    const auto it = std::find_if(m_textureBindings.begin(), m_textureBindings.end(), [unit, target](const TextureBinding & binding)
+    {
+        return binding.unit == unit && binding.target == target;
+    });
+
+    // Switching the unit is only necessary if the binding changes
+    if (it != m_textureBindings.end() && it->texture == texture)
+    {
+        filtered();
+        return;
+    }
+
+    activeTexture(unit);
+    bindTexture(target, texture);
+}
+
+void StateCache::useProgram(gl::GLuint program)
+{
+    if (m_program.known && m_program.value == program)
+    {
+        filtered();
+        return;
+    }
+
+    m_program = { true, program };
+    m_functions.useProgram(program);
+    issued();
+}
+
+void StateCache::invalidate()
+{
+    for (auto & entry : m_capabilities)
+    {
+        entry.second.known = false;
+    }
+
+    m_textureBindings.clear();
+
+    m_viewport.known = false;
+    m_clearColor.known = false;
+    m_depthMask.known = false;
+    m_drawFramebuffer.known = false;
+    m_readFramebuffer.known = false;
+    m_activeTexture.known = false;
+    m_program.known = false;
+}
+
+void StateCache::invalidateTextures()
+{
+    m_textureBindings.clear();
+}
+
+void StateCache::beginFrame()
+{
+    invalidate();
+
+    m_statistics = { 0, 0 };
+}
+
+const StateCache::Statistics & StateCache::statistics() const
+{
+    return m_statistics;
+}
+
+bool StateCache::changes(Shadowed<bool> & state, bool value)
+{
+    if (state.known && state.value == value)
+        return false;
+
+    state = { true, value };
+    return true;
+}
+
+StateCache::Shadowed<bool> & StateCache::capability(gl::GLenum capability)
+{
+    auto it = std::find_if(m_capabilities.begin(), m_capabilities.end(), [capability](const std::pair<gl::GLenum, Shadowed<bool>> & entry)
+    {
+        return entry.first == capability;
+    });
+
+    if (it != m_capabilities.end())
+        return it->second;
+
+    m_capabilities.push_back({ capability, { false, false } });
+    return m_capabilities.back().second;
+}
+
+void StateCache::issued()
+{
+    ++m_statistics.issued;
+}
+
+void StateCache::filtered()
+{
+    ++m_statistics.filtered;
+}
+
+} // namespace gloperate
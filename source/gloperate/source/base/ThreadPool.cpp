@@ -0,0 +1,142 @@
+#include <gloperate/base/ThreadPool.h>
+
+#include <cassert>
+
+
+namespace gloperate
+{
+
+ThreadPool::ThreadPool(unsigned int numThreads)
+:   m_numPending(0)
+,   m_nextQueue(0)
+,   m_stop(false)
+{
+    assert(numThreads > 0);
+
+    for (unsigned int i = 0; i < numThreads; ++i)
+    {
+        m_queues.emplace_back(new Queue);
+    }
+
+    for (unsigned int i = 0; i < numThreads; ++i)
+    {
+        m_threads.emplace_back(&ThreadPool::work, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+
+    m_condition.notify_all();
+
+    for (auto & thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+unsigned int ThreadPool::numThreads() const
+{
+    return static_cast<unsigned int>(m_threads.size());
+}
+
+void ThreadPool::submit(Task task)
+{
+    const auto index = m_nextQueue++ % m_queues.size();
+
+    {
+        // Pair the counter update with the wait predicate in work() to avoid lost wake-ups
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_numPending;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+        m_queues[index]->tasks.push_back(std::move(task));
+    }
+
+    m_condition.notify_one();
+}
+
+bool ThreadPool::runPendingTask()
+{
+    Task task;
+
+    if (!stealTask(static_cast<unsigned int>(m_queues.size()), task))
+        return false;
+
+    task();
+
+    return true;
+}
+
+void ThreadPool::work(unsigned int index)
+{
+    while (true)
+    {
+        Task task;
+
+        if (popTask(index, task) || stealTask(index, task))
+        {
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this]() { return m_stop || m_numPending > 0; });
+
+        if (m_stop)
+            return;
+    }
+}
+
+bool ThreadPool::popTask(unsigned int index, Task & task)
+{
+    Queue & queue = *m_queues[index];
+
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.tasks.empty())
+        return false;
+
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    --m_numPending;
+
+    return true;
+}
+
+bool ThreadPool::stealTask(unsigned int index, Task & task)
+{
+    const auto numQueues = static_cast<unsigned int>(m_queues.size());
+
+    for (unsigned int offset = 1; offset <= numQueues; ++offset)
+    {
+        const auto victim = (index + offset) % numQueues;
+
+        if (victim == index)
+            continue;
+
+        Queue & queue = *m_queues[victim];
+
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (queue.tasks.empty())
+            continue;
+
+        // Steal from the opposite end the owner pops from
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        --m_numPending;
+
+        return true;
+    }
+
+    return false;
+}
+
+} // namespace gloperate
@@ -0,0 +1,23 @@
+
+#include <gloperate/painter/AbstractProgressiveCapability.h>
+
+
+namespace gloperate
+{
+
+
+AbstractProgressiveCapability::AbstractProgressiveCapability()
+{
+}
+
+AbstractProgressiveCapability::~AbstractProgressiveCapability()
+{
+}
+
+bool AbstractProgressiveCapability::isConverged() const
+{
+    return frameIndex() >= numFrames();
+}
+
+
+} // namespace gloperate
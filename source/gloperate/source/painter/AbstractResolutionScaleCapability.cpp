@@ -0,0 +1,18 @@
+
+#include <gloperate/painter/AbstractResolutionScaleCapability.h>
+
+
+namespace gloperate
+{
+
+
+AbstractResolutionScaleCapability::AbstractResolutionScaleCapability()
+{
+}
+
+AbstractResolutionScaleCapability::~AbstractResolutionScaleCapability()
+{
+}
+
+
+} // namespace gloperate
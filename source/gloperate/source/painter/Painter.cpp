@@ -1,6 +1,36 @@
 
 #include <gloperate/painter/Painter.h>
 
+#include <gloperate/painter/AbstractCameraCapability.h>
+#include <gloperate/painter/AbstractInputCapability.h>
+#include <gloperate/painter/AbstractMetaInformationCapability.h>
+#include <gloperate/painter/AbstractOrthographicProjectionCapability.h>
+#include <gloperate/painter/AbstractOutputCapability.h>
+#include <gloperate/painter/AbstractPerspectiveProjectionCapability.h>
+#include <gloperate/painter/AbstractProgressiveCapability.h>
+#include <gloperate/painter/AbstractProjectionCapability.h>
+#include <gloperate/painter/AbstractResolutionScaleCapability.h>
+#include <gloperate/painter/AbstractTargetFramebufferCapability.h>
+#include <gloperate/painter/AbstractTypedRenderTargetCapability.h>
+#include <gloperate/painter/AbstractViewportCapability.h>
+#include <gloperate/painter/AbstractVirtualTimeCapability.h>
+
+
+namespace
+{
+
+template <typename Interface>
+void resolve(std::unordered_map<std::type_index, void *> & registry, gloperate::AbstractCapability * capability)
+{
+    auto & entry = registry[typeid(Interface)];
+
+    // Like the search, the first capability implementing the interface answers its lookups
+    if (!entry)
+        entry = dynamic_cast<Interface *>(capability);
+}
+
+} // namespace
+
 
 namespace gloperate
 {
@@ -30,10 +60,31 @@ void Painter::paint()
     onPaint();
 }
 
+const std::vector<AbstractCapability *> & Painter::capabilities() const
+{
+    return m_capabilities;
+}
+
 AbstractCapability * Painter::addCapability(AbstractCapability * capability)
 {
     m_capabilities.push_back(capability);
 
+    // Lookups of the interfaces only read the registry then, also from multiple threads
+    resolve<AbstractCapability>(m_capabilityRegistry, capability);
+    resolve<AbstractCameraCapability>(m_capabilityRegistry, capability);
+    resolve<AbstractInputCapability>(m_capabilityRegistry, capability);
+    resolve<AbstractMetaInformationCapability>(m_capabilityRegistry, capability);
+    resolve<AbstractOrthographicProjectionCapability>(m_capabilityRegistry, capability);
+    resolve<AbstractOutputCapability>(m_capabilityRegistry, capability);
+    resolve<AbstractPerspectiveProjectionCapability>(m_capabilityRegistry, capability);
+    resolve<AbstractProgressiveCapability>(m_capabilityRegistry, capability);
+    resolve<AbstractProjectionCapability>(m_capabilityRegistry, capability);
+    resolve<AbstractResolutionScaleCapability>(m_capabilityRegistry, capability);
+    resolve<AbstractTargetFramebufferCapability>(m_capabilityRegistry, capability);
+    resolve<AbstractTypedRenderTargetCapability>(m_capabilityRegistry, capability);
+    resolve<AbstractViewportCapability>(m_capabilityRegistry, capability);
+    resolve<AbstractVirtualTimeCapability>(m_capabilityRegistry, capability);
+
     return capability;
 }
 
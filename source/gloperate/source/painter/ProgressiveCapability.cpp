@@ -0,0 +1,43 @@
+
+#include <gloperate/painter/ProgressiveCapability.h>
+
+
+namespace gloperate
+{
+
+
+ProgressiveCapability::ProgressiveCapability(unsigned int numFrames)
+: m_frameIndex(0)
+, m_numFrames(numFrames)
+{
+}
+
+ProgressiveCapability::~ProgressiveCapability()
+{
+}
+
+unsigned int ProgressiveCapability::frameIndex() const
+{
+    return m_frameIndex;
+}
+
+void ProgressiveCapability::setFrameIndex(unsigned int frameIndex)
+{
+    m_frameIndex = frameIndex;
+}
+
+unsigned int ProgressiveCapability::numFrames() const
+{
+    return m_numFrames;
+}
+
+void ProgressiveCapability::setNumFrames(unsigned int numFrames)
+{
+    m_numFrames = numFrames;
+
+    // A converged image may have to be refined further
+    setChanged(true);
+}
+
+
+} // namespace gloperate
@@ -0,0 +1,46 @@
+
+#include <gloperate/painter/ResolutionScaleCapability.h>
+
+#include <algorithm>
+#include <cassert>
+
+
+namespace gloperate
+{
+
+
+ResolutionScaleCapability::ResolutionScaleCapability(float minimumScale)
+: m_scale(1.0f)
+, m_minimumScale(minimumScale)
+{
+    assert(minimumScale > 0.0f && minimumScale <= 1.0f);
+}
+
+ResolutionScaleCapability::~ResolutionScaleCapability()
+{
+}
+
+float ResolutionScaleCapability::scale() const
+{
+    return m_scale;
+}
+
+void ResolutionScaleCapability::setScale(float scale)
+{
+    scale = std::min(std::max(scale, m_minimumScale), 1.0f);
+
+    if (scale == m_scale)
+        return;
+
+    m_scale = scale;
+
+    setChanged(true);
+}
+
+float ResolutionScaleCapability::minimumScale() const
+{
+    return m_minimumScale;
+}
+
+
+} // namespace gloperate
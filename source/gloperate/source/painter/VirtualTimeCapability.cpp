@@ -1,18 +1,23 @@
 
 #include <gloperate/painter/VirtualTimeCapability.h>
 
+#include <algorithm>
 #include <cassert>
 
 
 namespace gloperate
 {
 
+const unsigned int VirtualTimeCapability::maxSteps;
 
 VirtualTimeCapability::VirtualTimeCapability()
 : m_enabled(true)
 , m_duration(2.0f * 3.141592654f)
 , m_time(0.0f)
 , m_delta(0.0f)
+, m_fixedStep(0.0f)
+, m_accumulator(0.0f)
+, m_steps(0)
 {
 }
 
@@ -51,14 +56,73 @@ void VirtualTimeCapability::setLoopDuration(float duration)
     normalizeTime();
 }
 
+float VirtualTimeCapability::fixedStep() const
+{
+    return m_fixedStep;
+}
+
+void VirtualTimeCapability::setFixedStep(float step)
+{
+    assert(step >= 0.0f);
+
+    m_fixedStep   = step;
+    m_accumulator = 0.0f;
+
+    setChanged(true);
+}
+
+unsigned int VirtualTimeCapability::steps() const
+{
+    return m_steps;
+}
+
+float VirtualTimeCapability::interpolation() const
+{
+    return m_fixedStep > 0.0f ? m_accumulator / m_fixedStep : 0.0f;
+}
+
 void VirtualTimeCapability::update(float delta)
 {
-    m_time  += delta;
-    m_delta  = delta;
+    if (m_fixedStep <= 0.0f)
+    {
+        m_time  += delta;
+        m_delta  = delta;
+        m_steps  = 1;
 
+        setChanged(true);
+
+        normalizeTime();
+
+        return;
+    }
+
+    m_accumulator = std::min(m_accumulator + delta, maxSteps * m_fixedStep);
+    m_delta = 0.0f;
+    m_steps = 0;
+
+    // Time advances in whole steps only, the same on every machine
+    while (m_accumulator >= m_fixedStep)
+    {
+        m_accumulator -= m_fixedStep;
+        m_time  += m_fixedStep;
+        m_delta += m_fixedStep;
+        ++m_steps;
+
+        normalizeTime();
+    }
+
+    // The interpolation factor changed as well
     setChanged(true);
+}
 
-    normalizeTime();
+void VirtualTimeCapability::reset()
+{
+    m_time        = 0.0f;
+    m_delta       = 0.0f;
+    m_accumulator = 0.0f;
+    m_steps       = 0;
+
+    setChanged(true);
 }
 
 void VirtualTimeCapability::normalizeTime()
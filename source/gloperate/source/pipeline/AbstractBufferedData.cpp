@@ -0,0 +1,15 @@
+#include <gloperate/pipeline/AbstractBufferedData.h>
+
+
+namespace gloperate
+{
+
+AbstractBufferedData::AbstractBufferedData()
+{
+}
+
+AbstractBufferedData::~AbstractBufferedData()
+{
+}
+
+} // namespace gloperate
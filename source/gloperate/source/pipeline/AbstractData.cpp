@@ -3,7 +3,24 @@
 #include <algorithm>
 #include <sstream>
 
+#include <gloperate/pipeline/AbstractInputSlot.h>
 #include <gloperate/pipeline/AbstractStage.h>
+#include <gloperate/pipeline/DataSnapshot.h>
+
+
+namespace
+{
+
+struct Transaction
+{
+    unsigned int depth = 0;
+    std::vector<gloperate::AbstractData *> pending;
+    std::vector<gloperate::AbstractStage *> scheduled;
+};
+
+thread_local Transaction t_transaction;
+
+} // namespace
 
 
 namespace gloperate 
@@ -12,11 +29,23 @@ namespace gloperate
 AbstractData::AbstractData(const std::string & name)
 : m_owner(nullptr)
 , m_name(name)
+, m_generation(nextGeneration())
+, m_pendingIn(nullptr)
 {
 }
 
 AbstractData::~AbstractData()
 {
+    if (m_pendingIn)
+    {
+        auto & pending = *m_pendingIn;
+        pending.erase(std::remove(pending.begin(), pending.end(), this), pending.end());
+    }
+
+    for (auto slot : m_consumers)
+    {
+        slot->m_source = nullptr;
+    }
 }
 
 const std::string & AbstractData::name() const
@@ -76,12 +105,176 @@ std::string AbstractData::qualifiedName() const
 
 void AbstractData::invalidate()
 {
+    m_generation.store(nextGeneration(), std::memory_order_release);
+
+    if (auto pending = openTransaction())
+    {
+        if (!m_pendingIn)
+        {
+            m_pendingIn = pending;
+            pending->push_back(this);
+        }
+
+        return;
+    }
+
+    notifyInvalidated();
+}
+
+std::vector<AbstractData *> * AbstractData::openTransaction() const
+{
+    if (t_transaction.depth > 0)
+        return &t_transaction.pending;
+
+    // Data consumed by several pipelines is deferred if one of them is in a transaction
+    for (auto slot : m_consumers)
+    {
+        auto scope = slot->owner() ? slot->owner()->transactionScope() : nullptr;
+
+        if (scope && scope->isActive())
+            return &scope->notifications.invalidated;
+    }
+
+    return nullptr;
+}
+
+void AbstractData::notifyInvalidated()
+{
+    for (auto slot : m_consumers)
+    {
+        slot->scheduleStages();
+    }
+
     invalidated();
 }
 
+std::uint64_t AbstractData::generation() const
+{
+    return m_generation.load(std::memory_order_acquire);
+}
+
+void AbstractData::addConsumer(AbstractInputSlot * slot) const
+{
+    if (std::find(m_consumers.begin(), m_consumers.end(), slot) == m_consumers.end())
+        m_consumers.push_back(slot);
+}
+
+void AbstractData::removeConsumer(AbstractInputSlot * slot) const
+{
+    m_consumers.erase(std::remove(m_consumers.begin(), m_consumers.end(), slot), m_consumers.end());
+}
+
+std::uint64_t AbstractData::nextGeneration()
+{
+    static std::atomic<std::uint64_t> s_generation(1);
+
+    return s_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AbstractData::beginTransaction()
+{
+    ++t_transaction.depth;
+}
+
+void AbstractData::commitTransaction()
+{
+    if (t_transaction.depth == 0 || --t_transaction.depth > 0)
+        return;
+
+    // Observers may invalidate again while being notified, which is delivered right away
+    std::vector<AbstractData *> pending;
+    std::vector<AbstractStage *> scheduled;
+    std::swap(pending, t_transaction.pending);
+    std::swap(scheduled, t_transaction.scheduled);
+
+    deliver(pending, scheduled);
+}
+
+bool AbstractData::deferSchedule(AbstractStage * stage)
+{
+    if (t_transaction.depth > 0)
+    {
+        t_transaction.scheduled.push_back(stage);
+        return true;
+    }
+
+    auto scope = stage->transactionScope();
+
+    if (scope && scope->isActive())
+    {
+        scope->notifications.scheduled.push_back(stage);
+        return true;
+    }
+
+    return false;
+}
+
+void AbstractData::detachTransaction(std::vector<AbstractData *> & invalidated, std::vector<AbstractStage *> & scheduled)
+{
+    if (t_transaction.depth == 0 || --t_transaction.depth > 0)
+        return;
+
+    invalidated.insert(invalidated.end(), t_transaction.pending.begin(), t_transaction.pending.end());
+    scheduled.insert(scheduled.end(), t_transaction.scheduled.begin(), t_transaction.scheduled.end());
+
+    t_transaction.pending.clear();
+    t_transaction.scheduled.clear();
+}
+
+void AbstractData::deliver(std::vector<AbstractData *> & invalidated, std::vector<AbstractStage *> & scheduled)
+{
+    for (auto data : invalidated)
+    {
+        data->m_pendingIn = nullptr;
+    }
+
+    for (auto data : invalidated)
+    {
+        data->notifyInvalidated();
+    }
+
+    for (auto stage : scheduled)
+    {
+        stage->processScheduled();
+    }
+
+    invalidated.clear();
+    scheduled.clear();
+}
+
+bool AbstractData::isTransactionActive()
+{
+    return t_transaction.depth > 0;
+}
+
 bool AbstractData::matchesName(const std::string & name) const
 {
     return this->name() == name;
 }
 
+const std::vector<AbstractInputSlot *> & AbstractData::consumers() const
+{
+    return m_consumers;
+}
+
+bool AbstractData::hashValue(std::size_t &) const
+{
+    return false;
+}
+
+bool AbstractData::equals(const AbstractDataSnapshot &) const
+{
+    return false;
+}
+
+std::unique_ptr<AbstractDataSnapshot> AbstractData::snapshot() const
+{
+    return nullptr;
+}
+
+bool AbstractData::restore(const AbstractDataSnapshot &)
+{
+    return false;
+}
+
 } // namespace gloperate
@@ -4,6 +4,16 @@
 #include <algorithm>
 
 #include <gloperate/pipeline/AbstractStage.h>
+#include <gloperate/pipeline/AbstractData.h>
+
+
+namespace
+{
+
+// Differs from every generation, including 0 for unconnected slots
+const std::uint64_t s_unprocessed = ~std::uint64_t(0);
+
+} // namespace
 
 
 namespace gloperate 
@@ -12,7 +22,8 @@ namespace gloperate
 AbstractInputSlot::AbstractInputSlot(const std::string & name)
 : m_owner(nullptr)
 , m_name(name)
-, m_hasChanged(true)
+, m_source(nullptr)
+, m_processedGeneration(s_unprocessed)
 , m_isOptional(false)
 , m_isFeedback(false)
 {
@@ -20,6 +31,7 @@ AbstractInputSlot::AbstractInputSlot(const std::string & name)
 
 AbstractInputSlot::~AbstractInputSlot()
 {
+    attach(nullptr);
 }
 
 const std::string & AbstractInputSlot::name() const
@@ -84,17 +96,56 @@ bool AbstractInputSlot::isUsable() const
 
 bool AbstractInputSlot::hasChanged() const
 {
-    return m_hasChanged;
+    return generation() != m_processedGeneration;
+}
+
+std::uint64_t AbstractInputSlot::generation() const
+{
+    const AbstractData * data = connectedData();
+
+    return data ? data->generation() : 0;
+}
+
+std::uint64_t AbstractInputSlot::processedGeneration() const
+{
+    return m_processedGeneration;
 }
 
 void AbstractInputSlot::changed()
 {
-    m_hasChanged = true;
+    m_processedGeneration = s_unprocessed;
+
+    scheduleStages();
 }
 
 void AbstractInputSlot::processed()
 {
-    m_hasChanged = false;
+    m_processedGeneration = generation();
+}
+
+void AbstractInputSlot::attach(const AbstractData * data)
+{
+    if (m_source == data)
+        return;
+
+    if (m_source)
+        m_source->removeConsumer(this);
+
+    m_source = data;
+
+    if (m_source)
+        m_source->addConsumer(this);
+}
+
+void AbstractInputSlot::scheduleStages()
+{
+    // Notifications delivered late, e.g., from a frame-ahead execution, may refer to a
+    // generation the owner has processed already
+    if (m_owner && hasChanged())
+        m_owner->scheduleProcess();
+
+    for (auto stage : m_sharingStages)
+        stage->scheduleProcess();
 }
 
 bool AbstractInputSlot::isOptional() const
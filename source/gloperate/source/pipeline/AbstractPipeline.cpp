@@ -3,21 +3,45 @@
 #include <cassert>
 #include <string>
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <set>
 #include <iostream>
+#include <thread>
 
 #include <gloperate/base/collection.hpp>
+#include <gloperate/base/ThreadPool.h>
 
 #include <gloperate/pipeline/AbstractStage.h>
 #include <gloperate/pipeline/AbstractInputSlot.h>
 #include <gloperate/pipeline/AbstractData.h>
-#include <gloperate/pipeline/AbstractData.h>
+#include <gloperate/pipeline/AbstractBufferedData.h>
 #include <gloperate/pipeline/Data.h>
+#include <gloperate/pipeline/FusibleStage.h>
+#include <gloperate/pipeline/InvalidationTransaction.h>
+#include <gloperate/pipeline/PipelineProfiler.h>
 
 
 using namespace collection;
 
 
+namespace
+{
+
+struct LaterPosition
+{
+    const std::vector<std::size_t> & positions;
+
+    bool operator()(std::size_t lhs, std::size_t rhs) const
+    {
+        return positions[lhs] > positions[rhs];
+    }
+};
+
+} // namespace
+
+
 namespace gloperate
 {
 
@@ -25,11 +49,32 @@ AbstractPipeline::AbstractPipeline(const std::string & name)
 :   m_initialized(false)
 ,   m_name(name)
 ,   m_dependenciesSorted(false)
+,   m_workerCount(1)
+,   m_executing(false)
+,   m_currentPosition(0)
+,   m_visitedStages(0)
+,   m_processedStages(0)
+,   m_demandDriven(false)
+,   m_demandComputed(false)
+,   m_fusionEnabled(true)
+,   m_fusionComputed(false)
+,   m_framePipelining(false)
+,   m_frameAheadRunning(false)
+,   m_frameAheadSubmitted(false)
 {
 }
 
 AbstractPipeline::~AbstractPipeline()
 {
+    synchronize();
+
+    // Pending data refers to the transaction
+    if (isTransactionActive())
+    {
+        m_transaction.depth = 1;
+        commitTransaction();
+    }
+
     for (auto & stage : m_stages)
     {
         delete stage;
@@ -69,8 +114,90 @@ std::string AbstractPipeline::asPrintable() const
 
 void AbstractPipeline::addStage(AbstractStage * stage)
 {
-    stage->dependenciesChanged.connect([this]() { m_dependenciesSorted = false; });
+    const auto index = registerStage(stage);
+
+    stage->dependenciesChanged.connect([this, stage, index]()
+    {
+        if (m_graph.updateStage(stage))
+            m_dependenciesSorted = false;
+
+        m_demandComputed = false;
+        m_fusionComputed = false;
+        m_transientResources.invalidatePlan();
+
+        // A stage skipped for unconnected inputs may be executable now
+        if (stage->isProcessScheduled())
+            scheduleStage(index);
+    });
+
+    stage->processScheduled.connect([this, index]()
+    {
+        scheduleStage(index);
+    });
+
+    scheduleStage(index);
+}
+
+std::size_t AbstractPipeline::registerStage(AbstractStage * stage)
+{
+    synchronize();
+
+    const auto index = m_graph.size();
+
+    stage->setOutputCache(&m_outputCache);
+    stage->setTransientResourcePool(&m_transientResources);
+    stage->setStateCache(&m_stateCache);
+    stage->setBackgroundWorkers(&m_backgroundWorkers);
+    stage->setTransactionScope(&m_transaction);
+
     m_stages.push_back(stage);
+    m_graph.addStage(stage);
+    m_levels.push_back(0);
+    m_positions.push_back(index);
+    m_frameAhead.push_back(false);
+    m_demanded.push_back(false);
+    m_dependenciesSorted = false;
+    m_demandComputed = false;
+    m_fusionComputed = false;
+    m_transientResources.invalidatePlan();
+
+    if (m_profiler)
+        m_profiler->addStage(stage);
+
+    {
+        std::lock_guard<std::mutex> lock(m_worklistMutex);
+        m_scheduled.push_back(false);
+    }
+
+    return index;
+}
+
+void AbstractPipeline::beginTransaction()
+{
+    // Published before the depth, threads that see the transaction open compare the right id
+    if (m_transaction.depth == 0)
+        m_transaction.thread = std::this_thread::get_id();
+
+    ++m_transaction.depth;
+}
+
+void AbstractPipeline::commitTransaction()
+{
+    assert(m_transaction.depth == 0 || m_transaction.thread == std::this_thread::get_id());
+
+    if (m_transaction.depth == 0 || --m_transaction.depth > 0)
+        return;
+
+    // Observers may invalidate again while being notified, which is delivered right away
+    InvalidationTransaction::Notifications notifications;
+    std::swap(notifications, m_transaction.notifications);
+
+    InvalidationTransaction::deliver(notifications);
+}
+
+bool AbstractPipeline::isTransactionActive() const
+{
+    return m_transaction.depth > 0;
 }
 
 void AbstractPipeline::addParameter(AbstractData * parameter)
@@ -101,6 +228,11 @@ const std::vector<AbstractStage *> & AbstractPipeline::stages() const
     return m_stages;
 }
 
+const StageGraph & AbstractPipeline::stageGraph() const
+{
+    return m_graph;
+}
+
 const std::vector<AbstractData *> & AbstractPipeline::parameters() const
 {
     return m_parameters;
@@ -133,12 +265,691 @@ void AbstractPipeline::execute()
         return;
     }
 
-    for (auto & stage: m_stages)
+    // Stages would not see the invalidations of their predecessors until the commit
+    if (isTransactionActive() || InvalidationTransaction::isActive())
+    {
+        std::cerr << "Pipeline " << asPrintable() << " is not executed within an invalidation transaction" << std::endl;
+        return;
+    }
+
+    // Results of background jobs schedule their stages for this execution
+    m_backgroundWorkers.runPosted();
+
+    if (!m_dependenciesSorted)
+    {
+        sortDependencies();
+    }
+
+    m_visitedStages = 0;
+    m_processedStages = 0;
+
+    if (m_demandDriven && !m_demandComputed)
+    {
+        computeDemand();
+    }
+
+    if (!m_fusionComputed)
+    {
+        computeFusion();
+    }
+
+    if (!m_transientResources.isPlanned())
+    {
+        m_transientResources.plan(m_graph, m_positions);
+    }
+
+    // Painters and other pipelines may have changed the state since the last execution;
+    // begin the frame before frame-ahead commands are replayed onto it
+    m_stateCache.beginFrame();
+
+    if (m_framePipelining)
+    {
+        beginFrameAhead();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_worklistMutex);
+
+        // Stages that were scheduled for this execution while the last one was running
+        for (auto index : m_deferred)
+        {
+            m_worklist.push_back(index);
+            std::push_heap(m_worklist.begin(), m_worklist.end(), LaterPosition{m_positions});
+        }
+
+        m_deferred.clear();
+    }
+
+    if (m_profiler)
+        m_profiler->beginFrame();
+
+    if (m_threadPool)
+    {
+        executeParallel();
+    }
+    else
+    {
+        executeSequential();
+    }
+
+    if (m_profiler)
+        m_profiler->endFrame();
+
+    std::lock_guard<std::mutex> lock(m_worklistMutex);
+    m_executing = false;
+}
+
+std::size_t AbstractPipeline::visitedStageCount() const
+{
+    return m_visitedStages;
+}
+
+std::size_t AbstractPipeline::processedStageCount() const
+{
+    return m_processedStages;
+}
+
+bool AbstractPipeline::isProfilingEnabled() const
+{
+    return m_profiler != nullptr;
+}
+
+void AbstractPipeline::setProfilingEnabled(bool enabled)
+{
+    if (enabled == isProfilingEnabled())
+        return;
+
+    if (!enabled)
+    {
+        m_profiler.reset();
+        return;
+    }
+
+    m_profiler.reset(new PipelineProfiler);
+
+    for (std::size_t index = 0; index < m_graph.size(); ++index)
+    {
+        m_profiler->addStage(m_graph.stage(index));
+    }
+}
+
+OutputCache & AbstractPipeline::outputCache()
+{
+    return m_outputCache;
+}
+
+const OutputCache & AbstractPipeline::outputCache() const
+{
+    return m_outputCache;
+}
+
+TransientResourcePool & AbstractPipeline::transientResources()
+{
+    return m_transientResources;
+}
+
+const TransientResourcePool & AbstractPipeline::transientResources() const
+{
+    return m_transientResources;
+}
+
+StateCache & AbstractPipeline::stateCache()
+{
+    return m_stateCache;
+}
+
+const StateCache & AbstractPipeline::stateCache() const
+{
+    return m_stateCache;
+}
+
+BackgroundWorkers & AbstractPipeline::backgroundWorkers()
+{
+    return m_backgroundWorkers;
+}
+
+const BackgroundWorkers & AbstractPipeline::backgroundWorkers() const
+{
+    return m_backgroundWorkers;
+}
+
+PipelineProfiler * AbstractPipeline::profiler()
+{
+    return m_profiler.get();
+}
+
+const PipelineProfiler * AbstractPipeline::profiler() const
+{
+    return m_profiler.get();
+}
+
+void AbstractPipeline::executeSequential()
+{
+    // Processing a stage may schedule its successors, which are popped later on
+    while (popScheduledStages(false))
+    {
+        ++m_visitedStages;
+
+        if (executeStage(m_batch.front()))
+            ++m_processedStages;
+
+        replayStage(m_batch.front());
+    }
+}
+
+void AbstractPipeline::executeParallel()
+{
+    std::mutex mutex;
+    std::condition_variable levelFinished;
+    InvalidationTransaction::Notifications notifications;
+
+    while (popScheduledStages(true))
+    {
+        m_visitedStages += m_batch.size();
+
+        if (m_batch.size() == 1)
+        {
+            if (executeStage(m_batch.front()))
+                ++m_processedStages;
+
+            replayStage(m_batch.front());
+
+            continue;
+        }
+
+        unsigned int numWorkerStages = static_cast<unsigned int>(std::count_if(m_batch.begin(), m_batch.end(), [this](std::size_t index) {
+            return m_graph.stage(index)->threadAffinity() == AbstractStage::ThreadAffinity::AnyThread;
+        }));
+
+        std::atomic<unsigned int> numRemaining(numWorkerStages);
+        std::atomic<std::size_t> numProcessed(0);
+
+        for (auto index : m_batch)
+        {
+            if (m_graph.stage(index)->threadAffinity() != AbstractStage::ThreadAffinity::AnyThread)
+                continue;
+
+            m_threadPool->submit([this, index, &numRemaining, &numProcessed, &mutex, &levelFinished, &notifications]()
+            {
+                // Observers and signal connections are not thread-safe, so notifications are recorded
+                InvalidationTransaction::begin();
+
+                if (executeStage(index))
+                    ++numProcessed;
+
+                std::lock_guard<std::mutex> lock(mutex);
+                InvalidationTransaction::detach(notifications);
+
+                if (--numRemaining == 0)
+                    levelFinished.notify_all();
+            });
+        }
+
+        // Stages bound to the context stay on the calling thread
+        for (auto index : m_batch)
+        {
+            if (m_graph.stage(index)->threadAffinity() == AbstractStage::ThreadAffinity::ContextThread && executeStage(index))
+                ++numProcessed;
+        }
+
+        // Help the workers instead of idling until the level is done
+        while (numRemaining > 0 && m_threadPool->runPendingTask())
+        {
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        levelFinished.wait(lock, [&numRemaining]() { return numRemaining == 0; });
+
+        m_processedStages += numProcessed;
+
+        // Schedules the consumers in later levels, on the context thread
+        InvalidationTransaction::deliver(notifications);
+
+        // Commands recorded on workers are issued here, the batch is in pipeline order
+        for (auto index : m_batch)
+        {
+            replayStage(index);
+        }
+    }
+}
+
+bool AbstractPipeline::executeStage(std::size_t index)
+{
+    auto stage = m_graph.stage(index);
+
+    // Stays scheduled for the next frame-ahead execution, see beginFrameAhead()
+    if (m_framePipelining && m_frameAhead[index])
+        return false;
+
+    // Stays scheduled until a sink depends on it, see computeDemand()
+    if (m_demandDriven && !m_demanded[index])
+        return false;
+
+    if (!m_profiler)
+        return stage->execute();
+
+    m_profiler->beginStage(index, stage->threadAffinity() == AbstractStage::ThreadAffinity::ContextThread);
+    const auto processed = stage->execute();
+    m_profiler->endStage(index, processed);
+
+    return processed;
+}
+
+void AbstractPipeline::replayStage(std::size_t index)
+{
+    // The next frame-ahead execution may be recording into the list, it is replayed
+    // by beginFrameAhead() once that execution has finished
+    if (m_framePipelining && m_frameAhead[index])
+        return;
+
+    m_graph.stage(index)->replayCommands();
+}
+
+bool AbstractPipeline::isFusionEnabled() const
+{
+    return m_fusionEnabled;
+}
+
+void AbstractPipeline::setFusionEnabled(bool enabled)
+{
+    m_fusionEnabled = enabled;
+    m_fusionComputed = false;
+}
+
+void AbstractPipeline::computeFusion()
+{
+    FusibleStage::fuseChains(m_graph.sortedStages(), m_fusionEnabled);
+
+    // Fusing adds and removes transient resources, which resets the flag
+    m_fusionComputed = true;
+}
+
+bool AbstractPipeline::isDemandDriven() const
+{
+    return m_demandDriven;
+}
+
+void AbstractPipeline::setDemandDriven(bool enabled)
+{
+    m_demandDriven = enabled;
+    m_demandComputed = false;
+
+    // Stages skipped so far have to be visited again
+    if (!m_demandDriven)
     {
+        for (std::size_t index = 0; index < m_graph.size(); ++index)
+        {
+            if (m_graph.stage(index)->isProcessScheduled())
+                scheduleStage(index);
+        }
+    }
+}
+
+void AbstractPipeline::addSink(const AbstractData * output)
+{
+    if (std::find(m_sinks.begin(), m_sinks.end(), output) != m_sinks.end())
+        return;
+
+    m_sinks.push_back(output);
+    m_demandComputed = false;
+}
+
+void AbstractPipeline::addSinks(const std::string & name)
+{
+    for (auto output : findOutputs(name))
+    {
+        addSink(output);
+    }
+}
+
+void AbstractPipeline::removeSink(const AbstractData * output)
+{
+    m_sinks.erase(std::remove(m_sinks.begin(), m_sinks.end(), output), m_sinks.end());
+    m_demandComputed = false;
+}
+
+void AbstractPipeline::clearSinks()
+{
+    m_sinks.clear();
+    m_demandComputed = false;
+}
+
+const std::vector<const AbstractData *> & AbstractPipeline::sinks() const
+{
+    return m_sinks;
+}
+
+bool AbstractPipeline::isDemanded(const AbstractStage * stage) const
+{
+    if (!m_demandDriven)
+        return true;
+
+    const auto index = m_graph.indexOf(stage);
+
+    return index != StageGraph::npos && m_demanded[index];
+}
+
+void AbstractPipeline::computeDemand()
+{
+    const auto numStages = m_graph.size();
+
+    std::vector<bool> demanded(numStages, false);
+    std::vector<std::size_t> stack;
+
+    for (auto sink : m_sinks)
+    {
+        const auto index = sink->owner() ? m_graph.indexOf(sink->owner()) : StageGraph::npos;
+
+        if (index == StageGraph::npos || demanded[index])
+            continue;
+
+        demanded[index] = true;
+        stack.push_back(index);
+    }
+
+    while (!stack.empty())
+    {
+        const auto index = stack.back();
+        stack.pop_back();
+
+        for (auto predecessor : m_graph.predecessors(index))
+        {
+            if (demanded[predecessor])
+                continue;
+
+            demanded[predecessor] = true;
+            stack.push_back(predecessor);
+        }
+    }
+
+    for (std::size_t index = 0; index < numStages; ++index)
+    {
+        const auto newlyDemanded = demanded[index] && !m_demanded[index];
+
+        m_demanded[index] = demanded[index];
+
+        // Changes skipped while the stage was not demanded are caught up
+        if (newlyDemanded && m_graph.stage(index)->isProcessScheduled())
+            scheduleStage(index);
+    }
+
+    m_demandComputed = true;
+}
+
+bool AbstractPipeline::isFramePipelining() const
+{
+    return m_framePipelining;
+}
+
+void AbstractPipeline::setFramePipelining(bool enabled)
+{
+    synchronize();
+
+    m_framePipelining = enabled;
+
+    if (!m_framePipelining)
+        m_frameAheadThread.reset();
+
+    if (m_framePipelining && m_dependenciesSorted)
+        computeFrameAhead();
+}
+
+bool AbstractPipeline::isFrameAhead(const AbstractStage * stage) const
+{
+    const auto index = m_graph.indexOf(stage);
+
+    return index != StageGraph::npos && m_frameAhead[index];
+}
+
+void AbstractPipeline::synchronize()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_frameAheadMutex);
+        m_frameAheadFinished.wait(lock, [this]() { return !m_frameAheadRunning; });
+    }
+
+    m_frameAheadSubmitted = false;
+
+    // Schedules the consumers of the background execution, on the context thread
+    InvalidationTransaction::deliver(m_frameAheadNotifications);
+}
+
+void AbstractPipeline::beginFrameAhead()
+{
+    if (m_frameAheadStages.empty())
+        return;
+
+    // The first frame (or every frame without workers) is produced right away
+    if (m_frameAheadSubmitted)
+        synchronize();
+    else
+        executeFrameAhead();
+
+    // Commands recorded one frame ahead are issued before their outputs are consumed
+    for (auto index : m_frameAheadStages)
+    {
+        m_graph.stage(index)->replayCommands();
+    }
+
+    // Invalidates and thereby schedules the consumers for this execution
+    for (auto data : m_frameAheadOutputs)
+    {
+        data->acquire();
+    }
+
+    if (!m_threadPool)
+        return;
+
+    // Not submitted to the workers, as the context thread would run the next frame itself
+    // when it helps them out in executeParallel()
+    if (!m_frameAheadThread)
+        m_frameAheadThread.reset(new ThreadPool(1));
+
+    {
+        std::lock_guard<std::mutex> lock(m_frameAheadMutex);
+        m_frameAheadRunning = true;
+    }
+
+    m_frameAheadSubmitted = true;
+
+    m_frameAheadThread->submit([this]()
+    {
+        // Observers and signal connections are not thread-safe, so notifications are recorded
+        InvalidationTransaction::begin();
+
+        executeFrameAhead();
+
+        std::lock_guard<std::mutex> lock(m_frameAheadMutex);
+        InvalidationTransaction::detach(m_frameAheadNotifications);
+
+        m_frameAheadRunning = false;
+        m_frameAheadFinished.notify_all();
+    });
+}
+
+void AbstractPipeline::executeFrameAhead()
+{
+    // Each stage only processes if it was scheduled, so unchanged stages are skipped
+    for (auto index : m_frameAheadStages)
+    {
+        auto stage = m_graph.stage(index);
+
+        // Invalidations by the preceding frame-ahead stages are only recorded in the background,
+        // the changed generations schedule their consumers right away
+        for (auto input : stage->allInputs())
+        {
+            if (!input->hasChanged())
+                continue;
+
+            stage->scheduleProcess();
+            break;
+        }
+
         stage->execute();
     }
 }
 
+void AbstractPipeline::computeFrameAhead()
+{
+    const auto numStages = m_graph.size();
+
+    for (std::size_t index = 0; index < numStages; ++index)
+    {
+        m_frameAhead[index] = m_graph.stage(index)->threadAffinity() == AbstractStage::ThreadAffinity::AnyThread;
+    }
+
+    // Removing a stage may disqualify its successors (predecessor rule) as well as its predecessors (buffer rule)
+    bool changed = true;
+
+    while (changed)
+    {
+        changed = false;
+
+        for (auto index : m_graph.order())
+        {
+            if (!m_frameAhead[index])
+                continue;
+
+            for (auto predecessor : m_graph.predecessors(index))
+            {
+                if (m_frameAhead[predecessor])
+                    continue;
+
+                m_frameAhead[index] = false;
+                changed = true;
+                break;
+            }
+        }
+
+        for (auto index : m_graph.order())
+        {
+            if (!m_frameAhead[index])
+                continue;
+
+            for (auto successor : m_graph.successors(index))
+            {
+                if (m_frameAhead[successor] || passesOnlyBufferedData(index, successor))
+                    continue;
+
+                m_frameAhead[index] = false;
+                changed = true;
+                break;
+            }
+        }
+    }
+
+    m_frameAheadStages.clear();
+    m_frameAheadOutputs.clear();
+
+    for (auto index : m_graph.order())
+    {
+        if (!m_frameAhead[index])
+            continue;
+
+        m_frameAheadStages.push_back(index);
+
+        for (auto output : m_graph.stage(index)->outputs())
+        {
+            if (auto buffered = dynamic_cast<AbstractBufferedData *>(output))
+                m_frameAheadOutputs.push_back(buffered);
+        }
+    }
+}
+
+bool AbstractPipeline::passesOnlyBufferedData(std::size_t producer, std::size_t consumer) const
+{
+    const auto producerStage = m_graph.stage(producer);
+    bool connected = false;
+
+    for (auto input : m_graph.stage(consumer)->allInputs())
+    {
+        const auto data = input->connectedData();
+
+        if (!data || data->owner() != producerStage)
+            continue;
+
+        if (!dynamic_cast<const AbstractBufferedData *>(data))
+            return false;
+
+        connected = true;
+    }
+
+    // A manual dependency without data cannot be buffered
+    return connected;
+}
+
+void AbstractPipeline::scheduleStage(std::size_t index)
+{
+    std::lock_guard<std::mutex> lock(m_worklistMutex);
+
+    if (m_scheduled[index])
+        return;
+
+    m_scheduled[index] = true;
+
+    // Stages at or before the current position were already passed in this execution
+    if (m_executing && m_positions[index] <= m_currentPosition)
+    {
+        m_deferred.push_back(index);
+        return;
+    }
+
+    m_worklist.push_back(index);
+    std::push_heap(m_worklist.begin(), m_worklist.end(), LaterPosition{m_positions});
+}
+
+bool AbstractPipeline::popScheduledStages(bool wholeLevel)
+{
+    std::lock_guard<std::mutex> lock(m_worklistMutex);
+
+    m_batch.clear();
+
+    if (m_worklist.empty())
+        return false;
+
+    // As m_stages is ordered by level, the stages of a level are popped in a row
+    const auto level = m_levels[m_worklist.front()];
+
+    do
+    {
+        std::pop_heap(m_worklist.begin(), m_worklist.end(), LaterPosition{m_positions});
+
+        const auto index = m_worklist.back();
+        m_worklist.pop_back();
+        m_scheduled[index] = false;
+        m_batch.push_back(index);
+    }
+    while (wholeLevel && !m_worklist.empty() && m_levels[m_worklist.front()] == level);
+
+    m_executing = true;
+    m_currentPosition = m_positions[m_batch.back()];
+
+    return true;
+}
+
+unsigned int AbstractPipeline::workerCount() const
+{
+    return m_workerCount;
+}
+
+void AbstractPipeline::setWorkerCount(unsigned int count)
+{
+    synchronize();
+
+    m_workerCount = std::max(count, 1u);
+
+    if (m_workerCount > 1)
+    {
+        // The calling thread counts as a worker as it executes the context-bound stages
+        m_threadPool.reset(new ThreadPool(m_workerCount - 1));
+    }
+    else
+    {
+        m_threadPool.reset();
+        m_frameAheadThread.reset();
+    }
+}
+
 bool AbstractPipeline::isInitialized() const
 {
     return m_initialized;
@@ -173,65 +984,94 @@ bool AbstractPipeline::sortDependencies()
     if (m_dependenciesSorted)
         return true;
 
-    m_dependenciesSorted = tsort(m_stages);
-    return m_dependenciesSorted;
-}
+    // Frame-ahead stages of the previous execution may still be running
+    synchronize();
 
-void AbstractPipeline::addStages()
-{
+    // On a cycle, the last valid order is kept
+    if (!m_graph.sort())
+        return false;
+
+    computeLevels();
+
+    if (m_framePipelining)
+        computeFrameAhead();
+
+    m_demandComputed = false;
+    m_fusionComputed = false;
+    m_transientResources.invalidatePlan();
+
+    {
+        // Positions changed, so the worklist has to be reordered
+        std::lock_guard<std::mutex> lock(m_worklistMutex);
+        std::make_heap(m_worklist.begin(), m_worklist.end(), LaterPosition{m_positions});
+    }
+
+    m_dependenciesSorted = true;
+    return true;
 }
 
-bool AbstractPipeline::tsort(std::vector<AbstractStage *> & stages)
+void AbstractPipeline::computeLevels()
 {
-    auto couldBeSorted = true;
-    std::vector<AbstractStage *> sorted;
-    std::set<AbstractStage *> touched;
+    const auto numStages = m_graph.size();
+    std::size_t numLevels = 0;
 
-    std::function<void(AbstractStage *)> visit = [&](AbstractStage * stage)
+    m_levels.assign(numStages, 0);
+
+    // All predecessors of a stage are visited before the stage itself
+    for (auto index : m_graph.order())
     {
-        if (!couldBeSorted)
-        {
-            sorted.push_back(stage);
-            return;
-        }
+        std::size_t level = 0;
 
-        if (touched.count(stage) > 0)
+        for (auto predecessor : m_graph.predecessors(index))
         {
-            std::cerr << "Pipeline is not a directed acyclic graph" << std::endl;
-            couldBeSorted = false;
-            sorted.push_back(stage);
-            return;
+            level = std::max(level, m_levels[predecessor] + 1);
         }
 
-        touched.insert(stage);
+        m_levels[index] = level;
+        numLevels = std::max(numLevels, level + 1);
+    }
 
-        for (auto stageIt = stages.begin(); stageIt != stages.end(); /* nop */)
-        {
-            if (!stage->requires(*stageIt, false))
-            {
-                ++stageIt;
-                continue;
-            }
+    // Ordering by level is a topological order as well, with the stages of a level next to each other
+    std::vector<std::size_t> offsets(numLevels + 1, 0);
 
-            auto nextStage = *stageIt;
-            stages.erase(stageIt);
-            visit(nextStage);
+    for (std::size_t index = 0; index < numStages; ++index)
+    {
+        ++offsets[m_levels[index] + 1];
+    }
 
-            stageIt = stages.begin();
-        }
+    for (std::size_t level = 1; level <= numLevels; ++level)
+    {
+        offsets[level] += offsets[level - 1];
+    }
 
-        sorted.push_back(stage);
-    };
+    m_stages.resize(numStages);
+    m_positions.resize(numStages);
 
-    while (!stages.empty())
+    for (auto index : m_graph.order())
     {
-        auto stageIt = stages.begin();
-        auto stage = *stageIt;
-        stages.erase(stageIt);
-        visit(stage);
+        const auto position = offsets[m_levels[index]]++;
+
+        m_positions[index] = position;
+        m_stages[position] = m_graph.stage(index);
     }
+}
+
+void AbstractPipeline::addStages()
+{
+}
+
+bool AbstractPipeline::tsort(std::vector<AbstractStage *> & stages)
+{
+    StageGraph graph;
+
+    for (auto stage : stages)
+    {
+        graph.addStage(stage);
+    }
+
+    const auto couldBeSorted = graph.sort();
 
-    stages = sorted;
+    stages = graph.sortedStages();
 
     return couldBeSorted;
 }
@@ -1,11 +1,35 @@
 #include <gloperate/pipeline/AbstractStage.h>
 
+#include <cassert>
 #include <iostream>
 #include <algorithm>
-#include <iterator>
 
+#include <globjects/Renderbuffer.h>
+#include <globjects/Texture.h>
+
+#include <gloperate/base/CommandList.h>
+#include <gloperate/base/StateCache.h>
 #include <gloperate/pipeline/AbstractInputSlot.h>
 #include <gloperate/pipeline/AbstractData.h>
+#include <gloperate/pipeline/OutputCache.h>
+#include <gloperate/pipeline/TransientResource.h>
+#include <gloperate/pipeline/TransientResourcePool.h>
+
+
+namespace
+{
+
+template <typename T>
+bool insertUnique(std::vector<T> & container, const T & value)
+{
+    if (std::find(container.begin(), container.end(), value) != container.end())
+        return false;
+
+    container.push_back(value);
+    return true;
+}
+
+} // namespace
 
 
 namespace gloperate
@@ -14,7 +38,14 @@ namespace gloperate
 AbstractStage::AbstractStage(const std::string & name)
 : m_enabled(true)
 , m_alwaysProcess(false)
-, m_processScheduled(false)
+, m_processScheduled(true)
+, m_memoized(false)
+, m_threadAffinity(ThreadAffinity::ContextThread)
+, m_outputCache(nullptr)
+, m_transientPool(nullptr)
+, m_stateCache(nullptr)
+, m_backgroundWorkers(nullptr)
+, m_transactionScope(nullptr)
 , m_name(name)
 {
     dependenciesChanged.connect([this]() { m_usable.invalidate(); });
@@ -22,6 +53,14 @@ AbstractStage::AbstractStage(const std::string & name)
 
 AbstractStage::~AbstractStage()
 {
+    // The pool must not refer to the resources, which may be members destroyed already
+    if (m_transientPool)
+    {
+        for (auto resource : m_transientResources)
+        {
+            m_transientPool->remove(resource);
+        }
+    }
 }
 
 const std::string & AbstractStage::name() const
@@ -51,6 +90,21 @@ std::string AbstractStage::asPrintable() const
 }
 
 bool AbstractStage::execute()
+{
+    if (!beginProcess())
+        return false;
+
+    if (m_memoized && m_outputCache)
+        processMemoized();
+    else
+        process();
+
+    endProcess();
+
+    return true;
+}
+
+bool AbstractStage::beginProcess()
 {
     if (!m_enabled)
         return false;
@@ -58,29 +112,42 @@ bool AbstractStage::execute()
     if (!inputsUsable())
         return false;
 
-    if (needsToProcess()) {
-        m_processScheduled = false;
-        process();
-    } else {
+    if (!needsToProcess())
         return false;
+
+    m_processScheduled = false;
+
+    if (m_transientPool && !m_transientResources.empty())
+    {
+        const auto allocations = m_transientPool->allocationCount();
+
+        m_transientPool->acquire(this);
+
+        // globjects binds textures behind the cache to specify their storage
+        if (m_stateCache && m_transientPool->allocationCount() != allocations)
+            m_stateCache->invalidateTextures();
     }
-    
-    markInputsProcessed();
-    
+
     return true;
 }
 
+void AbstractStage::endProcess()
+{
+    markInputsProcessed();
+
+    // Stages without inputs are never invalidated, so they stay dirty like alwaysProcess stages
+    if (m_alwaysProcess || m_allInputs.empty())
+        scheduleProcess();
+}
+
 void AbstractStage::initialize()
 {
 }
 
 bool AbstractStage::needsToProcess() const
 {
-    std::set<AbstractInputSlot*> inputs = allInputs();
-
-    return m_alwaysProcess || m_processScheduled || inputs.empty() || std::any_of(inputs.begin(), inputs.end(), [](const AbstractInputSlot * input) {
-        return input->hasChanged();
-    });
+    // Changed inputs schedule their stages, see AbstractInputSlot::changed()
+    return m_alwaysProcess || m_processScheduled || m_allInputs.empty();
 }
 
 bool AbstractStage::inputsUsable() const
@@ -88,15 +155,14 @@ bool AbstractStage::inputsUsable() const
     if (m_usable.isValid())
         return m_usable.value();
 
-    std::set<AbstractInputSlot*> inputs = allInputs();
-    m_usable.setValue(std::all_of(inputs.begin(), inputs.end(), [](const AbstractInputSlot * input) {
+    m_usable.setValue(std::all_of(m_allInputs.begin(), m_allInputs.end(), [](const AbstractInputSlot * input) {
         return input->isUsable();
     }));
 
     if (!m_usable.value())
     {
         std::cout << "Some inputs in " << asPrintable() << " are not connected: ";
-        for (AbstractInputSlot * slot : inputs)
+        for (AbstractInputSlot * slot : m_allInputs)
             if (!slot->isUsable())
                 std::cout << slot->asPrintable() << ". ";
         std::cout << std::endl;
@@ -105,6 +171,47 @@ bool AbstractStage::inputsUsable() const
     return m_usable.value();
 }
 
+void AbstractStage::processMemoized()
+{
+    std::vector<std::size_t> key;
+    std::vector<const AbstractData *> inputs;
+
+    if (!hashInputs(key, inputs))
+    {
+        m_outputCache->countUncacheable();
+        process();
+        return;
+    }
+
+    if (m_outputCache->restore(this, key, inputs, m_outputs))
+        return;
+
+    process();
+
+    m_outputCache->store(this, std::move(key), inputs, m_outputs);
+}
+
+bool AbstractStage::hashInputs(std::vector<std::size_t> & key, std::vector<const AbstractData *> & inputs) const
+{
+    key.reserve(2 * m_allInputs.size());
+    inputs.reserve(m_allInputs.size());
+
+    for (const AbstractInputSlot * input : m_allInputs)
+    {
+        std::size_t hash = 0;
+
+        // Unconnected optional inputs are keyed as such, as the stage falls back to defaults
+        if (input->isConnected() && !input->connectedData()->hashValue(hash))
+            return false;
+
+        key.push_back(input->isConnected() ? hash : 0);
+        key.push_back(input->isConnected() ? 1 : 0);
+        inputs.push_back(input->isConnected() ? input->connectedData() : nullptr);
+    }
+
+    return true;
+}
+
 void AbstractStage::markInputsProcessed()
 {
     for (AbstractInputSlot * input : m_inputs)
@@ -124,6 +231,10 @@ void AbstractStage::invalidateOutputs()
 void AbstractStage::setEnabled(bool enabled)
 {
     m_enabled = enabled;
+
+    // Changes while disabled were skipped, notify again so the stage gets visited
+    if (m_enabled && m_processScheduled)
+        processScheduled();
 }
 
 bool AbstractStage::isEnabled() const
@@ -131,9 +242,98 @@ bool AbstractStage::isEnabled() const
     return m_enabled;
 }
 
+AbstractStage::ThreadAffinity AbstractStage::threadAffinity() const
+{
+    return m_threadAffinity;
+}
+
+void AbstractStage::setThreadAffinity(ThreadAffinity affinity)
+{
+    m_threadAffinity = affinity;
+}
+
 void AbstractStage::alwaysProcess(bool on)
 {
     m_alwaysProcess = on;
+
+    if (m_alwaysProcess)
+        scheduleProcess();
+}
+
+bool AbstractStage::isMemoized() const
+{
+    return m_memoized;
+}
+
+void AbstractStage::setMemoized(bool memoized)
+{
+    m_memoized = memoized;
+}
+
+void AbstractStage::setOutputCache(OutputCache * cache)
+{
+    m_outputCache = cache;
+}
+
+void AbstractStage::setTransientResourcePool(TransientResourcePool * pool)
+{
+    m_transientPool = pool;
+}
+
+InvalidationTransaction::Scope * AbstractStage::transactionScope() const
+{
+    return m_transactionScope;
+}
+
+void AbstractStage::setTransactionScope(InvalidationTransaction::Scope * scope)
+{
+    m_transactionScope = scope;
+}
+
+const AbstractStage * AbstractStage::processedBy() const
+{
+    return nullptr;
+}
+
+StateCache * AbstractStage::stateCache() const
+{
+    return m_stateCache;
+}
+
+void AbstractStage::setStateCache(StateCache * cache)
+{
+    m_stateCache = cache;
+}
+
+BackgroundWorkers * AbstractStage::backgroundWorkers() const
+{
+    return m_backgroundWorkers;
+}
+
+void AbstractStage::setBackgroundWorkers(BackgroundWorkers * workers)
+{
+    m_backgroundWorkers = workers;
+}
+
+CommandList & AbstractStage::commands()
+{
+    if (!m_commands)
+        m_commands.reset(new CommandList);
+
+    return *m_commands;
+}
+
+void AbstractStage::replayCommands()
+{
+    if (!m_commands || m_commands->empty())
+        return;
+
+    assert(m_stateCache);
+
+    // Stages executed since the commands were recorded may have changed the state behind the cache
+    m_stateCache->invalidate();
+    m_commands->replay(*m_stateCache);
+    m_commands->reset();
 }
 
 bool AbstractStage::isAlwaysProcess() const
@@ -143,7 +343,17 @@ bool AbstractStage::isAlwaysProcess() const
 
 void AbstractStage::scheduleProcess()
 {
-    m_processScheduled = true;
+    // Two stages processed in parallel may invalidate inputs of the same consumer
+    if (m_processScheduled.exchange(true))
+        return;
+
+    if (!AbstractData::deferSchedule(this))
+        processScheduled();
+}
+
+bool AbstractStage::isProcessScheduled() const
+{
+    return m_processScheduled;
 }
 
 bool AbstractStage::requires(const AbstractStage * stage, bool recursive) const
@@ -166,72 +376,101 @@ bool AbstractStage::requires(const AbstractStage * stage, bool recursive) const
     return false;
 }
 
-const std::set<AbstractData*> & AbstractStage::outputs() const
+std::vector<const AbstractStage *> AbstractStage::dependencies() const
 {
-    return m_outputs;
-}
+    std::vector<const AbstractStage *> stages;
 
-std::set<AbstractData*> AbstractStage::allOutputs() const
-{
-    std::set<AbstractData*> outputs;
+    for (AbstractInputSlot * slot : m_inputs)
+    {
+        if (slot->isFeedback() || !slot->connectedData() || !slot->connectedData()->owner())
+            continue;
+
+        stages.push_back(slot->connectedData()->owner());
+    }
 
-    std::set_union(
-        m_outputs.begin(),
-        m_outputs.end(),
-        m_sharedOutputs.begin(),
-        m_sharedOutputs.end(),
-        std::inserter(outputs, outputs.end())
-    );
+    for (AbstractStage * depStage : m_dependencies)
+    {
+        stages.push_back(depStage);
+    }
 
-    return outputs;
+    return stages;
 }
 
-const std::set<AbstractInputSlot*> & AbstractStage::inputs() const
+const std::set<AbstractData*> & AbstractStage::outputs() const
 {
-    return m_inputs;
+    return m_outputSet;
 }
 
-std::set<AbstractInputSlot*> AbstractStage::allInputs() const
+const std::set<AbstractData*> & AbstractStage::allOutputs() const
 {
-    std::set<AbstractInputSlot*> inputs;
+    return m_allOutputSet;
+}
 
-    std::set_union(
-        m_inputs.begin(),
-        m_inputs.end(),
-        m_sharedInputs.begin(),
-        m_sharedInputs.end(),
-        std::inserter(inputs, inputs.end())
-    );
+const std::set<AbstractInputSlot*> & AbstractStage::inputs() const
+{
+    return m_inputSet;
+}
 
-    return inputs;
+const std::set<AbstractInputSlot*> & AbstractStage::allInputs() const
+{
+    return m_allInputSet;
 }
 
 void AbstractStage::addOutput(const std::string & name, AbstractData & output)
 {
     output.setName(name);
     output.setOwner(this);
-    m_outputs.insert(&output);
+
+    if (!insertUnique(m_outputs, &output))
+        return;
+
+    m_outputSet.insert(&output);
+
+    if (insertUnique(m_allOutputs, &output))
+        m_allOutputSet.insert(&output);
 }
 
 void AbstractStage::shareOutput(AbstractData* output)
 {
-    m_sharedOutputs.insert(output);
+    if (!insertUnique(m_sharedOutputs, output))
+        return;
+
+    if (insertUnique(m_allOutputs, output))
+        m_allOutputSet.insert(output);
 }
 
 void AbstractStage::addInput(const std::string & name, AbstractInputSlot & input)
 {
     input.setName(name);
     input.setOwner(this);
-    m_inputs.insert(&input);
+
+    if (!insertUnique(m_inputs, &input))
+        return;
+
+    m_inputSet.insert(&input);
+
+    if (insertUnique(m_allInputs, &input))
+        m_allInputSet.insert(&input);
 
     input.connectionChanged.connect(dependenciesChanged);
+
+    if (input.hasChanged())
+        scheduleProcess();
 }
 
 void AbstractStage::shareInput(AbstractInputSlot * input)
 {
-    m_sharedInputs.insert(input);
+    if (!insertUnique(m_sharedInputs, input))
+        return;
+
+    if (insertUnique(m_allInputs, input))
+        m_allInputSet.insert(input);
+    input->m_sharingStages.push_back(this);
 
     input->connectionChanged.connect(dependenciesChanged);
+
+    if (input->hasChanged())
+        scheduleProcess();
 }
 
 void AbstractStage::addFeedbackInput(const std::string & name, AbstractInputSlot & input)
@@ -248,8 +487,43 @@ void AbstractStage::addOptionalInput(const std::string & name, AbstractInputSlot
 
 void AbstractStage::addDependency(AbstractStage * stage)
 {
-    m_dependencies.insert(stage);
+    insertUnique(m_dependencies, stage);
+    dependenciesChanged();
+}
+
+void AbstractStage::addTransientResource(TransientResource & resource, const AbstractData * exportedAs)
+{
+    resource.m_owner = this;
+    resource.m_exportedAs = exportedAs;
+
+    insertUnique(m_transientResources, &resource);
+
+    // The lifetimes of the pipeline's transient resources have to be planned again
     dependenciesChanged();
 }
 
+void AbstractStage::removeTransientResource(TransientResource & resource)
+{
+    const auto it = std::find(m_transientResources.begin(), m_transientResources.end(), &resource);
+
+    if (it == m_transientResources.end())
+        return;
+
+    m_transientResources.erase(it);
+
+    if (m_transientPool)
+        m_transientPool->remove(&resource);
+
+    resource.m_slot = TransientResourcePool::npos;
+    resource.m_texture = nullptr;
+    resource.m_renderbuffer = nullptr;
+
+    dependenciesChanged();
+}
+
+const std::vector<TransientResource*> & AbstractStage::transientResources() const
+{
+    return m_transientResources;
+}
+
 } // namespace gloperate
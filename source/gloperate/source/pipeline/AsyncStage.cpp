@@ -0,0 +1,144 @@
+#include <gloperate/pipeline/AsyncStage.h>
+
+#include <algorithm>
+#include <cassert>
+
+#include <gloperate/pipeline/AbstractInputSlot.h>
+#include <gloperate/pipeline/BackgroundWorkers.h>
+
+
+namespace gloperate
+{
+
+AsyncStage::AsyncStage(const std::string & name)
+: AbstractStage(name)
+, pending(false)
+, m_restart(true)
+{
+    addOutput("pending", pending);
+}
+
+AsyncStage::~AsyncStage()
+{
+    if (m_job)
+    {
+        std::lock_guard<std::mutex> lock(m_job->mutex);
+
+        // The job only uses its captured state and returns early, its completion is dropped
+        m_job->cancelled = true;
+        m_job->stage = nullptr;
+    }
+}
+
+bool AsyncStage::isPending() const
+{
+    return pending.data();
+}
+
+void AsyncStage::cancelAndWait()
+{
+    if (!m_job)
+        return;
+
+    m_job->cancelled = true;
+
+    {
+        std::unique_lock<std::mutex> lock(m_job->mutex);
+        m_job->finished.wait(lock, [this]() { return m_job->done; });
+    }
+
+    // The inputs of the cancelled job were not processed yet
+    m_job.reset();
+    m_restart = true;
+}
+
+void AsyncStage::process()
+{
+    const auto changed = inputsChanged();
+
+    if (m_job)
+    {
+        if (changed)
+        {
+            m_job->cancelled = true;
+            m_restart = true;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_job->mutex);
+
+            // The finished job schedules the stage again
+            if (!m_job->done)
+                return;
+        }
+
+        const bool cancelled = m_job->cancelled;
+        m_job.reset();
+
+        if (!cancelled)
+            publish();
+    }
+
+    if (m_restart || changed)
+    {
+        m_restart = false;
+        startJob();
+    }
+
+    setPending(m_job != nullptr);
+}
+
+bool AsyncStage::inputsChanged() const
+{
+    return std::any_of(m_allInputs.begin(), m_allInputs.end(), [](const AbstractInputSlot * input) {
+        return input->hasChanged();
+    });
+}
+
+void AsyncStage::startJob()
+{
+    // Jobs run on the workers of the pipeline
+    assert(m_backgroundWorkers);
+
+    auto job = prepare();
+
+    auto state = std::make_shared<JobState>();
+    state->cancelled = false;
+    state->done = false;
+    state->stage = this;
+
+    m_job = state;
+
+    auto workers = m_backgroundWorkers;
+
+    workers->submit([state, job, workers]()
+    {
+        job(state->cancelled);
+
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->done = true;
+
+        // Notifications are delivered on the context thread, like every other change.
+        // Posted before waiters are woken, so an execution following them schedules the stage.
+        workers->post([state]()
+        {
+            if (!state->stage)
+                return;
+
+            state->stage->scheduleProcess();
+            state->stage->finished();
+        });
+
+        state->finished.notify_all();
+    });
+}
+
+void AsyncStage::setPending(bool isPending)
+{
+    if (pending.data() == isPending)
+        return;
+
+    pending.setData(isPending);
+}
+
+} // namespace gloperate
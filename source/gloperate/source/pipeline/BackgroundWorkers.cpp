@@ -0,0 +1,66 @@
+#include <gloperate/pipeline/BackgroundWorkers.h>
+
+#include <algorithm>
+#include <thread>
+
+#include <gloperate/base/ThreadPool.h>
+
+
+namespace gloperate
+{
+
+BackgroundWorkers::BackgroundWorkers()
+{
+}
+
+BackgroundWorkers::~BackgroundWorkers()
+{
+    // Joins the workers first, their jobs may still post
+    m_pool.reset();
+}
+
+void BackgroundWorkers::submit(Task job)
+{
+    if (!m_pool)
+    {
+        // One thread is left to the context, hardware_concurrency() may return 0
+        const auto numThreads = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+        m_pool.reset(new ThreadPool(numThreads));
+    }
+
+    m_pool->submit(std::move(job));
+}
+
+void BackgroundWorkers::post(Task task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_posted.push_back(std::move(task));
+    }
+
+    posted();
+}
+
+bool BackgroundWorkers::hasPosted() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return !m_posted.empty();
+}
+
+void BackgroundWorkers::runPosted()
+{
+    std::vector<Task> tasks;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        tasks.swap(m_posted);
+    }
+
+    // Tasks may post again, those are run by the next call
+    for (auto & task : tasks)
+        task();
+}
+
+} // namespace gloperate
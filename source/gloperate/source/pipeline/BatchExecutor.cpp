@@ -0,0 +1,498 @@
+#include <gloperate/pipeline/BatchExecutor.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#include <glbinding/gl/bitfield.h>
+#include <glbinding/gl/enum.h>
+#include <glbinding/gl/functions.h>
+
+#include <globjects/base/ref_ptr.h>
+#include <globjects/Buffer.h>
+#include <globjects/Texture.h>
+
+#include <gloperate/pipeline/AbstractData.h>
+#include <gloperate/pipeline/AbstractPipeline.h>
+#include <gloperate/pipeline/AbstractStage.h>
+#include <gloperate/pipeline/Data.h>
+#include <gloperate/pipeline/ParameterSweep.h>
+
+
+namespace gloperate
+{
+
+/** Bounded queue of results, drained by a sink thread */
+class BatchExecutor::ResultQueue
+{
+public:
+    ResultQueue(std::size_t capacity, const Sink & sink)
+    :   m_capacity(std::max<std::size_t>(capacity, 1))
+    ,   m_closed(false)
+    ,   m_sink(sink)
+    ,   m_thread(&ResultQueue::drain, this)
+    {
+    }
+
+    ~ResultQueue()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+        }
+
+        m_changed.notify_all();
+        m_thread.join();
+    }
+
+    void push(std::unique_ptr<Result> result)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_changed.wait(lock, [this]() { return m_results.size() < m_capacity; });
+
+        m_results.push_back(std::move(result));
+        m_changed.notify_all();
+    }
+
+protected:
+    void drain()
+    {
+        while (true)
+        {
+            std::unique_ptr<Result> result;
+
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_changed.wait(lock, [this]() { return m_closed || !m_results.empty(); });
+
+                if (m_results.empty())
+                    return;
+
+                result = std::move(m_results.front());
+                m_results.pop_front();
+                m_changed.notify_all();
+            }
+
+            if (m_sink)
+                m_sink(*result);
+        }
+    }
+
+protected:
+    std::size_t m_capacity;
+    bool m_closed;
+    const Sink & m_sink;
+
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    std::deque<std::unique_ptr<Result>> m_results;
+
+    std::thread m_thread;
+};
+
+
+/** Texture readbacks into pixel pack buffers, results are passed on once their copies completed */
+class BatchExecutor::ReadbackRing
+{
+public:
+    ReadbackRing(std::size_t latency, ResultQueue & queue)
+    :   m_latency(latency)
+    ,   m_queue(queue)
+    {
+    }
+
+    /** Starts copying the first level of the texture into a buffer, in RGBA8 */
+    void read(std::size_t output, const globjects::Texture * texture)
+    {
+        const auto target = texture->target();
+        const auto width = texture->getLevelParameter(0, gl::GL_TEXTURE_WIDTH);
+        const auto height = texture->getLevelParameter(0, gl::GL_TEXTURE_HEIGHT);
+        const auto depth = texture->getLevelParameter(0, gl::GL_TEXTURE_DEPTH);
+
+        Read read;
+        read.output = output;
+        read.slot = acquire(static_cast<gl::GLsizeiptr>(width) * height * depth * 4);
+
+        read.slot.buffer->bind(gl::GL_PIXEL_PACK_BUFFER);
+        gl::glBindTexture(target, texture->id());
+        gl::glGetTexImage(target, 0, gl::GL_RGBA, gl::GL_UNSIGNED_BYTE, nullptr);
+        globjects::Buffer::unbind(gl::GL_PIXEL_PACK_BUFFER);
+
+        m_reads.push_back(read);
+    }
+
+    /** Queues the result for the sink once the copies started since the last push completed */
+    void push(std::unique_ptr<Result> result)
+    {
+        if (m_reads.empty() && m_pending.empty())
+        {
+            m_queue.push(std::move(result));
+            return;
+        }
+
+        Pending pending;
+        pending.result = std::move(result);
+        pending.reads.swap(m_reads);
+        pending.fence = pending.reads.empty() ? nullptr : gl::glFenceSync(gl::GL_SYNC_GPU_COMMANDS_COMPLETE, gl::GL_UNUSED_BIT);
+
+        m_pending.push_back(std::move(pending));
+
+        while (m_pending.size() > m_latency)
+            complete();
+    }
+
+    void flush()
+    {
+        while (!m_pending.empty())
+            complete();
+    }
+
+protected:
+    struct Slot
+    {
+        globjects::ref_ptr<globjects::Buffer> buffer;
+        gl::GLsizeiptr size;
+    };
+
+    struct Read
+    {
+        std::size_t output;
+        Slot slot;
+    };
+
+    struct Pending
+    {
+        std::unique_ptr<Result> result;
+        std::vector<Read> reads;
+        gl::GLsync fence;
+    };
+
+    Slot acquire(gl::GLsizeiptr size)
+    {
+        auto match = std::find_if(m_free.begin(), m_free.end(), [size](const Slot & slot) { return slot.size == size; });
+
+        if (match == m_free.end() && !m_free.empty())
+            match = m_free.begin();
+
+        Slot slot;
+
+        if (match != m_free.end())
+        {
+            slot = *match;
+            m_free.erase(match);
+        }
+        else
+        {
+            slot.buffer = new globjects::Buffer;
+            slot.size = 0;
+        }
+
+        // Storage is only re-specified when the texture size changed
+        if (slot.size != size)
+        {
+            slot.buffer->setData(size, nullptr, gl::GL_STREAM_READ);
+            slot.size = size;
+        }
+
+        return slot;
+    }
+
+    void complete()
+    {
+        auto pending = std::move(m_pending.front());
+        m_pending.pop_front();
+
+        gl::GLenum status = gl::GL_ALREADY_SIGNALED;
+
+        if (pending.fence)
+        {
+            // With the default latency, the copies are usually done and this does not block
+            do
+            {
+                status = gl::glClientWaitSync(pending.fence, gl::GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+            }
+            while (status == gl::GL_TIMEOUT_EXPIRED);
+
+            gl::glDeleteSync(pending.fence);
+        }
+
+        if (status == gl::GL_WAIT_FAILED)
+            std::cerr << "Readback of combination " << pending.result->combination << " failed" << std::endl;
+
+        for (auto & read : pending.reads)
+        {
+            if (status != gl::GL_WAIT_FAILED)
+            {
+                read.slot.buffer->bind(gl::GL_PIXEL_PACK_BUFFER);
+
+                if (auto data = static_cast<const unsigned char *>(read.slot.buffer->mapRange(0, read.slot.size, gl::GL_MAP_READ_BIT)))
+                {
+                    std::vector<unsigned char> image(data, data + read.slot.size);
+                    pending.result->outputs[read.output].reset(new DataSnapshot<std::vector<unsigned char>>(std::move(image)));
+                }
+
+                read.slot.buffer->unmap();
+                globjects::Buffer::unbind(gl::GL_PIXEL_PACK_BUFFER);
+            }
+
+            m_free.push_back(read.slot);
+        }
+
+        m_queue.push(std::move(pending.result));
+    }
+
+protected:
+    std::size_t m_latency;
+    ResultQueue & m_queue;
+
+    std::vector<Read> m_reads;      /**< Started since the last push */
+    std::deque<Pending> m_pending;
+    std::vector<Slot> m_free;
+};
+
+
+BatchExecutor::BatchExecutor(AbstractPipeline & pipeline)
+: m_pipeline(pipeline)
+, m_queueCapacity(16)
+, m_readbackLatency(2)
+, m_numClones(0)
+{
+}
+
+BatchExecutor::~BatchExecutor()
+{
+}
+
+const std::vector<std::string> & BatchExecutor::outputNames() const
+{
+    return m_outputNames;
+}
+
+void BatchExecutor::setOutputNames(const std::vector<std::string> & names)
+{
+    m_outputNames = names;
+}
+
+std::size_t BatchExecutor::queueCapacity() const
+{
+    return m_queueCapacity;
+}
+
+void BatchExecutor::setQueueCapacity(std::size_t capacity)
+{
+    m_queueCapacity = capacity;
+}
+
+std::size_t BatchExecutor::readbackLatency() const
+{
+    return m_readbackLatency;
+}
+
+void BatchExecutor::setReadbackLatency(std::size_t latency)
+{
+    m_readbackLatency = latency;
+}
+
+void BatchExecutor::setReadback(const std::string & name, Readback readback)
+{
+    m_readbacks[name] = std::move(readback);
+}
+
+void BatchExecutor::setClones(PipelineFactory factory, unsigned int numClones)
+{
+    m_factory = std::move(factory);
+    m_numClones = numClones;
+}
+
+std::size_t BatchExecutor::run(const ParameterSweep & sweep, const Sink & sink)
+{
+    std::vector<std::unique_ptr<AbstractPipeline>> clones;
+
+    if (m_factory && m_numClones > 1)
+    {
+        for (unsigned int i = 0; i < m_numClones; ++i)
+        {
+            clones.push_back(m_factory());
+
+            if (!clones.back() || !isThreadSafe(*clones.back()))
+            {
+                std::cout << "Pipeline clones have stages bound to the context, executing sequentially" << std::endl;
+                clones.clear();
+                break;
+            }
+        }
+    }
+
+    // Destroying the queue waits for the sink to receive all results
+    ResultQueue queue(m_queueCapacity, sink);
+
+    if (!clones.empty())
+        return runClones(sweep, clones, queue);
+
+    return runSequential(sweep, queue);
+}
+
+std::size_t BatchExecutor::runSequential(const ParameterSweep & sweep, ResultQueue & queue)
+{
+    m_pipeline.initialize();
+
+    if (!m_pipeline.isInitialized())
+        return 0;
+
+    const auto outputs = findOutputs(m_pipeline);
+    auto previous = ParameterSweep::npos;
+    std::size_t numExecuted = 0;
+
+    ReadbackRing ring(m_readbackLatency, queue);
+
+    for (std::size_t combination = 0; combination < sweep.size(); ++combination)
+    {
+        if (!applyCombination(sweep, combination, m_pipeline, previous))
+            continue;
+
+        m_pipeline.execute();
+        ++numExecuted;
+
+        ring.push(takeResult(combination, outputs, &ring));
+    }
+
+    ring.flush();
+
+    return numExecuted;
+}
+
+std::size_t BatchExecutor::runClones(const ParameterSweep & sweep, std::vector<std::unique_ptr<AbstractPipeline>> & clones, ResultQueue & queue)
+{
+    std::atomic<std::size_t> next(0);
+    std::atomic<std::size_t> numExecuted(0);
+    std::vector<std::thread> threads;
+
+    for (auto & clone : clones)
+    {
+        AbstractPipeline * pipeline = clone.get();
+
+        threads.emplace_back([this, pipeline, &sweep, &queue, &next, &numExecuted]()
+        {
+            pipeline->initialize();
+
+            if (!pipeline->isInitialized())
+                return;
+
+            const auto outputs = findOutputs(*pipeline);
+            auto previous = ParameterSweep::npos;
+
+            for (auto combination = next++; combination < sweep.size(); combination = next++)
+            {
+                if (!applyCombination(sweep, combination, *pipeline, previous))
+                    continue;
+
+                pipeline->execute();
+                ++numExecuted;
+
+                queue.push(takeResult(combination, outputs));
+            }
+        });
+    }
+
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    return numExecuted;
+}
+
+std::vector<AbstractData *> BatchExecutor::findOutputs(const AbstractPipeline & pipeline) const
+{
+    std::vector<AbstractData *> outputs;
+
+    for (const auto & name : m_outputNames)
+    {
+        const auto candidates = pipeline.findOutputs(name);
+
+        outputs.push_back(candidates.empty() ? nullptr : candidates.front());
+    }
+
+    return outputs;
+}
+
+std::unique_ptr<BatchExecutor::Result> BatchExecutor::takeResult(std::size_t combination, const std::vector<AbstractData *> & outputs, ReadbackRing * ring) const
+{
+    std::unique_ptr<Result> result(new Result);
+    result->combination = combination;
+    result->outputs.resize(outputs.size());
+
+    for (std::size_t i = 0; i < outputs.size(); ++i)
+    {
+        if (!outputs[i])
+            continue;
+
+        const auto texture = ring && !m_readbacks.count(m_outputNames[i])
+            ? dynamic_cast<const Data<globjects::ref_ptr<globjects::Texture>> *>(outputs[i])
+            : nullptr;
+
+        // The snapshot is filled in once the copy completed
+        if (texture)
+        {
+            if (texture->data())
+                ring->read(i, texture->data());
+
+            continue;
+        }
+
+        result->outputs[i] = takeOutput(m_outputNames[i], *outputs[i]);
+    }
+
+    return result;
+}
+
+std::unique_ptr<AbstractDataSnapshot> BatchExecutor::takeOutput(const std::string & name, const AbstractData & output) const
+{
+    const auto readback = m_readbacks.find(name);
+
+    if (readback != m_readbacks.end())
+        return readback->second(output);
+
+    // The texture is overwritten by the next execution and cannot be read on the sink thread
+    if (auto texture = dynamic_cast<const Data<globjects::ref_ptr<globjects::Texture>> *>(&output))
+        return readTexture(texture->data());
+
+    return output.snapshot();
+}
+
+bool BatchExecutor::applyCombination(const ParameterSweep & sweep, std::size_t combination, AbstractPipeline & pipeline, std::size_t & previous)
+{
+    if (sweep.apply(combination, pipeline, previous))
+    {
+        previous = combination;
+        return true;
+    }
+
+    std::cout << "Parameters of combination " << combination << " could not be applied, skipping it" << std::endl;
+
+    // Some parameters may have been set, so the next combination sets all of them
+    previous = ParameterSweep::npos;
+
+    return false;
+}
+
+std::unique_ptr<AbstractDataSnapshot> BatchExecutor::readTexture(const globjects::Texture * texture)
+{
+    if (!texture)
+        return nullptr;
+
+    return std::unique_ptr<AbstractDataSnapshot>(new DataSnapshot<std::vector<unsigned char>>(texture->getImage(0, gl::GL_RGBA, gl::GL_UNSIGNED_BYTE)));
+}
+
+bool BatchExecutor::isThreadSafe(const AbstractPipeline & pipeline)
+{
+    return std::all_of(pipeline.stages().begin(), pipeline.stages().end(), [](const AbstractStage * stage) {
+        return stage->threadAffinity() == AbstractStage::ThreadAffinity::AnyThread;
+    });
+}
+
+} // namespace gloperate
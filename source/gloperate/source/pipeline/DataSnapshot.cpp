@@ -0,0 +1,15 @@
+#include <gloperate/pipeline/DataSnapshot.h>
+
+
+namespace gloperate
+{
+
+AbstractDataSnapshot::AbstractDataSnapshot()
+{
+}
+
+AbstractDataSnapshot::~AbstractDataSnapshot()
+{
+}
+
+} // namespace gloperate
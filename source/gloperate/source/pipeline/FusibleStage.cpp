@@ -0,0 +1,255 @@
+#include <gloperate/pipeline/FusibleStage.h>
+
+#include <sstream>
+#include <unordered_map>
+
+#include <glbinding/gl/enum.h>
+
+#include <globjects/base/StaticStringSource.h>
+#include <globjects/base/StringTemplate.h>
+#include <globjects/Framebuffer.h>
+#include <globjects/Program.h>
+#include <globjects/Shader.h>
+#include <globjects/Texture.h>
+
+#include <gloperate/base/StateCache.h>
+#include <gloperate/primitives/ScreenAlignedQuad.h>
+
+
+namespace
+{
+
+std::string replacePlaceholder(const std::string & source, const std::string & prefix)
+{
+    std::string result;
+    result.reserve(source.size());
+
+    for (auto character : source)
+    {
+        if (character == '$')
+            result += prefix;
+        else
+            result += character;
+    }
+
+    return result;
+}
+
+} // namespace
+
+
+namespace gloperate
+{
+
+void FusibleStage::fuseChains(const std::vector<AbstractStage *> & stages, bool enabled)
+{
+    std::vector<FusibleStage *> fusible;
+    std::vector<std::vector<FusibleStage *>> chains;
+    std::unordered_map<const AbstractStage *, std::size_t> indices;
+
+    for (auto stage : stages)
+    {
+        auto fusibleStage = dynamic_cast<FusibleStage *>(stage);
+
+        if (!fusibleStage)
+            continue;
+
+        std::vector<FusibleStage *> chain;
+
+        // Chains are only extended at their tail, so the producer is always the tail of its chain
+        const auto data = fusibleStage->source.connectedData();
+        const auto producer = enabled && data ? indices.find(data->owner()) : indices.end();
+
+        if (producer != indices.end() && data == &fusible[producer->second]->target && data->consumers().size() == 1
+            && fusible[producer->second]->m_target.scale() == fusibleStage->m_target.scale())
+        {
+            chain = std::move(chains[producer->second]);
+            chains[producer->second].clear();
+        }
+
+        chain.push_back(fusibleStage);
+
+        indices[fusibleStage] = fusible.size();
+        fusible.push_back(fusibleStage);
+        chains.push_back(std::move(chain));
+    }
+
+    for (std::size_t index = 0; index < fusible.size(); ++index)
+    {
+        fusible[index]->setChain(chains[index]);
+
+        for (auto member : chains[index])
+        {
+            member->setFusedInto(member != fusible[index] ? fusible[index] : nullptr);
+        }
+    }
+}
+
+std::string FusibleStage::fragmentShaderSource(const std::vector<FusibleStage *> & chain)
+{
+    std::stringstream source;
+
+    source << R"(#version 140
+#extension GL_ARB_explicit_attrib_location : require
+
+uniform sampler2D source;
+
+layout (location = 0) out vec4 fragColor;
+
+in vec2 v_uv;
+)";
+
+    for (std::size_t position = 0; position < chain.size(); ++position)
+    {
+        const auto prefix = FusibleStage::prefix(position);
+
+        source << std::endl
+               << "// " << chain[position]->asPrintable() << std::endl
+               << replacePlaceholder(chain[position]->declarations(), prefix) << std::endl
+               << "void " << prefix << "apply(inout vec4 color, in vec2 uv)" << std::endl
+               << "{" << std::endl
+               << replacePlaceholder(chain[position]->snippet(), prefix) << std::endl
+               << "}" << std::endl;
+    }
+
+    source << std::endl
+           << "void main()" << std::endl
+           << "{" << std::endl
+           << "    vec4 color = texture(source, v_uv);" << std::endl;
+
+    for (std::size_t position = 0; position < chain.size(); ++position)
+    {
+        source << "    " << prefix(position) << "apply(color, v_uv);" << std::endl;
+    }
+
+    source << "    fragColor = color;" << std::endl
+           << "}" << std::endl;
+
+    return source.str();
+}
+
+std::string FusibleStage::prefix(std::size_t position)
+{
+    return "s" + std::to_string(position) + "_";
+}
+
+FusibleStage::FusibleStage(const std::string & name, gl::GLenum internalFormat, gl::GLenum format, gl::GLenum type, float scale)
+:   AbstractStage(name)
+,   m_target(internalFormat, format, type, scale)
+,   m_fusedInto(nullptr)
+,   m_chainChanged(true)
+{
+    addInput("source", source);
+    addOutput("target", target);
+
+    addTransientResource(m_target, &target);
+
+    m_chain.push_back(this);
+}
+
+FusibleStage::~FusibleStage()
+{
+}
+
+const std::vector<FusibleStage *> & FusibleStage::chain() const
+{
+    return m_chain;
+}
+
+FusibleStage * FusibleStage::fusedInto() const
+{
+    return m_fusedInto;
+}
+
+const AbstractStage * FusibleStage::processedBy() const
+{
+    return m_fusedInto;
+}
+
+std::string FusibleStage::declarations() const
+{
+    return "";
+}
+
+void FusibleStage::setUniforms(globjects::Program *, const std::string &) const
+{
+}
+
+void FusibleStage::process()
+{
+    if (m_fusedInto)
+    {
+        // Rendered as part of the pass of the tail, which is scheduled through the next stage of the chain
+        invalidateOutputs();
+        return;
+    }
+
+    if (m_chainChanged || !m_quad)
+        createPass();
+
+    // Bound through the cache first, globjects binds the same objects to attach and set uniforms
+    stateCache()->bindFramebuffer(gl::GL_FRAMEBUFFER, m_fbo->id());
+    m_fbo->attachTexture(gl::GL_COLOR_ATTACHMENT0, m_target.texture());
+
+    stateCache()->viewport(0, 0, m_target.size().x, m_target.size().y);
+    stateCache()->disable(gl::GL_DEPTH_TEST);
+    stateCache()->useProgram(m_quad->program()->id());
+
+    for (std::size_t position = 0; position < m_chain.size(); ++position)
+    {
+        m_chain[position]->setUniforms(m_quad->program(), prefix(position));
+    }
+
+    m_quad->setTexture(m_chain.front()->source.data());
+    m_quad->draw(*stateCache());
+
+    target.setData(m_target.texture());
+}
+
+void FusibleStage::setChain(const std::vector<FusibleStage *> & chain)
+{
+    if (chain == m_chain)
+        return;
+
+    m_chain = chain;
+    m_chainChanged = true;
+
+    // The new pass has to be rendered even if no input changed
+    if (!m_chain.empty())
+        scheduleProcess();
+}
+
+void FusibleStage::setFusedInto(FusibleStage * tail)
+{
+    if (tail == m_fusedInto)
+        return;
+
+    // Only tails need a target of their own
+    if (tail && !m_fusedInto)
+        removeTransientResource(m_target);
+    else if (!tail && m_fusedInto)
+        addTransientResource(m_target, &target);
+
+    m_fusedInto = tail;
+}
+
+void FusibleStage::createPass()
+{
+    auto fragmentShaderSource = new globjects::StringTemplate(new globjects::StaticStringSource(FusibleStage::fragmentShaderSource(m_chain)));
+
+#ifdef __APPLE__
+    fragmentShaderSource->replace("#version 140", "#version 150");
+#endif
+
+    m_quad = new ScreenAlignedQuad(new globjects::Shader(gl::GL_FRAGMENT_SHADER, fragmentShaderSource));
+
+    if (!m_fbo)
+    {
+        m_fbo = new globjects::Framebuffer;
+        m_fbo->setDrawBuffers({ gl::GL_COLOR_ATTACHMENT0 });
+    }
+
+    m_chainChanged = false;
+}
+
+} // namespace gloperate
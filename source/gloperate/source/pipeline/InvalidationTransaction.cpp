@@ -0,0 +1,60 @@
+#include <gloperate/pipeline/InvalidationTransaction.h>
+
+#include <gloperate/pipeline/AbstractData.h>
+#include <gloperate/pipeline/AbstractPipeline.h>
+
+
+namespace gloperate
+{
+
+bool InvalidationTransaction::Scope::isActive() const
+{
+    return depth > 0 && thread == std::this_thread::get_id();
+}
+
+InvalidationTransaction::InvalidationTransaction()
+: m_pipeline(nullptr)
+{
+    begin();
+}
+
+InvalidationTransaction::InvalidationTransaction(AbstractPipeline & pipeline)
+: m_pipeline(&pipeline)
+{
+    m_pipeline->beginTransaction();
+}
+
+InvalidationTransaction::~InvalidationTransaction()
+{
+    if (m_pipeline)
+        m_pipeline->commitTransaction();
+    else
+        commit();
+}
+
+void InvalidationTransaction::begin()
+{
+    AbstractData::beginTransaction();
+}
+
+void InvalidationTransaction::commit()
+{
+    AbstractData::commitTransaction();
+}
+
+bool InvalidationTransaction::isActive()
+{
+    return AbstractData::isTransactionActive();
+}
+
+void InvalidationTransaction::detach(Notifications & notifications)
+{
+    AbstractData::detachTransaction(notifications.invalidated, notifications.scheduled);
+}
+
+void InvalidationTransaction::deliver(Notifications & notifications)
+{
+    AbstractData::deliver(notifications.invalidated, notifications.scheduled);
+}
+
+} // namespace gloperate
@@ -0,0 +1,271 @@
+#include <gloperate/pipeline/OutputCache.h>
+
+#include <functional>
+#include <iterator>
+
+#include <gloperate/pipeline/AbstractData.h>
+#include <gloperate/pipeline/DataSnapshot.h>
+
+
+namespace
+{
+
+bool matches(const std::vector<const gloperate::AbstractData *> & inputs, const std::vector<std::shared_ptr<const gloperate::AbstractDataSnapshot>> & snapshots)
+{
+    for (std::size_t i = 0; i < inputs.size(); ++i)
+    {
+        if (!inputs[i] || !snapshots[i])
+        {
+            if (inputs[i] || snapshots[i])
+                return false;
+
+            continue;
+        }
+
+        if (!inputs[i]->equals(*snapshots[i]))
+            return false;
+    }
+
+    return true;
+}
+
+} // namespace
+
+
+namespace gloperate
+{
+
+OutputCache::OutputCache(std::size_t budget)
+:   m_budget(budget)
+,   m_statistics{0, 0, 0, 0, 0, 0}
+{
+}
+
+OutputCache::~OutputCache()
+{
+}
+
+std::size_t OutputCache::budget() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_budget;
+}
+
+void OutputCache::setBudget(std::size_t budget)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_budget = budget;
+    evict(m_budget);
+}
+
+OutputCache::Statistics OutputCache::statistics() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_statistics;
+}
+
+void OutputCache::resetStatistics()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_statistics.hits = 0;
+    m_statistics.misses = 0;
+    m_statistics.uncacheable = 0;
+    m_statistics.evictions = 0;
+}
+
+void OutputCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_entries.clear();
+    m_index.clear();
+
+    m_statistics.entries = 0;
+    m_statistics.bytes = 0;
+}
+
+void OutputCache::remove(const AbstractStage * stage)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (auto it = m_entries.begin(); it != m_entries.end(); )
+    {
+        auto entry = it++;
+
+        if (entry->stage == stage)
+            erase(entry);
+    }
+}
+
+bool OutputCache::restore(const AbstractStage * stage, const Key & key, const std::vector<const AbstractData *> & inputs, const std::vector<AbstractData *> & outputs)
+{
+    const auto hash = hashKey(stage, key);
+
+    // The snapshots are shared with the entry, so it may be evicted meanwhile
+    Snapshots inputSnapshots;
+    Snapshots outputSnapshots;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto entry = find(stage, key, hash);
+
+        if (entry == m_entries.end() || entry->inputs.size() != inputs.size() || entry->outputs.size() != outputs.size())
+        {
+            ++m_statistics.misses;
+            return false;
+        }
+
+        inputSnapshots = entry->inputs;
+        outputSnapshots = entry->outputs;
+
+        m_entries.splice(m_entries.begin(), m_entries, entry);
+    }
+
+    // Restoring invalidates the outputs and thereby calls into the pipeline, which must not happen under the lock
+    bool hit = matches(inputs, inputSnapshots);
+
+    for (std::size_t i = 0; hit && i < outputs.size(); ++i)
+    {
+        hit = outputs[i]->restore(*outputSnapshots[i]);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (hit)
+    {
+        ++m_statistics.hits;
+        return true;
+    }
+
+    // Hash collision or outputs of changed types, the entry is of no use anymore
+    auto entry = find(stage, key, hash);
+
+    if (entry != m_entries.end() && entry->outputs == outputSnapshots)
+        erase(entry);
+
+    ++m_statistics.misses;
+    return false;
+}
+
+void OutputCache::store(const AbstractStage * stage, Key key, const std::vector<const AbstractData *> & inputs, const std::vector<AbstractData *> & outputs)
+{
+    Entry entry;
+    entry.stage = stage;
+    entry.hash = hashKey(stage, key);
+    entry.key = std::move(key);
+    entry.bytes = 0;
+
+    for (auto input : inputs)
+    {
+        std::shared_ptr<const AbstractDataSnapshot> snapshot = input ? input->snapshot() : nullptr;
+
+        if (input && !snapshot)
+        {
+            countUncacheable();
+            return;
+        }
+
+        entry.bytes += snapshot ? snapshot->size() : 0;
+        entry.inputs.push_back(std::move(snapshot));
+    }
+
+    for (auto output : outputs)
+    {
+        std::shared_ptr<const AbstractDataSnapshot> snapshot = output->snapshot();
+
+        if (!snapshot)
+        {
+            countUncacheable();
+            return;
+        }
+
+        entry.bytes += snapshot->size();
+        entry.outputs.push_back(std::move(snapshot));
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (entry.bytes > m_budget)
+        return;
+
+    auto existing = find(stage, entry.key, entry.hash);
+
+    if (existing != m_entries.end())
+        erase(existing);
+
+    evict(m_budget - entry.bytes);
+
+    m_statistics.bytes += entry.bytes;
+    ++m_statistics.entries;
+
+    m_entries.push_front(std::move(entry));
+    m_index.emplace(m_entries.front().hash, m_entries.begin());
+}
+
+void OutputCache::countUncacheable()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    ++m_statistics.uncacheable;
+}
+
+std::size_t OutputCache::hashKey(const AbstractStage * stage, const Key & key)
+{
+    auto hash = std::hash<const AbstractStage *>()(stage);
+
+    for (auto value : key)
+    {
+        // Combine as in boost::hash_combine
+        hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+
+    return hash;
+}
+
+OutputCache::EntryList::iterator OutputCache::find(const AbstractStage * stage, const Key & key, std::size_t hash)
+{
+    const auto range = m_index.equal_range(hash);
+
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it->second->stage == stage && it->second->key == key)
+            return it->second;
+    }
+
+    return m_entries.end();
+}
+
+void OutputCache::erase(EntryList::iterator entry)
+{
+    const auto range = m_index.equal_range(entry->hash);
+
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it->second == entry)
+        {
+            m_index.erase(it);
+            break;
+        }
+    }
+
+    m_statistics.bytes -= entry->bytes;
+    --m_statistics.entries;
+
+    m_entries.erase(entry);
+}
+
+void OutputCache::evict(std::size_t budget)
+{
+    while (!m_entries.empty() && m_statistics.bytes > budget)
+    {
+        erase(std::prev(m_entries.end()));
+        ++m_statistics.evictions;
+    }
+}
+
+} // namespace gloperate
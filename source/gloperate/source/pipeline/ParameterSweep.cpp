@@ -0,0 +1,77 @@
+#include <gloperate/pipeline/ParameterSweep.h>
+
+#include <limits>
+
+#include <gloperate/pipeline/InvalidationTransaction.h>
+
+
+namespace gloperate
+{
+
+const std::size_t ParameterSweep::npos = std::numeric_limits<std::size_t>::max();
+
+ParameterSweep::ParameterSweep()
+{
+}
+
+ParameterSweep::~ParameterSweep()
+{
+}
+
+std::size_t ParameterSweep::size() const
+{
+    if (m_dimensions.empty())
+        return 0;
+
+    return m_dimensions.front().stride * m_dimensions.front().numValues;
+}
+
+std::size_t ParameterSweep::numParameters() const
+{
+    return m_dimensions.size();
+}
+
+const std::string & ParameterSweep::parameterName(std::size_t parameter) const
+{
+    return m_dimensions[parameter].name;
+}
+
+std::size_t ParameterSweep::valueIndex(std::size_t combination, std::size_t parameter) const
+{
+    const auto & dimension = m_dimensions[parameter];
+
+    return (combination / dimension.stride) % dimension.numValues;
+}
+
+bool ParameterSweep::apply(std::size_t combination, AbstractPipeline & pipeline, std::size_t previous) const
+{
+    // Stages depending on several swept parameters are scheduled once
+    InvalidationTransaction transaction(pipeline);
+
+    bool applied = true;
+
+    for (std::size_t parameter = 0; parameter < m_dimensions.size(); ++parameter)
+    {
+        const auto index = valueIndex(combination, parameter);
+
+        if (previous != npos && valueIndex(previous, parameter) == index)
+            continue;
+
+        applied = m_dimensions[parameter].apply(pipeline, index) && applied;
+    }
+
+    return applied;
+}
+
+void ParameterSweep::addDimension(const std::string & name, std::size_t numValues, std::function<bool(AbstractPipeline &, std::size_t)> apply)
+{
+    // The new parameter varies fastest, so the existing ones advance slower by its value count
+    for (auto & dimension : m_dimensions)
+    {
+        dimension.stride *= numValues;
+    }
+
+    m_dimensions.push_back({ name, numValues, 1, std::move(apply) });
+}
+
+} // namespace gloperate
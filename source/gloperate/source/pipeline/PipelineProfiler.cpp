@@ -0,0 +1,451 @@
+#include <gloperate/pipeline/PipelineProfiler.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <ostream>
+
+#include <glbinding/gl/enum.h>
+#include <glbinding/gl/functions.h>
+#include <glbinding/gl/types.h>
+
+#include <gloperate/pipeline/AbstractStage.h>
+
+
+namespace
+{
+
+double toMilliseconds(gloperate::ChronoTimer::Duration duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+double toMicroseconds(gloperate::ChronoTimer::Duration duration)
+{
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+std::string escapeJson(const std::string & string)
+{
+    std::string escaped;
+    escaped.reserve(string.size());
+
+    for (auto character : string)
+    {
+        if (character == '"' || character == '\\')
+            escaped.push_back('\\');
+
+        escaped.push_back(character);
+    }
+
+    return escaped;
+}
+
+} // namespace
+
+
+namespace gloperate
+{
+
+const std::size_t PipelineProfiler::numQuerySlots;
+
+void PipelineProfiler::Samples::add(double value, std::size_t capacity)
+{
+    if (values.size() < capacity)
+    {
+        values.push_back(value);
+        return;
+    }
+
+    values[next] = value;
+    next = (next + 1) % capacity;
+}
+
+PipelineProfiler::Statistics PipelineProfiler::Samples::statistics() const
+{
+    Statistics statistics = { values.size(), 0.0, 0.0, 0.0 };
+
+    if (values.empty())
+        return statistics;
+
+    auto sorted = values;
+    std::sort(sorted.begin(), sorted.end());
+
+    double sum = 0.0;
+    for (auto value : sorted)
+        sum += value;
+
+    // Nearest-rank percentile
+    const auto rank = static_cast<std::size_t>(std::ceil(0.95 * static_cast<double>(sorted.size())));
+
+    statistics.min = sorted.front();
+    statistics.average = sum / static_cast<double>(sorted.size());
+    statistics.p95 = sorted[std::max<std::size_t>(rank, 1) - 1];
+
+    return statistics;
+}
+
+PipelineProfiler::PipelineProfiler(std::size_t numFrames)
+:   m_numFrames(std::max(numFrames, numQuerySlots))
+,   m_gpuTimingEnabled(false)
+,   m_epoch(clock::now())
+,   m_frameStart(m_epoch)
+,   m_frameNumber(0)
+,   m_inFrame(false)
+,   m_frames(m_numFrames)
+{
+    for (auto & frame : m_frames)
+    {
+        frame.number = 0;
+        frame.start = ChronoTimer::Duration::zero();
+        frame.duration = ChronoTimer::Duration::zero();
+    }
+
+    for (auto & slot : m_querySlots)
+    {
+        slot.frame = 0;
+        slot.pending = false;
+    }
+}
+
+PipelineProfiler::~PipelineProfiler()
+{
+    releaseQueries();
+}
+
+std::size_t PipelineProfiler::numFrames() const
+{
+    return m_numFrames;
+}
+
+bool PipelineProfiler::isGpuTimingEnabled() const
+{
+    return m_gpuTimingEnabled;
+}
+
+void PipelineProfiler::setGpuTimingEnabled(bool enabled)
+{
+    if (m_gpuTimingEnabled == enabled)
+        return;
+
+    m_gpuTimingEnabled = enabled;
+
+    if (!m_gpuTimingEnabled)
+        releaseQueries();
+}
+
+void PipelineProfiler::addStage(const AbstractStage * stage)
+{
+    StageRecord record;
+    record.stage = stage;
+    record.frame = 0;
+    record.queried = false;
+    record.event.stage = m_stages.size();
+    record.event.start = ChronoTimer::Duration::zero();
+    record.event.duration = ChronoTimer::Duration::zero();
+    record.cpuSamples.next = 0;
+    record.gpuSamples.next = 0;
+
+    m_stages.push_back(record);
+}
+
+std::size_t PipelineProfiler::numStages() const
+{
+    return m_stages.size();
+}
+
+void PipelineProfiler::beginFrame()
+{
+    ++m_frameNumber;
+    m_frameStart = clock::now();
+    m_inFrame = true;
+
+    if (m_gpuTimingEnabled)
+    {
+        QuerySlot & slot = m_querySlots[m_frameNumber % numQuerySlots];
+
+        // The slot was last used numQuerySlots frames ago, its results are likely available by now
+        if (slot.pending)
+            resolveQueries(slot);
+
+        const auto numQueries = 2 * m_stages.size();
+
+        if (slot.queries.size() < numQueries)
+        {
+            const auto numGenerated = slot.queries.size();
+
+            slot.queries.resize(numQueries);
+            gl::glGenQueries(static_cast<gl::GLsizei>(numQueries - numGenerated), &slot.queries[numGenerated]);
+        }
+
+        slot.frame = m_frameNumber;
+        slot.issued.assign(m_stages.size(), false);
+    }
+
+    Frame & frame = m_frames[m_frameNumber % m_numFrames];
+    frame.number = m_frameNumber;
+    frame.start = m_frameStart - m_epoch;
+    frame.duration = ChronoTimer::Duration::zero();
+    frame.cpuEvents.clear();
+    frame.gpuEvents.clear();
+}
+
+void PipelineProfiler::endFrame()
+{
+    if (!m_inFrame)
+        return;
+
+    Frame & frame = m_frames[m_frameNumber % m_numFrames];
+    frame.duration = clock::now() - m_frameStart;
+
+    // Stage records are written by the threads executing the stages, collecting them is deferred until all have finished
+    for (const auto & record : m_stages)
+    {
+        if (record.frame == m_frameNumber)
+            frame.cpuEvents.push_back(record.event);
+    }
+
+    m_inFrame = false;
+}
+
+void PipelineProfiler::beginStage(std::size_t index, bool contextThread)
+{
+    StageRecord & record = m_stages[index];
+
+    record.event.thread = std::this_thread::get_id();
+    record.event.start = clock::now() - m_frameStart;
+    record.queried = false;
+
+    if (m_gpuTimingEnabled && contextThread)
+    {
+        QuerySlot & slot = m_querySlots[m_frameNumber % numQuerySlots];
+
+        gl::glQueryCounter(slot.queries[2 * index], gl::GL_TIMESTAMP);
+        record.queried = true;
+    }
+}
+
+void PipelineProfiler::endStage(std::size_t index, bool processed)
+{
+    const ChronoTimer::Duration end = clock::now() - m_frameStart;
+
+    StageRecord & record = m_stages[index];
+
+    if (record.queried)
+    {
+        QuerySlot & slot = m_querySlots[m_frameNumber % numQuerySlots];
+
+        gl::glQueryCounter(slot.queries[2 * index + 1], gl::GL_TIMESTAMP);
+
+        slot.issued[index] = processed;
+        slot.pending = slot.pending || processed;
+    }
+
+    // Skipped stages did not do any work worth recording
+    if (!processed)
+        return;
+
+    record.event.duration = end - record.event.start;
+    record.frame = m_frameNumber;
+    record.cpuSamples.add(toMilliseconds(record.event.duration), m_numFrames);
+}
+
+PipelineProfiler::StageStatistics PipelineProfiler::statistics(std::size_t index) const
+{
+    const StageRecord & record = m_stages[index];
+
+    StageStatistics statistics;
+    statistics.stage = record.stage;
+    statistics.cpu = record.cpuSamples.statistics();
+    statistics.gpu = record.gpuSamples.statistics();
+
+    return statistics;
+}
+
+std::vector<PipelineProfiler::StageStatistics> PipelineProfiler::statistics() const
+{
+    std::vector<StageStatistics> result;
+    result.reserve(m_stages.size());
+
+    for (std::size_t index = 0; index < m_stages.size(); ++index)
+    {
+        result.push_back(statistics(index));
+    }
+
+    return result;
+}
+
+void PipelineProfiler::writeChromeTrace(std::ostream & stream) const
+{
+    const int pid = 1;
+    const int frameTid = 0;
+    const int gpuTid = 1;
+
+    std::vector<std::thread::id> threads;
+
+    const auto tidOf = [&threads](std::thread::id thread)
+    {
+        auto it = std::find(threads.begin(), threads.end(), thread);
+
+        if (it == threads.end())
+            it = threads.insert(threads.end(), thread);
+
+        // CPU threads follow the frame and GPU tracks
+        return static_cast<int>(it - threads.begin()) + 2;
+    };
+
+    auto first = true;
+
+    const auto writeEvent = [&stream, &first, pid](const std::string & name, const char * category, int tid, ChronoTimer::Duration start, ChronoTimer::Duration duration)
+    {
+        stream << (first ? "" : ",") << "\n{\"name\":\"" << escapeJson(name) << "\",\"cat\":\"" << category
+               << "\",\"ph\":\"X\",\"pid\":" << pid << ",\"tid\":" << tid
+               << ",\"ts\":" << toMicroseconds(start) << ",\"dur\":" << toMicroseconds(duration) << "}";
+
+        first = false;
+    };
+
+    stream << "{\"traceEvents\":[";
+
+    // Oldest frame first
+    for (std::size_t offset = 1; offset <= m_numFrames; ++offset)
+    {
+        const Frame & frame = m_frames[(m_frameNumber + offset) % m_numFrames];
+
+        if (frame.number == 0)
+            continue;
+
+        writeEvent("Frame " + std::to_string(frame.number), "frame", frameTid, frame.start, frame.duration);
+
+        for (const auto & event : frame.cpuEvents)
+            writeEvent(stageName(event.stage), "cpu", tidOf(event.thread), frame.start + event.start, event.duration);
+
+        for (const auto & event : frame.gpuEvents)
+            writeEvent(stageName(event.stage), "gpu", gpuTid, frame.start + event.start, event.duration);
+    }
+
+    const auto writeThreadName = [&stream, pid](int tid, const std::string & name)
+    {
+        stream << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << tid
+               << ",\"args\":{\"name\":\"" << name << "\"}}";
+    };
+
+    if (!first)
+    {
+        writeThreadName(frameTid, "Frames");
+        writeThreadName(gpuTid, "GPU");
+
+        for (std::size_t index = 0; index < threads.size(); ++index)
+            writeThreadName(static_cast<int>(index) + 2, "Thread " + std::to_string(index));
+    }
+
+    stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+bool PipelineProfiler::saveChromeTrace(const std::string & filename) const
+{
+    std::ofstream stream(filename);
+
+    if (!stream)
+        return false;
+
+    writeChromeTrace(stream);
+
+    return stream.good();
+}
+
+void PipelineProfiler::clear()
+{
+    for (auto & record : m_stages)
+    {
+        record.frame = 0;
+        record.cpuSamples.values.clear();
+        record.cpuSamples.next = 0;
+        record.gpuSamples.values.clear();
+        record.gpuSamples.next = 0;
+    }
+
+    for (auto & frame : m_frames)
+    {
+        frame.number = 0;
+        frame.cpuEvents.clear();
+        frame.gpuEvents.clear();
+    }
+}
+
+void PipelineProfiler::resolveQueries(QuerySlot & slot)
+{
+    slot.pending = false;
+
+    Frame & frame = m_frames[slot.frame % m_numFrames];
+    const auto frameRecorded = frame.number == slot.frame;
+
+    gl::GLuint64 frameBegin = std::numeric_limits<gl::GLuint64>::max();
+
+    const auto numStages = std::min(slot.issued.size(), m_stages.size());
+
+    for (std::size_t index = 0; index < numStages; ++index)
+    {
+        if (!slot.issued[index])
+            continue;
+
+        // Never wait for the GPU, results that are not there yet are dropped
+        gl::GLint available = 0;
+        gl::glGetQueryObjectiv(slot.queries[2 * index + 1], gl::GL_QUERY_RESULT_AVAILABLE, &available);
+
+        if (!available)
+            continue;
+
+        gl::GLuint64 begin = 0;
+        gl::GLuint64 end = 0;
+        gl::glGetQueryObjectui64v(slot.queries[2 * index], gl::GL_QUERY_RESULT, &begin);
+        gl::glGetQueryObjectui64v(slot.queries[2 * index + 1], gl::GL_QUERY_RESULT, &end);
+
+        const ChronoTimer::Duration duration(static_cast<long long>(end - begin));
+
+        m_stages[index].gpuSamples.add(toMilliseconds(duration), m_numFrames);
+
+        if (!frameRecorded)
+            continue;
+
+        Event event;
+        event.stage = index;
+        event.start = ChronoTimer::Duration(static_cast<long long>(begin));
+        event.duration = duration;
+
+        frame.gpuEvents.push_back(event);
+        frameBegin = std::min(frameBegin, begin);
+    }
+
+    if (!frameRecorded)
+        return;
+
+    // GPU timestamps use their own time base, the first query of the frame is placed at the frame start
+    for (auto & event : frame.gpuEvents)
+    {
+        event.start -= ChronoTimer::Duration(static_cast<long long>(frameBegin));
+    }
+}
+
+void PipelineProfiler::releaseQueries()
+{
+    for (auto & slot : m_querySlots)
+    {
+        if (!slot.queries.empty())
+            gl::glDeleteQueries(static_cast<gl::GLsizei>(slot.queries.size()), slot.queries.data());
+
+        slot.queries.clear();
+        slot.issued.clear();
+        slot.pending = false;
+    }
+}
+
+std::string PipelineProfiler::stageName(std::size_t index) const
+{
+    const AbstractStage * stage = m_stages[index].stage;
+
+    return stage->hasName() ? stage->asPrintable() : "stage" + std::to_string(index);
+}
+
+} // namespace gloperate
@@ -0,0 +1,16 @@
+#include <gloperate/pipeline/Shared.h>
+
+#include <atomic>
+
+
+namespace gloperate
+{
+
+std::uint64_t nextSharedVersion()
+{
+    static std::atomic<std::uint64_t> version(0);
+
+    return ++version;
+}
+
+} // namespace gloperate
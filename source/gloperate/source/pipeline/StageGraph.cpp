@@ -0,0 +1,415 @@
+#include <gloperate/pipeline/StageGraph.h>
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+
+#include <gloperate/pipeline/AbstractStage.h>
+
+
+namespace gloperate
+{
+
+const std::size_t StageGraph::npos = static_cast<std::size_t>(-1);
+
+StageGraph::StageGraph()
+:   m_built(true)
+,   m_sorted(true)
+,   m_orderDirty(false)
+{
+}
+
+StageGraph::~StageGraph()
+{
+}
+
+void StageGraph::clear()
+{
+    m_nodes.clear();
+    m_indices.clear();
+    m_order.clear();
+    m_positions.clear();
+    m_cyclic.clear();
+
+    m_built = true;
+    m_sorted = true;
+    m_orderDirty = false;
+}
+
+void StageGraph::addStage(AbstractStage * stage)
+{
+    if (m_indices.count(stage) > 0)
+        return;
+
+    m_indices[stage] = m_nodes.size();
+
+    Node node;
+    node.stage = stage;
+    m_nodes.push_back(node);
+
+    // Dependencies may point to stages that are added later, so edges are resolved on sort()
+    m_built = false;
+    m_sorted = false;
+    m_orderDirty = true;
+}
+
+std::size_t StageGraph::size() const
+{
+    return m_nodes.size();
+}
+
+std::size_t StageGraph::indexOf(const AbstractStage * stage) const
+{
+    auto it = m_indices.find(stage);
+
+    return it != m_indices.end() ? it->second : npos;
+}
+
+AbstractStage * StageGraph::stage(std::size_t index) const
+{
+    return m_nodes[index].stage;
+}
+
+const std::vector<std::size_t> & StageGraph::predecessors(std::size_t index) const
+{
+    return m_nodes[index].predecessors;
+}
+
+const std::vector<std::size_t> & StageGraph::successors(std::size_t index) const
+{
+    return m_nodes[index].successors;
+}
+
+bool StageGraph::updateStage(const AbstractStage * stage)
+{
+    const auto index = indexOf(stage);
+
+    if (index == npos)
+        return false;
+
+    if (!m_built)
+        return true;
+
+    std::vector<std::size_t> predecessors;
+    collectPredecessors(index, predecessors);
+
+    Node & node = m_nodes[index];
+
+    if (predecessors == node.predecessors)
+        return false;
+
+    std::vector<std::size_t> removed;
+    std::vector<std::size_t> added;
+
+    std::set_difference(node.predecessors.begin(), node.predecessors.end(), predecessors.begin(), predecessors.end(), std::back_inserter(removed));
+    std::set_difference(predecessors.begin(), predecessors.end(), node.predecessors.begin(), node.predecessors.end(), std::back_inserter(added));
+
+    for (auto predecessor : removed)
+    {
+        auto & successors = m_nodes[predecessor].successors;
+        successors.erase(std::find(successors.begin(), successors.end(), index));
+    }
+
+    for (auto predecessor : added)
+    {
+        m_nodes[predecessor].successors.push_back(index);
+    }
+
+    node.predecessors.swap(predecessors);
+
+    if (!m_sorted)
+    {
+        // The change might have resolved a cycle, only a full sort can tell
+        m_orderDirty = true;
+        return true;
+    }
+
+    // Removing edges keeps the order valid, only added edges pointing backwards have to be repaired
+    for (auto predecessor : added)
+    {
+        if (m_positions[predecessor] < m_positions[index])
+            continue;
+
+        if (!reorder(predecessor, index))
+        {
+            m_sorted = false;
+            m_orderDirty = true;
+            break;
+        }
+    }
+
+    return true;
+}
+
+bool StageGraph::isSorted() const
+{
+    return m_sorted;
+}
+
+bool StageGraph::sort()
+{
+    if (!m_orderDirty)
+        return m_sorted;
+
+    if (!m_built)
+        build();
+
+    const auto numNodes = m_nodes.size();
+
+    std::vector<std::size_t> inDegrees(numNodes);
+
+    m_order.clear();
+    m_order.reserve(numNodes);
+
+    for (std::size_t index = 0; index < numNodes; ++index)
+    {
+        inDegrees[index] = m_nodes[index].predecessors.size();
+
+        if (inDegrees[index] == 0)
+            m_order.push_back(index);
+    }
+
+    // m_order doubles as the queue of stages whose dependencies are all placed
+    for (std::size_t head = 0; head < m_order.size(); ++head)
+    {
+        for (auto successor : m_nodes[m_order[head]].successors)
+        {
+            if (--inDegrees[successor] == 0)
+                m_order.push_back(successor);
+        }
+    }
+
+    m_sorted = m_order.size() == numNodes;
+    m_orderDirty = false;
+    m_cyclic.clear();
+
+    if (!m_sorted)
+    {
+        findCycles(inDegrees);
+
+        for (std::size_t index = 0; index < numNodes; ++index)
+        {
+            if (inDegrees[index] > 0)
+                m_order.push_back(index);
+        }
+
+        std::cerr << "Pipeline is not a directed acyclic graph, cyclic stages:";
+        for (auto index : m_cyclic)
+            std::cerr << " " << m_nodes[index].stage->asPrintable();
+        std::cerr << std::endl;
+    }
+
+    m_positions.resize(numNodes);
+
+    for (std::size_t position = 0; position < numNodes; ++position)
+    {
+        m_positions[m_order[position]] = position;
+    }
+
+    return m_sorted;
+}
+
+const std::vector<std::size_t> & StageGraph::order() const
+{
+    return m_order;
+}
+
+std::size_t StageGraph::position(std::size_t index) const
+{
+    return m_positions[index];
+}
+
+std::vector<AbstractStage *> StageGraph::sortedStages() const
+{
+    std::vector<AbstractStage *> stages;
+    stages.reserve(m_order.size());
+
+    for (auto index : m_order)
+    {
+        stages.push_back(m_nodes[index].stage);
+    }
+
+    return stages;
+}
+
+std::vector<AbstractStage *> StageGraph::cyclicStages() const
+{
+    std::vector<AbstractStage *> stages;
+
+    for (auto index : m_cyclic)
+    {
+        stages.push_back(m_nodes[index].stage);
+    }
+
+    return stages;
+}
+
+void StageGraph::build()
+{
+    for (auto & node : m_nodes)
+    {
+        node.successors.clear();
+    }
+
+    for (std::size_t index = 0; index < m_nodes.size(); ++index)
+    {
+        collectPredecessors(index, m_nodes[index].predecessors);
+
+        for (auto predecessor : m_nodes[index].predecessors)
+        {
+            m_nodes[predecessor].successors.push_back(index);
+        }
+    }
+
+    m_built = true;
+}
+
+void StageGraph::collectPredecessors(std::size_t index, std::vector<std::size_t> & predecessors) const
+{
+    predecessors.clear();
+
+    for (auto dependency : m_nodes[index].stage->dependencies())
+    {
+        const auto predecessor = indexOf(dependency);
+
+        // Dependencies on stages outside of the graph do not constrain the order
+        if (predecessor != npos)
+            predecessors.push_back(predecessor);
+    }
+
+    std::sort(predecessors.begin(), predecessors.end());
+    predecessors.erase(std::unique(predecessors.begin(), predecessors.end()), predecessors.end());
+}
+
+bool StageGraph::reorder(std::size_t from, std::size_t to)
+{
+    // Pearce-Kelly: only stages positioned between 'to' and 'from' can be affected by the new edge
+    const auto lower = m_positions[to];
+    const auto upper = m_positions[from];
+
+    std::vector<std::size_t> forward;
+    std::vector<std::size_t> backward;
+    std::vector<std::size_t> stack;
+    std::unordered_map<std::size_t, bool> visited;
+
+    stack.push_back(to);
+    visited[to] = true;
+
+    while (!stack.empty())
+    {
+        const auto index = stack.back();
+        stack.pop_back();
+        forward.push_back(index);
+
+        for (auto successor : m_nodes[index].successors)
+        {
+            if (successor == from)
+                return false;
+
+            if (m_positions[successor] < upper && !visited[successor])
+            {
+                visited[successor] = true;
+                stack.push_back(successor);
+            }
+        }
+    }
+
+    stack.push_back(from);
+    visited[from] = true;
+
+    while (!stack.empty())
+    {
+        const auto index = stack.back();
+        stack.pop_back();
+        backward.push_back(index);
+
+        for (auto predecessor : m_nodes[index].predecessors)
+        {
+            if (m_positions[predecessor] > lower && !visited[predecessor])
+            {
+                visited[predecessor] = true;
+                stack.push_back(predecessor);
+            }
+        }
+    }
+
+    const auto byPosition = [this](std::size_t lhs, std::size_t rhs) { return m_positions[lhs] < m_positions[rhs]; };
+
+    std::sort(forward.begin(), forward.end(), byPosition);
+    std::sort(backward.begin(), backward.end(), byPosition);
+
+    std::vector<std::size_t> positions;
+    positions.reserve(forward.size() + backward.size());
+
+    for (auto index : backward)
+        positions.push_back(m_positions[index]);
+    for (auto index : forward)
+        positions.push_back(m_positions[index]);
+
+    std::sort(positions.begin(), positions.end());
+
+    // Everything that leads to 'from' is placed before everything reachable from 'to'
+    auto position = positions.begin();
+
+    for (auto index : backward)
+    {
+        m_positions[index] = *position;
+        m_order[*position++] = index;
+    }
+
+    for (auto index : forward)
+    {
+        m_positions[index] = *position;
+        m_order[*position++] = index;
+    }
+
+    return true;
+}
+
+void StageGraph::findCycles(const std::vector<std::size_t> & inDegrees)
+{
+    // Stages left over by Kahn's algorithm are on a cycle or downstream of one.
+    // Peeling off those without left over successors leaves the cycles and the paths between them.
+    const auto numNodes = m_nodes.size();
+
+    std::vector<std::size_t> outDegrees(numNodes, 0);
+    std::vector<std::size_t> peel;
+
+    for (std::size_t index = 0; index < numNodes; ++index)
+    {
+        if (inDegrees[index] == 0)
+            continue;
+
+        for (auto successor : m_nodes[index].successors)
+        {
+            if (inDegrees[successor] > 0)
+                ++outDegrees[index];
+        }
+
+        if (outDegrees[index] == 0)
+            peel.push_back(index);
+    }
+
+    std::vector<bool> peeled(numNodes, false);
+
+    while (!peel.empty())
+    {
+        const auto index = peel.back();
+        peel.pop_back();
+        peeled[index] = true;
+
+        for (auto predecessor : m_nodes[index].predecessors)
+        {
+            if (inDegrees[predecessor] > 0 && --outDegrees[predecessor] == 0)
+                peel.push_back(predecessor);
+        }
+    }
+
+    for (std::size_t index = 0; index < numNodes; ++index)
+    {
+        if (inDegrees[index] > 0 && !peeled[index])
+            m_cyclic.push_back(index);
+    }
+}
+
+} // namespace gloperate
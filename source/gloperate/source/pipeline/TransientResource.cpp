@@ -0,0 +1,134 @@
+#include <gloperate/pipeline/TransientResource.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <glbinding/gl/enum.h>
+
+#include <globjects/Texture.h>
+#include <globjects/Renderbuffer.h>
+
+#include <gloperate/pipeline/TransientResourcePool.h>
+
+
+namespace gloperate
+{
+
+TransientResource::TransientResource(gl::GLenum internalFormat, float scale)
+:   m_type(Type::Renderbuffer)
+,   m_internalFormat(internalFormat)
+,   m_format(gl::GL_NONE)
+,   m_dataType(gl::GL_NONE)
+,   m_scale(scale)
+,   m_fixedSize(0, 0)
+,   m_owner(nullptr)
+,   m_exportedAs(nullptr)
+,   m_slot(TransientResourcePool::npos)
+,   m_size(0, 0)
+{
+}
+
+TransientResource::TransientResource(gl::GLenum internalFormat, gl::GLenum format, gl::GLenum type, float scale)
+:   m_type(Type::Texture)
+,   m_internalFormat(internalFormat)
+,   m_format(format)
+,   m_dataType(type)
+,   m_scale(scale)
+,   m_fixedSize(0, 0)
+,   m_owner(nullptr)
+,   m_exportedAs(nullptr)
+,   m_slot(TransientResourcePool::npos)
+,   m_size(0, 0)
+{
+}
+
+TransientResource::~TransientResource()
+{
+}
+
+TransientResource::Type TransientResource::type() const
+{
+    return m_type;
+}
+
+gl::GLenum TransientResource::internalFormat() const
+{
+    return m_internalFormat;
+}
+
+gl::GLenum TransientResource::format() const
+{
+    return m_format;
+}
+
+gl::GLenum TransientResource::dataType() const
+{
+    return m_dataType;
+}
+
+float TransientResource::scale() const
+{
+    return m_scale;
+}
+
+const glm::ivec2 & TransientResource::fixedSize() const
+{
+    return m_fixedSize;
+}
+
+void TransientResource::setFixedSize(const glm::ivec2 & size)
+{
+    m_fixedSize = size;
+}
+
+glm::ivec2 TransientResource::sizeFor(const glm::ivec2 & viewport) const
+{
+    if (m_fixedSize.x > 0 && m_fixedSize.y > 0)
+        return m_fixedSize;
+
+    return glm::ivec2(
+        std::max(1, static_cast<int>(std::lround(viewport.x * m_scale))),
+        std::max(1, static_cast<int>(std::lround(viewport.y * m_scale))));
+}
+
+bool TransientResource::isCompatible(const TransientResource & other) const
+{
+    return m_type == other.m_type
+        && m_internalFormat == other.m_internalFormat
+        && m_format == other.m_format
+        && m_dataType == other.m_dataType
+        && m_scale == other.m_scale
+        && m_fixedSize == other.m_fixedSize;
+}
+
+AbstractStage * TransientResource::owner() const
+{
+    return m_owner;
+}
+
+const AbstractData * TransientResource::exportedAs() const
+{
+    return m_exportedAs;
+}
+
+std::size_t TransientResource::slot() const
+{
+    return m_slot;
+}
+
+const glm::ivec2 & TransientResource::size() const
+{
+    return m_size;
+}
+
+globjects::Texture * TransientResource::texture() const
+{
+    return m_texture;
+}
+
+globjects::Renderbuffer * TransientResource::renderbuffer() const
+{
+    return m_renderbuffer;
+}
+
+} // namespace gloperate
@@ -0,0 +1,314 @@
+#include <gloperate/pipeline/TransientResourcePool.h>
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+#include <glbinding/gl/enum.h>
+
+#include <globjects/Texture.h>
+#include <globjects/Renderbuffer.h>
+
+#include <gloperate/pipeline/AbstractData.h>
+#include <gloperate/pipeline/AbstractInputSlot.h>
+#include <gloperate/pipeline/AbstractStage.h>
+#include <gloperate/pipeline/StageGraph.h>
+#include <gloperate/pipeline/TransientResource.h>
+
+
+namespace gloperate
+{
+
+const std::size_t TransientResourcePool::npos = std::numeric_limits<std::size_t>::max();
+
+TransientResourcePool::Description::Description(const TransientResource & resource)
+:   type(resource.type())
+,   internalFormat(resource.internalFormat())
+,   format(resource.format())
+,   dataType(resource.dataType())
+,   scale(resource.scale())
+,   fixedSize(resource.fixedSize())
+{
+}
+
+bool TransientResourcePool::Description::operator==(const Description & other) const
+{
+    return type == other.type
+        && internalFormat == other.internalFormat
+        && format == other.format
+        && dataType == other.dataType
+        && scale == other.scale
+        && fixedSize == other.fixedSize;
+}
+
+TransientResourcePool::TransientResourcePool()
+:   m_viewport(0, 0)
+,   m_aliasing(true)
+,   m_planned(false)
+,   m_allocations(0)
+{
+}
+
+TransientResourcePool::~TransientResourcePool()
+{
+}
+
+const glm::ivec2 & TransientResourcePool::viewport() const
+{
+    return m_viewport;
+}
+
+void TransientResourcePool::setViewport(const glm::ivec2 & viewport)
+{
+    m_viewport = viewport;
+}
+
+bool TransientResourcePool::isAliasing() const
+{
+    return m_aliasing;
+}
+
+void TransientResourcePool::setAliasing(bool enabled)
+{
+    if (enabled == m_aliasing)
+        return;
+
+    m_aliasing = enabled;
+    m_planned = false;
+}
+
+bool TransientResourcePool::isPlanned() const
+{
+    return m_planned;
+}
+
+void TransientResourcePool::invalidatePlan()
+{
+    m_planned = false;
+}
+
+void TransientResourcePool::plan(const StageGraph & graph, const std::vector<std::size_t> & times)
+{
+    m_lifetimes.clear();
+
+    for (std::size_t index = 0; index < graph.size(); ++index)
+    {
+        for (auto resource : graph.stage(index)->transientResources())
+        {
+            auto end = times[index];
+
+            if (resource->m_exportedAs)
+            {
+                for (auto consumer : resource->m_exportedAs->consumers())
+                {
+                    auto reader = consumer->owner();
+
+                    // The inputs of a stage may be read later by the stage processing on its behalf
+                    if (reader && reader->processedBy())
+                        reader = reader->processedBy();
+
+                    const auto consumerIndex = reader ? graph.indexOf(reader) : StageGraph::npos;
+
+                    if (consumerIndex != StageGraph::npos)
+                        end = std::max(end, times[consumerIndex]);
+                }
+            }
+
+            m_lifetimes.push_back({ resource, times[index], end });
+        }
+    }
+
+    std::stable_sort(m_lifetimes.begin(), m_lifetimes.end(), [](const Lifetime & lhs, const Lifetime & rhs)
+    {
+        return lhs.start < rhs.start;
+    });
+
+    // Lifetimes are visited by start, so reusing any object that is free again needs the fewest objects
+    std::vector<Slot> slots;
+
+    for (auto & lifetime : m_lifetimes)
+    {
+        auto resource = lifetime.resource;
+
+        const Description description(*resource);
+
+        auto it = !m_aliasing ? slots.end() : std::find_if(slots.begin(), slots.end(), [&lifetime, &description](const Slot & slot)
+        {
+            return slot.end < lifetime.start && slot.description == description;
+        });
+
+        if (it == slots.end())
+        {
+            Slot slot{ description, 0, nullptr, glm::ivec2(0, 0), nullptr, nullptr };
+
+            slots.push_back(slot);
+            it = slots.end() - 1;
+        }
+
+        it->end = lifetime.end;
+        resource->m_slot = static_cast<std::size_t>(it - slots.begin());
+    }
+
+    // Keep the objects of the previous plan, preferably where their contents are still needed
+    std::vector<bool> reused(m_slots.size(), false);
+
+    for (auto & slot : slots)
+    {
+        std::size_t match = npos;
+
+        for (std::size_t i = 0; i < m_slots.size(); ++i)
+        {
+            if (reused[i] || !(m_slots[i].description == slot.description))
+                continue;
+
+            const auto occupant = m_slots[i].occupant;
+
+            if (occupant && occupant->m_slot == static_cast<std::size_t>(&slot - slots.data()))
+            {
+                match = i;
+                break;
+            }
+
+            if (match == npos)
+                match = i;
+        }
+
+        if (match == npos)
+            continue;
+
+        reused[match] = true;
+        slot.size = m_slots[match].size;
+        slot.texture = m_slots[match].texture;
+        slot.renderbuffer = m_slots[match].renderbuffer;
+
+        const auto occupant = m_slots[match].occupant;
+
+        if (occupant && occupant->m_slot == static_cast<std::size_t>(&slot - slots.data()))
+            slot.occupant = occupant;
+    }
+
+    m_slots = std::move(slots);
+
+    for (auto & lifetime : m_lifetimes)
+    {
+        auto resource = lifetime.resource;
+        const auto & slot = m_slots[resource->m_slot];
+
+        resource->m_size = slot.size;
+        resource->m_texture = slot.texture;
+        resource->m_renderbuffer = slot.renderbuffer;
+
+        // The contents of passed on resources are lost if they did not keep their object
+        if (resource->m_exportedAs && slot.occupant != resource)
+            resource->m_owner->scheduleProcess();
+    }
+
+    m_planned = true;
+}
+
+void TransientResourcePool::acquire(AbstractStage * stage)
+{
+    assert(m_planned);
+    assert(stage->threadAffinity() == AbstractStage::ThreadAffinity::ContextThread);
+
+    for (auto resource : stage->transientResources())
+    {
+        if (resource->m_slot >= m_slots.size())
+            continue;
+
+        auto & slot = m_slots[resource->m_slot];
+        const auto size = resource->sizeFor(m_viewport);
+
+        if (slot.size != size || (!slot.texture && !slot.renderbuffer))
+            allocate(slot, size);
+
+        // Another stage relies on the contents of the previous occupant, which are overwritten now
+        const auto occupant = slot.occupant;
+
+        if (occupant && occupant != resource && occupant->m_exportedAs && occupant->m_owner != stage)
+            occupant->m_owner->scheduleProcess();
+
+        slot.occupant = resource;
+
+        resource->m_size = slot.size;
+        resource->m_texture = slot.texture;
+        resource->m_renderbuffer = slot.renderbuffer;
+    }
+}
+
+void TransientResourcePool::remove(const TransientResource * resource)
+{
+    for (auto & slot : m_slots)
+    {
+        if (slot.occupant == resource)
+            slot.occupant = nullptr;
+    }
+
+    m_lifetimes.erase(std::remove_if(m_lifetimes.begin(), m_lifetimes.end(), [resource](const Lifetime & lifetime)
+    {
+        return lifetime.resource == resource;
+    }), m_lifetimes.end());
+
+    m_planned = false;
+}
+
+void TransientResourcePool::allocate(Slot & slot, const glm::ivec2 & size)
+{
+    const auto & description = slot.description;
+
+    if (description.type == TransientResource::Type::Texture)
+    {
+        if (!slot.texture)
+            slot.texture = globjects::Texture::createDefault(gl::GL_TEXTURE_2D);
+
+        slot.texture->image2D(0, description.internalFormat, size.x, size.y, 0, description.format, description.dataType, nullptr);
+    }
+    else
+    {
+        if (!slot.renderbuffer)
+            slot.renderbuffer = new globjects::Renderbuffer;
+
+        slot.renderbuffer->storage(description.internalFormat, size.x, size.y);
+    }
+
+    slot.size = size;
+    ++m_allocations;
+}
+
+std::size_t TransientResourcePool::slotCount() const
+{
+    return m_slots.size();
+}
+
+std::size_t TransientResourcePool::resourceCount() const
+{
+    return m_lifetimes.size();
+}
+
+std::size_t TransientResourcePool::allocationCount() const
+{
+    return m_allocations;
+}
+
+void TransientResourcePool::clear()
+{
+    for (auto & slot : m_slots)
+    {
+        // Exported contents are gone with the objects
+        if (slot.occupant && slot.occupant->m_exportedAs)
+            slot.occupant->m_owner->scheduleProcess();
+
+        slot.occupant = nullptr;
+        slot.size = glm::ivec2(0, 0);
+        slot.texture = nullptr;
+        slot.renderbuffer = nullptr;
+    }
+
+    for (auto & lifetime : m_lifetimes)
+    {
+        lifetime.resource->m_texture = nullptr;
+        lifetime.resource->m_renderbuffer = nullptr;
+    }
+}
+
+} // namespace gloperate
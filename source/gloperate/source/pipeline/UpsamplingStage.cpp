@@ -0,0 +1,168 @@
+#include <gloperate/pipeline/UpsamplingStage.h>
+
+#include <glbinding/gl/enum.h>
+
+#include <globjects/base/StaticStringSource.h>
+#include <globjects/base/StringTemplate.h>
+#include <globjects/Framebuffer.h>
+#include <globjects/Program.h>
+#include <globjects/Shader.h>
+#include <globjects/Texture.h>
+
+#include <gloperate/base/StateCache.h>
+#include <gloperate/primitives/ScreenAlignedQuad.h>
+
+
+namespace
+{
+
+const char * const bilinearSource = R"(#version 140
+#extension GL_ARB_explicit_attrib_location : require
+
+uniform sampler2D source;
+
+layout (location = 0) out vec4 fragColor;
+
+in vec2 v_uv;
+
+void main()
+{
+    fragColor = texture(source, v_uv);
+}
+)";
+
+const char * const bilateralSource = R"(#version 140
+#extension GL_ARB_explicit_attrib_location : require
+
+uniform sampler2D source;
+uniform sampler2D sourceDepth;
+uniform sampler2D depth;
+uniform float depthSharpness;
+
+layout (location = 0) out vec4 fragColor;
+
+in vec2 v_uv;
+
+void main()
+{
+    ivec2 size = textureSize(source, 0);
+    vec2 position = v_uv * vec2(size) - 0.5;
+    vec2 base = floor(position);
+    vec2 fraction = position - base;
+
+    float pixelDepth = texture(depth, v_uv).r;
+
+    vec4 color = vec4(0.0);
+    float weightSum = 0.0;
+
+    for (int y = 0; y < 2; ++y)
+    {
+        for (int x = 0; x < 2; ++x)
+        {
+            vec2 offset = vec2(x, y);
+            ivec2 texel = clamp(ivec2(base + offset), ivec2(0), size - 1);
+
+            // Bilinear weight, attenuated by the depth difference to the target pixel
+            vec2 bilinear = mix(1.0 - fraction, fraction, offset);
+            float similarity = exp(-abs(texelFetch(sourceDepth, texel, 0).r - pixelDepth) * depthSharpness);
+            float weight = bilinear.x * bilinear.y * similarity + 1e-5;
+
+            color += texelFetch(source, texel, 0) * weight;
+            weightSum += weight;
+        }
+    }
+
+    fragColor = color / weightSum;
+}
+)";
+
+const float defaultDepthSharpness = 100.0f;
+
+globjects::ref_ptr<gloperate::ScreenAlignedQuad> createQuad(const std::string & source)
+{
+    auto fragmentShaderSource = new globjects::StringTemplate(new globjects::StaticStringSource(source));
+
+#ifdef __APPLE__
+    fragmentShaderSource->replace("#version 140", "#version 150");
+#endif
+
+    return new gloperate::ScreenAlignedQuad(new globjects::Shader(gl::GL_FRAGMENT_SHADER, fragmentShaderSource));
+}
+
+} // namespace
+
+
+namespace gloperate
+{
+
+std::string UpsamplingStage::fragmentShaderSource(Filter filter)
+{
+    return filter == Filter::Bilateral ? bilateralSource : bilinearSource;
+}
+
+UpsamplingStage::UpsamplingStage(Filter filter, gl::GLenum internalFormat, gl::GLenum format, gl::GLenum type, float scale)
+:   AbstractStage("Upsampling")
+,   m_filter(filter)
+,   m_target(internalFormat, format, type, scale)
+{
+    addInput("source", source);
+    addOptionalInput("sourceDepth", sourceDepth);
+    addOptionalInput("depth", depth);
+    addOptionalInput("depthSharpness", depthSharpness);
+    addOutput("target", target);
+
+    addTransientResource(m_target, &target);
+}
+
+UpsamplingStage::~UpsamplingStage()
+{
+}
+
+void UpsamplingStage::initialize()
+{
+    m_fbo = new globjects::Framebuffer;
+    m_fbo->setDrawBuffers({ gl::GL_COLOR_ATTACHMENT0 });
+
+    m_bilinearQuad = createQuad(fragmentShaderSource(Filter::Bilinear));
+
+    if (m_filter == Filter::Bilateral)
+    {
+        m_bilateralQuad = createQuad(fragmentShaderSource(Filter::Bilateral));
+        m_bilateralQuad->program()->setUniform("sourceDepth", 1);
+        m_bilateralQuad->program()->setUniform("depth", 2);
+    }
+}
+
+UpsamplingStage::Filter UpsamplingStage::filter() const
+{
+    return m_filter;
+}
+
+void UpsamplingStage::process()
+{
+    const auto bilateral = m_bilateralQuad && sourceDepth.isConnected() && depth.isConnected();
+    const auto quad = bilateral ? m_bilateralQuad : m_bilinearQuad;
+
+    // Bound through the cache first, globjects binds the same objects to attach and set uniforms
+    stateCache()->bindFramebuffer(gl::GL_FRAMEBUFFER, m_fbo->id());
+    m_fbo->attachTexture(gl::GL_COLOR_ATTACHMENT0, m_target.texture());
+
+    stateCache()->viewport(0, 0, m_target.size().x, m_target.size().y);
+    stateCache()->disable(gl::GL_DEPTH_TEST);
+    stateCache()->useProgram(quad->program()->id());
+
+    if (bilateral)
+    {
+        stateCache()->bindTexture(gl::GL_TEXTURE1, sourceDepth.data()->target(), sourceDepth.data()->id());
+        stateCache()->bindTexture(gl::GL_TEXTURE2, depth.data()->target(), depth.data()->id());
+
+        quad->program()->setUniform("depthSharpness", depthSharpness.data(defaultDepthSharpness));
+    }
+
+    quad->setTexture(source.data());
+    quad->draw(*stateCache());
+
+    target.setData(m_target.texture());
+}
+
+} // namespace gloperate
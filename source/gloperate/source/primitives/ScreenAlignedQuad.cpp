@@ -16,6 +16,8 @@
 #include <globjects/Shader.h>
 #include <globjects/base/StringTemplate.h>
 
+#include <gloperate/base/StateCache.h>
+
 
 using namespace globjects;
 
@@ -143,6 +145,15 @@ void ScreenAlignedQuad::draw()
     }
 }
 
+void ScreenAlignedQuad::draw(StateCache & stateCache)
+{
+    if (m_texture)
+        stateCache.bindTexture(gl::GL_TEXTURE0 + m_samplerIndex, m_texture->target(), m_texture->id());
+
+    stateCache.useProgram(m_program->id());
+    m_vao->drawArrays(gl::GL_TRIANGLE_STRIP, 0, 4);
+}
+
 void ScreenAlignedQuad::setTexture(Texture* texture)
 {
     m_texture = texture;
@@ -0,0 +1,76 @@
+#include <gloperate/tools/FixedStepDriver.h>
+
+#include <cassert>
+
+#include <gloperate/painter/Painter.h>
+#include <gloperate/painter/AbstractVirtualTimeCapability.h>
+
+
+namespace gloperate
+{
+
+bool FixedStepDriver::isApplicableTo(Painter * painter)
+{
+    return painter && painter->supports<AbstractVirtualTimeCapability>();
+}
+
+FixedStepDriver::FixedStepDriver(Painter * painter, float step)
+: m_painter(painter)
+, m_timeCapability(painter->getCapability<AbstractVirtualTimeCapability>())
+, m_step(step)
+, m_previousStep(0.0f)
+, m_frameNumber(0)
+{
+    assert(isApplicableTo(painter));
+    assert(step > 0.0f);
+
+    m_previousStep = m_timeCapability->fixedStep();
+    m_timeCapability->setFixedStep(m_step);
+
+    rewind();
+}
+
+FixedStepDriver::~FixedStepDriver()
+{
+    m_timeCapability->setFixedStep(m_previousStep);
+}
+
+float FixedStepDriver::step() const
+{
+    return m_step;
+}
+
+std::size_t FixedStepDriver::frameNumber() const
+{
+    return m_frameNumber;
+}
+
+void FixedStepDriver::rewind()
+{
+    m_timeCapability->reset();
+    m_frameNumber = 0;
+}
+
+void FixedStepDriver::advance()
+{
+    // A disabled capability would not be updated by a host either
+    if (m_timeCapability->enabled())
+        m_timeCapability->update(m_step);
+
+    ++m_frameNumber;
+}
+
+void FixedStepDriver::run(std::size_t numFrames, const PaintFunction & paint)
+{
+    for (std::size_t i = 0; i < numFrames; ++i)
+    {
+        advance();
+
+        if (paint)
+            paint(m_frameNumber - 1);
+        else
+            m_painter->paint();
+    }
+}
+
+} // namespace gloperate
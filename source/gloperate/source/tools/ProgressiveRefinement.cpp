@@ -0,0 +1,102 @@
+#include <gloperate/tools/ProgressiveRefinement.h>
+
+#include <gloperate/painter/Painter.h>
+#include <gloperate/painter/AbstractProgressiveCapability.h>
+
+
+namespace gloperate
+{
+
+ProgressiveRefinement::ProgressiveRefinement(Painter * painter)
+: m_painter(nullptr)
+, m_capability(nullptr)
+, m_frameIndex(0)
+{
+    setPainter(painter);
+}
+
+ProgressiveRefinement::~ProgressiveRefinement()
+{
+    disconnect();
+}
+
+Painter * ProgressiveRefinement::painter() const
+{
+    return m_painter;
+}
+
+void ProgressiveRefinement::setPainter(Painter * painter)
+{
+    if (m_painter == painter)
+        return;
+
+    disconnect();
+
+    m_painter = painter;
+    m_capability = painter ? painter->getCapability<AbstractProgressiveCapability>() : nullptr;
+
+    connect();
+
+    restart();
+}
+
+unsigned int ProgressiveRefinement::frameIndex() const
+{
+    return m_frameIndex;
+}
+
+bool ProgressiveRefinement::isRefining() const
+{
+    return m_capability && m_frameIndex < m_capability->numFrames();
+}
+
+void ProgressiveRefinement::restart()
+{
+    m_frameIndex = 0;
+
+    // The painter may be in the middle of a frame and has to start over as well
+    if (m_capability)
+        m_capability->setFrameIndex(0);
+}
+
+void ProgressiveRefinement::beginPaint()
+{
+    if (m_capability)
+        m_capability->setFrameIndex(m_frameIndex);
+}
+
+void ProgressiveRefinement::endPaint()
+{
+    // Converged images are not refined any further
+    if (isRefining())
+        ++m_frameIndex;
+}
+
+void ProgressiveRefinement::connect()
+{
+    // Without the capability, there is nothing to restart
+    if (!m_capability)
+        return;
+
+    for (auto capability : m_painter->capabilities())
+    {
+        // Setting the frame index must not restart the refinement
+        if (capability == m_capability)
+            continue;
+
+        m_connections.push_back(capability->changed.connect([this]()
+        {
+            restart();
+        }));
+    }
+}
+
+void ProgressiveRefinement::disconnect()
+{
+    for (auto & connection : m_connections)
+        connection.disconnect();
+
+    m_connections.clear();
+}
+
+} // namespace gloperate
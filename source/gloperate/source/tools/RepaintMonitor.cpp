@@ -0,0 +1,120 @@
+#include <gloperate/tools/RepaintMonitor.h>
+
+#include <gloperate/painter/Painter.h>
+#include <gloperate/painter/AbstractCapability.h>
+#include <gloperate/painter/AbstractOutputCapability.h>
+#include <gloperate/pipeline/AbstractBufferedData.h>
+#include <gloperate/pipeline/AbstractData.h>
+
+
+namespace gloperate
+{
+
+RepaintMonitor::RepaintMonitor(Painter * painter)
+: m_painter(nullptr)
+, m_repaintRequired(true)
+, m_paintingThread(std::thread::id())
+{
+    setPainter(painter);
+}
+
+RepaintMonitor::~RepaintMonitor()
+{
+    disconnect();
+}
+
+Painter * RepaintMonitor::painter() const
+{
+    return m_painter;
+}
+
+void RepaintMonitor::setPainter(Painter * painter)
+{
+    if (m_painter == painter)
+        return;
+
+    disconnect();
+
+    m_painter = painter;
+
+    connect();
+
+    requestRepaint();
+}
+
+bool RepaintMonitor::isRepaintRequired() const
+{
+    return m_repaintRequired;
+}
+
+void RepaintMonitor::requestRepaint()
+{
+    if (!m_repaintRequired.exchange(true))
+        repaintRequested();
+}
+
+void RepaintMonitor::beginPaint()
+{
+    m_repaintRequired = false;
+    m_paintingThread = std::this_thread::get_id();
+}
+
+void RepaintMonitor::endPaint()
+{
+    m_paintingThread = std::thread::id();
+}
+
+void RepaintMonitor::connect()
+{
+    if (!m_painter)
+        return;
+
+    for (auto capability : m_painter->capabilities())
+    {
+        m_connections.push_back(capability->changed.connect([this]()
+        {
+            onChanged();
+        }));
+    }
+
+    auto outputCapability = m_painter->getCapability<AbstractOutputCapability>();
+
+    if (!outputCapability)
+        return;
+
+    for (auto output : outputCapability->allOutputs())
+    {
+        m_connections.push_back(output->invalidated.connect([this]()
+        {
+            onChanged();
+        }));
+
+        // Frame-ahead stages publish on a worker, the next frame acquires the buffer
+        auto buffered = dynamic_cast<AbstractBufferedData *>(output);
+
+        if (!buffered)
+            continue;
+
+        m_connections.push_back(buffered->published.connect([this]()
+        {
+            onChanged();
+        }));
+    }
+}
+
+void RepaintMonitor::disconnect()
+{
+    for (auto & connection : m_connections)
+        connection.disconnect();
+
+    m_connections.clear();
+}
+
+void RepaintMonitor::onChanged()
+{
+    // Worker threads may change outputs while the host paints
+    if (m_paintingThread != std::this_thread::get_id())
+        requestRepaint();
+}
+
+} // namespace gloperate
@@ -0,0 +1,112 @@
+#include <gloperate/tools/ResolutionScaleController.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+
+
+namespace gloperate
+{
+
+const std::size_t ResolutionScaleController::numSamples;
+const float ResolutionScaleController::step = 0.05f;
+const float ResolutionScaleController::headroom = 0.9f;
+
+ResolutionScaleController::ResolutionScaleController(float targetFrameTime)
+: m_targetFrameTime(targetFrameTime)
+, m_minimumScale(step)
+, m_maximumScale(1.0f)
+, m_scale(1.0f)
+{
+    assert(targetFrameTime > 0.0f);
+
+    m_samples.reserve(numSamples);
+}
+
+float ResolutionScaleController::targetFrameTime() const
+{
+    return m_targetFrameTime;
+}
+
+void ResolutionScaleController::setTargetFrameTime(float targetFrameTime)
+{
+    assert(targetFrameTime > 0.0f);
+
+    m_targetFrameTime = targetFrameTime;
+    m_samples.clear();
+}
+
+float ResolutionScaleController::minimumScale() const
+{
+    return m_minimumScale;
+}
+
+float ResolutionScaleController::maximumScale() const
+{
+    return m_maximumScale;
+}
+
+void ResolutionScaleController::setScaleRange(float minimum, float maximum)
+{
+    assert(minimum > 0.0f && minimum <= maximum);
+
+    m_minimumScale = minimum;
+    m_maximumScale = maximum;
+
+    const auto scale = clamp(m_scale);
+
+    if (scale != m_scale)
+        reset(scale);
+}
+
+float ResolutionScaleController::scale() const
+{
+    return m_scale;
+}
+
+void ResolutionScaleController::reset(float scale)
+{
+    m_scale = clamp(scale);
+    m_samples.clear();
+}
+
+float ResolutionScaleController::update(float frameTime)
+{
+    m_samples.push_back(frameTime);
+
+    if (m_samples.size() < numSamples)
+        return m_scale;
+
+    const auto mean = std::accumulate(m_samples.begin(), m_samples.end(), 0.0f) / m_samples.size();
+
+    m_samples.clear();
+
+    auto scale = m_scale;
+
+    if (mean > m_targetFrameTime)
+    {
+        // The largest step below the scale whose pixel count fits the target, at least one step lower
+        const auto fitting = m_scale * std::sqrt(m_targetFrameTime / mean);
+        scale = std::min(std::floor(fitting / step + 1e-3f) * step, m_scale - step);
+    }
+    else
+    {
+        const auto raised = std::round(m_scale / step + 1.0f) * step;
+        const auto predicted = mean * (raised * raised) / (m_scale * m_scale);
+
+        if (predicted < headroom * m_targetFrameTime)
+            scale = raised;
+    }
+
+    m_scale = clamp(scale);
+
+    return m_scale;
+}
+
+float ResolutionScaleController::clamp(float scale) const
+{
+    return std::min(std::max(scale, m_minimumScale), m_maximumScale);
+}
+
+} // namespace gloperate
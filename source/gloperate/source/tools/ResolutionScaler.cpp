@@ -0,0 +1,275 @@
+#include <gloperate/tools/ResolutionScaler.h>
+
+#include <cassert>
+
+#include <glbinding/ContextInfo.h>
+#include <glbinding/Version.h>
+#include <glbinding/gl/enum.h>
+#include <glbinding/gl/extension.h>
+#include <glbinding/gl/functions.h>
+#include <glbinding/gl/bitfield.h>
+
+#include <globjects/base/baselogging.h>
+
+#include <gloperate/painter/Painter.h>
+#include <gloperate/painter/AbstractResolutionScaleCapability.h>
+#include <gloperate/painter/AbstractViewportCapability.h>
+#include <gloperate/painter/AbstractTargetFramebufferCapability.h>
+
+
+namespace gloperate
+{
+
+const std::size_t ResolutionScaler::numQuerySlots;
+
+bool ResolutionScaler::isApplicableTo(Painter * painter)
+{
+    return painter
+        && painter->supports<AbstractResolutionScaleCapability>()
+        && painter->supports<AbstractViewportCapability>()
+        && painter->supports<AbstractTargetFramebufferCapability>();
+}
+
+ResolutionScaler::ResolutionScaler(Painter * painter)
+: m_painter(painter)
+, m_scaleCapability(painter->getCapability<AbstractResolutionScaleCapability>())
+, m_viewportCapability(painter->getCapability<AbstractViewportCapability>())
+, m_framebufferCapability(painter->getCapability<AbstractTargetFramebufferCapability>())
+, m_adaptive(true)
+, m_timerQueries(true)
+, m_output(0)
+, m_applied(-1)
+, m_scaled(false)
+, m_size(0)
+, m_frameNumber(0)
+{
+    assert(isApplicableTo(painter));
+
+    m_controller.setScaleRange(m_scaleCapability->minimumScale(), 1.0f);
+    m_controller.reset(m_scaleCapability->scale());
+
+    for (auto & slot : m_querySlots)
+    {
+        slot.pending = false;
+        slot.scale = 0.0f;
+        slot.queries[0] = 0;
+        slot.queries[1] = 0;
+    }
+}
+
+ResolutionScaler::~ResolutionScaler()
+{
+    // Hand the output back to the painter
+    if (m_scaled)
+    {
+        m_framebufferCapability->setFramebuffer(m_target);
+        m_viewportCapability->setViewport(m_output.x, m_output.y, m_output.z, m_output.w);
+    }
+
+    for (auto & slot : m_querySlots)
+    {
+        if (slot.queries[0])
+            gl::glDeleteQueries(2, slot.queries);
+    }
+}
+
+ResolutionScaleController & ResolutionScaler::controller()
+{
+    return m_controller;
+}
+
+const ResolutionScaleController & ResolutionScaler::controller() const
+{
+    return m_controller;
+}
+
+bool ResolutionScaler::isAdaptive() const
+{
+    return m_adaptive;
+}
+
+void ResolutionScaler::setAdaptive(bool adaptive)
+{
+    m_adaptive = adaptive && m_timerQueries;
+
+    // Results of earlier frames would be fed once adaptive again
+    for (auto & slot : m_querySlots)
+        slot.pending = false;
+}
+
+bool ResolutionScaler::hasTimerQueries() const
+{
+    return m_timerQueries;
+}
+
+void ResolutionScaler::initialize()
+{
+    m_timerQueries = glbinding::ContextInfo::version() >= glbinding::Version(3, 3)
+        || glbinding::ContextInfo::supported({ gl::GLextension::GL_ARB_timer_query });
+
+    if (m_adaptive && !m_timerQueries)
+    {
+        globjects::warning() << "Timer queries are not supported, the resolution scale is not adapted to the frame time.";
+        m_adaptive = false;
+    }
+
+    m_fbo = new globjects::Framebuffer();
+    m_color = globjects::Texture::createDefault(gl::GL_TEXTURE_2D);
+    m_depth = new globjects::Renderbuffer();
+
+    m_fbo->attachTexture(gl::GL_COLOR_ATTACHMENT0, m_color);
+    m_fbo->attachRenderBuffer(gl::GL_DEPTH_ATTACHMENT, m_depth);
+}
+
+void ResolutionScaler::paint()
+{
+    assert(m_fbo);
+
+    QuerySlot & slot = m_querySlots[m_frameNumber % numQuerySlots];
+
+    if (m_adaptive)
+    {
+        // The host may have set a scale itself
+        if (m_scaleCapability->scale() != m_controller.scale())
+            m_controller.reset(m_scaleCapability->scale());
+
+        // The slot was last used numQuerySlots frames ago, its results are likely available by now
+        if (slot.pending)
+            resolveQueries(slot);
+
+        if (!slot.queries[0])
+            gl::glGenQueries(2, slot.queries);
+    }
+
+    const auto scale = m_scaleCapability->scale();
+
+    updateViewport(scale);
+
+    if (m_adaptive)
+        gl::glQueryCounter(slot.queries[0], gl::GL_TIMESTAMP);
+
+    m_painter->paint();
+
+    if (m_scaled)
+        upsample();
+
+    if (m_adaptive)
+    {
+        gl::glQueryCounter(slot.queries[1], gl::GL_TIMESTAMP);
+
+        slot.pending = true;
+        slot.scale = scale;
+    }
+
+    ++m_frameNumber;
+}
+
+glm::ivec2 ResolutionScaler::mapToViewport(const glm::ivec2 & position) const
+{
+    if (!m_scaled)
+        return position;
+
+    const glm::vec2 output(glm::max(m_output.z, 1), glm::max(m_output.w, 1));
+    const glm::vec2 relative(position.x - m_output.x, position.y - m_output.y);
+
+    return glm::ivec2(relative * glm::vec2(m_size) / output);
+}
+
+void ResolutionScaler::updateViewport(float scale)
+{
+    const glm::ivec4 current(m_viewportCapability->x(), m_viewportCapability->y(), m_viewportCapability->width(), m_viewportCapability->height());
+
+    // Any viewport but the one set by the scaler comes from the host
+    if (current != m_applied)
+        m_output = current;
+
+    if (scale >= 1.0f)
+    {
+        if (m_scaled)
+        {
+            m_framebufferCapability->setFramebuffer(m_target);
+            m_target = nullptr;
+            m_scaled = false;
+        }
+
+        if (current != m_output)
+            m_viewportCapability->setViewport(m_output.x, m_output.y, m_output.z, m_output.w);
+
+        m_applied = m_output;
+
+        return;
+    }
+
+    // The host may have replaced its target since
+    if (m_framebufferCapability->framebuffer() != m_fbo)
+    {
+        m_target = m_framebufferCapability->framebuffer();
+        m_framebufferCapability->setFramebuffer(m_fbo);
+        m_scaled = true;
+    }
+
+    const glm::ivec2 size = glm::max(glm::ivec2(glm::round(glm::vec2(m_output.z, m_output.w) * scale)), glm::ivec2(1));
+
+    if (size != m_size)
+        resizeTarget(size);
+
+    const glm::ivec4 scaled(0, 0, size.x, size.y);
+
+    if (current != scaled)
+        m_viewportCapability->setViewport(scaled.x, scaled.y, scaled.z, scaled.w);
+
+    m_applied = scaled;
+}
+
+void ResolutionScaler::resizeTarget(const glm::ivec2 & size)
+{
+    m_color->image2D(0, gl::GL_RGBA8, size.x, size.y, 0, gl::GL_RGBA, gl::GL_UNSIGNED_BYTE, nullptr);
+    m_depth->storage(gl::GL_DEPTH_COMPONENT32, size.x, size.y);
+
+    m_size = size;
+}
+
+void ResolutionScaler::upsample()
+{
+    m_fbo->bind(gl::GL_READ_FRAMEBUFFER);
+
+    if (m_target)
+        m_target->bind(gl::GL_DRAW_FRAMEBUFFER);
+    else
+        gl::glBindFramebuffer(gl::GL_DRAW_FRAMEBUFFER, 0);
+
+    gl::glReadBuffer(gl::GL_COLOR_ATTACHMENT0);
+    gl::glBlitFramebuffer(
+        0, 0, m_size.x, m_size.y,
+        m_output.x, m_output.y, m_output.x + m_output.z, m_output.y + m_output.w,
+        gl::GL_COLOR_BUFFER_BIT, gl::GL_LINEAR);
+
+    gl::glBindFramebuffer(gl::GL_FRAMEBUFFER, 0);
+}
+
+void ResolutionScaler::resolveQueries(QuerySlot & slot)
+{
+    slot.pending = false;
+
+    // Frames rendered before the last change would distort the samples of the current scale
+    if (slot.scale != m_controller.scale())
+        return;
+
+    // Never wait for the GPU, results that are not there yet are dropped
+    gl::GLint available = 0;
+    gl::glGetQueryObjectiv(slot.queries[1], gl::GL_QUERY_RESULT_AVAILABLE, &available);
+
+    if (!available)
+        return;
+
+    gl::GLuint64 begin = 0;
+    gl::GLuint64 end = 0;
+    gl::glGetQueryObjectui64v(slot.queries[0], gl::GL_QUERY_RESULT, &begin);
+    gl::glGetQueryObjectui64v(slot.queries[1], gl::GL_QUERY_RESULT, &end);
+
+    const auto frameTime = static_cast<float>(end - begin) * 1e-9f;
+
+    m_scaleCapability->setScale(m_controller.update(frameTime));
+}
+
+} // namespace gloperate
@@ -0,0 +1,138 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include <gloperate/pipeline/StageGraph.h>
+
+#include "../gloperate-test/AllocationCounter.hpp"
+#include "SyntheticPipeline.hpp"
+
+
+using namespace gloperate;
+
+namespace
+{
+
+std::unique_ptr<SyntheticPipeline> createPipeline(Shape shape, const benchmark::State & state)
+{
+    std::unique_ptr<SyntheticPipeline> pipeline(new SyntheticPipeline(shape, static_cast<std::size_t>(state.range(0))));
+
+    if (state.range(1) > 1)
+        pipeline->setWorkerCount(static_cast<unsigned int>(state.range(1)));
+
+    return pipeline;
+}
+
+void setStageCounters(benchmark::State & state, const SyntheticPipeline & pipeline)
+{
+    state.counters["stages"] = static_cast<double>(pipeline.stages().size());
+    state.counters["processed"] = static_cast<double>(pipeline.processedStageCount());
+    state.counters["stages/s"] = benchmark::Counter(
+        static_cast<double>(state.iterations() * pipeline.processedStageCount()),
+        benchmark::Counter::kIsRate);
+}
+
+} // namespace
+
+
+/** Topological sort of the dependency graph, including building the adjacency lists */
+template <Shape shape>
+void StageGraph_sort(benchmark::State & state)
+{
+    const auto pipeline = createPipeline(shape, state);
+
+    for (auto _ : state)
+    {
+        StageGraph graph;
+
+        for (auto stage : pipeline->stages())
+        {
+            graph.addStage(stage);
+        }
+
+        benchmark::DoNotOptimize(graph.sort());
+    }
+}
+
+/** Sorting the dependencies and initializing all stages of a freshly built pipeline */
+template <Shape shape>
+void AbstractPipeline_initialize(benchmark::State & state)
+{
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto pipeline = createPipeline(shape, state);
+        state.ResumeTiming();
+
+        pipeline->initialize();
+
+        state.PauseTiming();
+        pipeline.reset();
+        state.ResumeTiming();
+    }
+}
+
+/** Steady state: no data changed since the last execution, so no stage should be processed */
+template <Shape shape>
+void AbstractPipeline_executeUnchanged(benchmark::State & state)
+{
+    const auto pipeline = createPipeline(shape, state);
+    pipeline->initialize();
+    pipeline->execute();
+
+    for (auto _ : state)
+    {
+        pipeline->execute();
+    }
+
+    setStageCounters(state, *pipeline);
+}
+
+/** A change of the single leaf parameter, which every stage depends on */
+template <Shape shape>
+void AbstractPipeline_executeLeafChange(benchmark::State & state)
+{
+    const auto pipeline = createPipeline(shape, state);
+    pipeline->initialize();
+    pipeline->execute();
+
+    for (auto _ : state)
+    {
+        pipeline->leaf->invalidate();
+        pipeline->execute();
+    }
+
+    setStageCounters(state, *pipeline);
+}
+
+/** Heap memory held per stage by a built, initialized and executed pipeline, stages included */
+template <Shape shape>
+void AbstractPipeline_memory(benchmark::State & state)
+{
+    for (auto _ : state)
+    {
+        const auto before = allocatedBytes();
+
+        auto pipeline = createPipeline(shape, state);
+        pipeline->initialize();
+        pipeline->execute();
+
+        const auto bytes = allocatedBytes() - before;
+
+        state.counters["bytes/stage"] = static_cast<double>(bytes) / static_cast<double>(state.range(0));
+    }
+}
+
+
+#define GLOPERATE_BENCHMARK_SHAPES(function, ...) \
+    BENCHMARK_TEMPLATE(function, Shape::Chain)->__VA_ARGS__; \
+    BENCHMARK_TEMPLATE(function, Shape::Fan)->__VA_ARGS__; \
+    BENCHMARK_TEMPLATE(function, Shape::Diamond)->__VA_ARGS__; \
+    BENCHMARK_TEMPLATE(function, Shape::Random)->__VA_ARGS__
+
+// Arguments: number of stages, number of workers
+GLOPERATE_BENCHMARK_SHAPES(StageGraph_sort, RangeMultiplier(10)->Ranges({ { 10, 10000 }, { 1, 1 } }));
+GLOPERATE_BENCHMARK_SHAPES(AbstractPipeline_initialize, RangeMultiplier(10)->Ranges({ { 10, 10000 }, { 1, 1 } }));
+GLOPERATE_BENCHMARK_SHAPES(AbstractPipeline_executeUnchanged, RangeMultiplier(10)->Ranges({ { 10, 10000 }, { 1, 4 } }));
+GLOPERATE_BENCHMARK_SHAPES(AbstractPipeline_executeLeafChange, RangeMultiplier(10)->Ranges({ { 10, 10000 }, { 1, 4 } }));
+GLOPERATE_BENCHMARK_SHAPES(AbstractPipeline_memory, RangeMultiplier(10)->Ranges({ { 10, 10000 }, { 1, 1 } })->Iterations(1));
@@ -0,0 +1,142 @@
+#include <benchmark/benchmark.h>
+
+#include <type_traits>
+
+#include <gloperate/painter/AbstractCapability.h>
+#include <gloperate/painter/AbstractInputCapability.h>
+#include <gloperate/painter/Painter.h>
+#include <gloperate/painter/ViewportCapability.h>
+#include <gloperate/resources/ResourceManager.h>
+
+
+using namespace gloperate;
+
+namespace
+{
+
+template <int Index>
+class BenchCapability : public AbstractCapability
+{
+};
+
+class BenchPainter : public Painter
+{
+public:
+    BenchPainter(ResourceManager & resourceManager)
+    :   Painter(resourceManager, "BenchPainter")
+    {
+    }
+
+    /** The linear dynamic_cast search getCapability() did before the registry */
+    template <typename Capability>
+    Capability * scanCapability() const
+    {
+        for (auto & capability : m_capabilities)
+        {
+            Capability * castCapability = dynamic_cast<Capability *>(capability);
+
+            if (castCapability != nullptr)
+            {
+                return castCapability;
+            }
+        }
+
+        return nullptr;
+    }
+
+    /** Count - 1 filler capabilities, followed by a viewport capability */
+    template <int Count>
+    void addCapabilities()
+    {
+        addCapabilities<Count - 1>(std::integral_constant<bool, Count == 1>());
+        addCapability(new ViewportCapability);
+    }
+
+protected:
+    template <int Count>
+    void addCapabilities(std::false_type)
+    {
+        addCapabilities<Count - 1>(std::integral_constant<bool, Count == 1>());
+        addCapability(new BenchCapability<Count - 1>);
+    }
+
+    template <int Count>
+    void addCapabilities(std::true_type)
+    {
+    }
+
+    virtual void onInitialize() override
+    {
+    }
+
+    virtual void onPaint() override
+    {
+    }
+};
+
+} // namespace
+
+
+/** Lookup of the interface of the last added capability, the worst case of the search */
+template <int Count>
+void Painter_scanCapability(benchmark::State & state)
+{
+    ResourceManager resourceManager;
+    BenchPainter painter(resourceManager);
+    painter.addCapabilities<Count>();
+
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(painter.scanCapability<AbstractViewportCapability>());
+    }
+}
+
+template <int Count>
+void Painter_getCapability(benchmark::State & state)
+{
+    ResourceManager resourceManager;
+    BenchPainter painter(resourceManager);
+    painter.addCapabilities<Count>();
+
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(painter.getCapability<AbstractViewportCapability>());
+    }
+}
+
+/** Unsupported capabilities, which input handlers ask for on every event */
+template <int Count>
+void Painter_scanUnsupported(benchmark::State & state)
+{
+    ResourceManager resourceManager;
+    BenchPainter painter(resourceManager);
+    painter.addCapabilities<Count>();
+
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(painter.scanCapability<AbstractInputCapability>() != nullptr);
+    }
+}
+
+template <int Count>
+void Painter_supportsUnsupported(benchmark::State & state)
+{
+    ResourceManager resourceManager;
+    BenchPainter painter(resourceManager);
+    painter.addCapabilities<Count>();
+
+    while (state.KeepRunning())
+    {
+        benchmark::DoNotOptimize(painter.supports<AbstractInputCapability>());
+    }
+}
+
+
+#define GLOPERATE_BENCHMARK_CAPABILITY_COUNTS(function) \
+    BENCHMARK_TEMPLATE(function, 10); \
+    BENCHMARK_TEMPLATE(function, 50)
+
+GLOPERATE_BENCHMARK_CAPABILITY_COUNTS(Painter_scanCapability);
+GLOPERATE_BENCHMARK_CAPABILITY_COUNTS(Painter_getCapability);
+GLOPERATE_BENCHMARK_CAPABILITY_COUNTS(Painter_scanUnsupported);
+GLOPERATE_BENCHMARK_CAPABILITY_COUNTS(Painter_supportsUnsupported);
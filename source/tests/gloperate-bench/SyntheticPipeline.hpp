@@ -0,0 +1,147 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gloperate/pipeline/AbstractPipeline.h>
+#include <gloperate/pipeline/AbstractStage.h>
+#include <gloperate/pipeline/Data.h>
+#include <gloperate/pipeline/InputSlot.h>
+
+
+using namespace gloperate;
+
+/** Trivial stage with any number of int inputs and a single int output */
+class SyntheticStage : public AbstractStage
+{
+public:
+    SyntheticStage(const std::string & name, std::size_t numInputs)
+    :   AbstractStage(name)
+    {
+        setThreadAffinity(ThreadAffinity::AnyThread);
+
+        for (std::size_t i = 0; i < numInputs; ++i)
+        {
+            inputs.emplace_back(new InputSlot<int>);
+            addInput(name + "_input" + std::to_string(i), *inputs.back());
+        }
+
+        addOutput(name + "_output", output);
+    }
+
+    virtual void process() override
+    {
+        auto sum = 0;
+
+        for (const auto & input : inputs)
+        {
+            sum += input->data();
+        }
+
+        output.data() = sum;
+        invalidateOutputs();
+    }
+
+    std::vector<std::unique_ptr<InputSlot<int>>> inputs;
+    Data<int> output;
+};
+
+enum class Shape
+{
+    Chain,      /**< Each stage consumes its predecessor */
+    Fan,        /**< One source feeds all stages, one sink consumes all of them */
+    Diamond,    /**< Repeated split-join diamonds of four stages */
+    Random      /**< Each stage consumes one to three random earlier stages */
+};
+
+/** Pipeline with a synthetic dependency graph, stages are added in reverse to defeat trivial orderings */
+class SyntheticPipeline : public AbstractPipeline
+{
+public:
+    SyntheticPipeline(Shape shape, std::size_t numStages)
+    :   AbstractPipeline("SyntheticPipeline")
+    ,   leaf(addConstantParameter(1))
+    {
+        std::vector<std::vector<std::size_t>> producers(numStages);
+
+        for (std::size_t i = 1; i < numStages; ++i)
+        {
+            producers[i] = producersOf(shape, i, numStages);
+        }
+
+        std::vector<SyntheticStage *> stages;
+        stages.reserve(numStages);
+
+        for (std::size_t i = 0; i < numStages; ++i)
+        {
+            const auto numInputs = i == 0 ? std::size_t(1) : producers[i].size();
+            stages.push_back(new SyntheticStage("stage" + std::to_string(i), numInputs));
+        }
+
+        *stages.front()->inputs.front() = *leaf;
+
+        for (std::size_t i = 1; i < numStages; ++i)
+        {
+            for (std::size_t j = 0; j < producers[i].size(); ++j)
+            {
+                *stages[i]->inputs[j] = stages[producers[i][j]]->output;
+            }
+        }
+
+        for (auto it = stages.rbegin(); it != stages.rend(); ++it)
+        {
+            addStage(*it);
+        }
+    }
+
+    /** The parameter consumed by the first stage, invalidating it propagates through the whole graph */
+    Data<int> * leaf;
+
+protected:
+    static std::vector<std::size_t> producersOf(Shape shape, std::size_t index, std::size_t numStages)
+    {
+        switch (shape)
+        {
+        case Shape::Chain:
+            return { index - 1 };
+
+        case Shape::Fan:
+            if (index + 1 < numStages || numStages == 2)
+                return { 0 };
+            else
+            {
+                std::vector<std::size_t> all(index - 1);
+                for (std::size_t i = 0; i < all.size(); ++i)
+                    all[i] = i + 1;
+                return all;
+            }
+
+        case Shape::Diamond:
+            // Diamonds share their tips: 0 -> {1, 2} -> 3 -> {4, 5} -> 6 ...
+            switch (index % 3)
+            {
+            case 0:  return { index - 2, index - 1 };
+            case 1:  return { index - 1 };
+            default: return { index - 2 };
+            }
+
+        case Shape::Random:
+        default:
+            {
+                // Seeded per stage to keep the graph independent of the generation order
+                std::minstd_rand random(static_cast<unsigned int>(index));
+                std::uniform_int_distribution<std::size_t> numInputs(1, std::min<std::size_t>(3, index));
+                std::uniform_int_distribution<std::size_t> producer(0, index - 1);
+
+                std::vector<std::size_t> producers(numInputs(random));
+                for (auto & p : producers)
+                    p = producer(random);
+                return producers;
+            }
+        }
+    }
+};
@@ -0,0 +1,4 @@
+#include <benchmark/benchmark.h>
+
+
+BENCHMARK_MAIN();
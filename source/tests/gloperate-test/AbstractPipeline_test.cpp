@@ -1,7 +1,14 @@
 #include <gmock/gmock.h>
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <string>
+#include <thread>
 
+#include <gloperate/pipeline/InvalidationTransaction.h>
+
+#include "AllocationCounter.hpp"
 #include "TestPipeline.hpp"
 
 
@@ -23,3 +30,319 @@ TEST_F(AbstractPipeline_test, PipelineIsSortable)
     pipeline.initialize();
     ASSERT_TRUE(pipeline.isInitialized());
 }
+
+TEST_F(AbstractPipeline_test, ParallelExecutionRespectsDependencies)
+{
+    TestPipeline pipeline;
+    pipeline.setWorkerCount(4);
+
+    for (auto stage : pipeline.stages())
+    {
+        stage->setThreadAffinity(AbstractStage::ThreadAffinity::AnyThread);
+    }
+
+    pipeline.initialize();
+    pipeline.execute();
+
+    for (auto stage : pipeline.stages())
+    {
+        auto dummyStage = static_cast<DummyStage *>(stage);
+
+        auto unconnected = std::any_of(dummyStage->inputs.begin(), dummyStage->inputs.end(), [](const std::pair<const std::string, InputSlot<int>> & input) {
+            return !input.second.isConnected();
+        });
+
+        ASSERT_EQ(unconnected ? 0 : 1, dummyStage->processCount);
+
+        if (unconnected)
+            continue;
+
+        for (auto & input : dummyStage->inputs)
+        {
+            auto producer = static_cast<const DummyStage *>(input.second.connectedData()->owner());
+
+            ASSERT_LT(producer->processOrder, dummyStage->processOrder);
+        }
+    }
+}
+
+TEST_F(AbstractPipeline_test, TransactionIsScopedToPipeline)
+{
+    Data<int> parameter;
+    Data<int> otherParameter;
+    AbstractPipeline pipeline;
+    AbstractPipeline otherPipeline;
+
+    auto stage = new DummyStage("stage", { "input0" }, {});
+    auto otherStage = new DummyStage("other", { "input0" }, {});
+    stage->inputs.at("input0") = parameter;
+    otherStage->inputs.at("input0") = otherParameter;
+
+    pipeline.addStage(stage);
+    pipeline.initialize();
+    pipeline.execute();
+    otherPipeline.addStage(otherStage);
+    otherPipeline.initialize();
+    otherPipeline.execute();
+
+    {
+        InvalidationTransaction transaction(pipeline);
+
+        parameter.setData(1);
+        otherParameter.setData(1);
+        ASSERT_FALSE(stage->isProcessScheduled());
+        ASSERT_TRUE(otherStage->isProcessScheduled());
+
+        // Stages would not see the invalidations yet
+        pipeline.execute();
+        ASSERT_EQ(1, stage->processCount);
+    }
+
+    ASSERT_TRUE(stage->isProcessScheduled());
+
+    pipeline.execute();
+    ASSERT_EQ(2, stage->processCount);
+}
+
+TEST_F(AbstractPipeline_test, TransactionOnlyDefersItsThread)
+{
+    Data<int> parameter;
+    AbstractPipeline pipeline;
+
+    auto stage = new DummyStage("stage", { "input0" }, {});
+    stage->inputs.at("input0") = parameter;
+
+    pipeline.addStage(stage);
+    pipeline.initialize();
+    pipeline.execute();
+
+    std::atomic<bool> invalidating(true);
+    std::thread worker([&parameter, &invalidating]()
+    {
+        parameter.setData(1);
+        invalidating = false;
+    });
+
+    // Transactions opened meanwhile do not defer invalidations of other threads
+    while (invalidating)
+    {
+        pipeline.beginTransaction();
+        pipeline.commitTransaction();
+    }
+
+    worker.join();
+    ASSERT_TRUE(stage->isProcessScheduled());
+}
+
+TEST_F(AbstractPipeline_test, ParallelExecutionNotifiesOnCallingThread)
+{
+    Data<int> parameter;
+
+    AbstractPipeline pipeline;
+    pipeline.setWorkerCount(4);
+
+    std::vector<DummyStage *> producers;
+
+    for (auto i = 0; i < 8; ++i)
+    {
+        auto producer = new DummyStage("producer" + std::to_string(i), { "input" }, { "output" });
+        producer->inputs.at("input") = parameter;
+        producer->setThreadAffinity(AbstractStage::ThreadAffinity::AnyThread);
+
+        pipeline.addStage(producer);
+        producers.push_back(producer);
+    }
+
+    auto consumer = new DummyStage("consumer", { "input0", "input1" }, {});
+    consumer->inputs.at("input0") = producers[0]->outputs.at("output");
+    consumer->inputs.at("input1") = producers[1]->outputs.at("output");
+    pipeline.addStage(consumer);
+
+    const auto callingThread = std::this_thread::get_id();
+    std::atomic<int> numForeignSignals(0);
+    auto numScheduled = 0;
+
+    for (auto producer : producers)
+    {
+        producer->outputs.at("output").invalidated.connect([&]()
+        {
+            if (std::this_thread::get_id() != callingThread)
+                ++numForeignSignals;
+        });
+    }
+
+    consumer->processScheduled.connect([&]()
+    {
+        if (std::this_thread::get_id() != callingThread)
+            ++numForeignSignals;
+
+        ++numScheduled;
+    });
+
+    pipeline.initialize();
+
+    for (auto i = 0; i < 10; ++i)
+    {
+        parameter.setData(i);
+        pipeline.execute();
+    }
+
+    ASSERT_EQ(0, numForeignSignals);
+    ASSERT_EQ(10, consumer->processCount);
+
+    // Stages start scheduled, so the first execution does not signal
+    ASSERT_EQ(9, numScheduled);
+}
+
+TEST_F(AbstractPipeline_test, ExecutesOnlyInvalidatedStages)
+{
+    for (unsigned int workerCount : { 1u, 3u })
+    {
+        Data<int> parameter;
+        Data<int> otherParameter;
+
+        AbstractPipeline pipeline;
+        pipeline.setWorkerCount(workerCount);
+
+        auto stage0 = new DummyStage("stage0", { "input0" }, { "output0" });
+        auto stage1 = new DummyStage("stage1", { "input0" }, {});
+        auto stage2 = new DummyStage("stage2", { "input0" }, {});
+
+        stage0->inputs.at("input0") = parameter;
+        stage1->inputs.at("input0") = stage0->outputs.at("output0");
+        stage2->inputs.at("input0") = otherParameter;
+
+        pipeline.addStages(stage0, stage1, stage2);
+        pipeline.initialize();
+
+        pipeline.execute();
+        ASSERT_EQ(3u, pipeline.visitedStageCount());
+        ASSERT_EQ(3u, pipeline.processedStageCount());
+
+        pipeline.execute();
+        ASSERT_EQ(0u, pipeline.visitedStageCount());
+        ASSERT_EQ(0u, pipeline.processedStageCount());
+
+        parameter.invalidate();
+        pipeline.execute();
+        ASSERT_EQ(2u, pipeline.visitedStageCount());
+        ASSERT_EQ(2u, pipeline.processedStageCount());
+        ASSERT_EQ(2, stage1->processCount);
+        ASSERT_EQ(1, stage2->processCount);
+
+        stage2->setEnabled(false);
+        otherParameter.invalidate();
+        pipeline.execute();
+        ASSERT_EQ(1u, pipeline.visitedStageCount());
+        ASSERT_EQ(0u, pipeline.processedStageCount());
+
+        stage2->setEnabled(true);
+        pipeline.execute();
+        ASSERT_EQ(1u, pipeline.visitedStageCount());
+        ASSERT_EQ(1u, pipeline.processedStageCount());
+        ASSERT_EQ(2, stage2->processCount);
+    }
+}
+
+TEST_F(AbstractPipeline_test, SequentialExecutionDoesNotAllocate)
+{
+    if (!allocationCountCoversLibrary())
+    {
+        std::cout << "Skipped, allocations inside the gloperate DLL are not counted" << std::endl;
+        return;
+    }
+
+    TestPipeline pipeline;
+    pipeline.initialize();
+
+    // Worklist storage grows to its final size during the first executions
+    pipeline.execute();
+    pipeline.execute();
+
+    const auto allocations = allocationCount();
+
+    for (auto i = 0; i < 10; ++i)
+    {
+        pipeline.execute();
+    }
+
+    ASSERT_EQ(allocations, allocationCount());
+
+    // All but the stage with an unconnected input are processed on every execution
+    ASSERT_EQ(pipeline.stages().size() - 1, pipeline.processedStageCount());
+}
+
+TEST_F(AbstractPipeline_test, TransactionCoalescesInvalidations)
+{
+    Data<int> parameter;
+    auto numSignals = 0;
+    parameter.invalidated.connect([&numSignals]() { ++numSignals; });
+
+    AbstractPipeline pipeline;
+
+    auto stage = new DummyStage("stage", { "input0" }, {});
+    stage->inputs.at("input0") = parameter;
+
+    pipeline.addStage(stage);
+    pipeline.initialize();
+    pipeline.execute();
+    ASSERT_FALSE(stage->isProcessScheduled());
+
+    {
+        InvalidationTransaction transaction;
+
+        pipeline.beginTransaction();
+        for (auto i = 0; i < 100; ++i)
+        {
+            parameter.setData(i);
+        }
+        pipeline.commitTransaction();
+
+        // Changes are visible through generations, scheduling waits for the outermost commit
+        ASSERT_TRUE(stage->inputs.at("input0").hasChanged());
+        ASSERT_FALSE(stage->isProcessScheduled());
+        ASSERT_EQ(0, numSignals);
+    }
+
+    ASSERT_TRUE(stage->isProcessScheduled());
+    ASSERT_EQ(1, numSignals);
+
+    pipeline.execute();
+    ASSERT_EQ(2, stage->processCount);
+}
+
+TEST_F(AbstractPipeline_test, DemandDrivenExecutionSkipsUnusedOutputs)
+{
+    Data<int> parameter;
+
+    AbstractPipeline pipeline;
+
+    auto stage0 = new DummyStage("stage0", { "input0" }, { "output0" });
+    auto color = new DummyStage("color", { "input0" }, { "output0" });
+    auto debug = new DummyStage("debug", { "input0" }, { "output0" });
+
+    stage0->inputs.at("input0") = parameter;
+    color->inputs.at("input0") = stage0->outputs.at("output0");
+    debug->inputs.at("input0") = stage0->outputs.at("output0");
+
+    pipeline.addStages(stage0, color, debug);
+    pipeline.setDemandDriven(true);
+    pipeline.addSinks("color_output0");
+    pipeline.initialize();
+
+    pipeline.execute();
+    ASSERT_EQ(2u, pipeline.processedStageCount());
+    ASSERT_FALSE(pipeline.isDemanded(debug));
+    ASSERT_EQ(0, debug->processCount);
+
+    parameter.invalidate();
+    pipeline.execute();
+    ASSERT_EQ(2, color->processCount);
+    ASSERT_EQ(0, debug->processCount);
+
+    // Showing the debug output catches up on the skipped changes
+    pipeline.addSink(&debug->outputs.at("output0"));
+    pipeline.execute();
+    ASSERT_EQ(1u, pipeline.processedStageCount());
+    ASSERT_EQ(1, debug->processCount);
+}
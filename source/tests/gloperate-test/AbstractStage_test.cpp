@@ -1,5 +1,8 @@
 #include <gmock/gmock.h>
 
+#include <iostream>
+
+#include "AllocationCounter.hpp"
 #include "DummyStage.hpp"
 
 
@@ -42,3 +45,64 @@ TEST_F(AbstractStage_test, Stage2DoesntRequireStage0Recursive)
 {
     ASSERT_TRUE(stage2.requires(&stage0, true));
 }
+
+TEST_F(AbstractStage_test, ExecuteDoesNotAllocate)
+{
+    if (!allocationCountCoversLibrary())
+    {
+        std::cout << "Skipped, allocations inside the gloperate DLL are not counted" << std::endl;
+        return;
+    }
+
+    // The first execution evaluates and caches the input state
+    stage0.execute();
+    stage1.execute();
+    stage2.execute();
+
+    const auto allocations = allocationCount();
+
+    for (auto i = 0; i < 10; ++i)
+    {
+        stage0.execute();
+        stage1.execute();
+        stage2.execute();
+    }
+
+    ASSERT_EQ(allocations, allocationCount());
+    ASSERT_EQ(11, stage2.processCount);
+}
+
+TEST_F(AbstractStage_test, InputChangesAreTrackedByGeneration)
+{
+    auto & input = stage1.inputs["input0"];
+    auto & output = stage0.outputs["output0"];
+
+    ASSERT_TRUE(input.hasChanged());
+
+    stage1.execute();
+    ASSERT_FALSE(input.hasChanged());
+    ASSERT_EQ(output.generation(), input.processedGeneration());
+
+    const auto generation = output.generation();
+    output.invalidate();
+    ASSERT_LT(generation, output.generation());
+    ASSERT_TRUE(input.hasChanged());
+    ASSERT_TRUE(stage1.isProcessScheduled());
+
+    stage1.execute();
+    ASSERT_FALSE(input.hasChanged());
+
+    // Connecting other data is a change, as generations are unique across data
+    Data<int> other;
+    input = other;
+    ASSERT_TRUE(input.hasChanged());
+}
+
+TEST_F(AbstractStage_test, InvalidatedSignalIsStillEmitted)
+{
+    auto numCallbacks = 0;
+    stage0.outputs["output0"].invalidated.connect([&numCallbacks]() { ++numCallbacks; });
+
+    stage0.execute();
+    ASSERT_EQ(1, numCallbacks);
+}
@@ -0,0 +1,195 @@
+#include "AllocationCounter.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+
+namespace
+{
+
+// Each block is preceded by its size, so freeing accounts for it without the sized delete
+struct Header
+{
+    std::size_t size;
+    void * block;       /**< Start of the allocation, further ahead for over-aligned blocks */
+};
+
+const std::size_t s_headerSize = alignof(std::max_align_t);
+
+static_assert(sizeof(Header) <= s_headerSize, "Header does not fit in front of the block");
+
+std::atomic<std::size_t> s_allocationCount(0);
+std::atomic<std::size_t> s_allocatedBytes(0);
+
+void * allocate(std::size_t size, std::size_t alignment = s_headerSize)
+{
+    ++s_allocationCount;
+
+    // Room for the header in front of the block, and for moving the block to its alignment
+    const auto padding = alignment > s_headerSize ? alignment : 0;
+
+    void * block = std::malloc(s_headerSize + padding + size);
+
+    if (!block)
+        return nullptr;
+
+    const auto address = reinterpret_cast<std::uintptr_t>(block) + s_headerSize;
+    const auto aligned = (address + alignment - 1) / alignment * alignment;
+    void * pointer = reinterpret_cast<void *>(aligned);
+
+    *(static_cast<Header *>(pointer) - 1) = { size, block };
+    s_allocatedBytes += size;
+
+    return pointer;
+}
+
+void * allocateOrThrow(std::size_t size, std::size_t alignment = s_headerSize)
+{
+    if (void * pointer = allocate(size, alignment))
+        return pointer;
+
+    throw std::bad_alloc();
+}
+
+void deallocate(void * pointer)
+{
+    if (!pointer)
+        return;
+
+    const auto header = static_cast<Header *>(pointer) - 1;
+    s_allocatedBytes -= header->size;
+
+    std::free(header->block);
+}
+
+} // namespace
+
+
+std::size_t allocationCount()
+{
+    return s_allocationCount;
+}
+
+std::size_t allocatedBytes()
+{
+    return s_allocatedBytes;
+}
+
+bool allocationCountCoversLibrary()
+{
+#if defined(_WIN32) && !defined(GLOPERATE_STATIC)
+    return false;
+#else
+    return true;
+#endif
+}
+
+// Replacing the global allocation functions counts every allocation of the executable.
+// All variants are replaced, so none of them bypasses the counter or frees a counted block.
+
+void * operator new(std::size_t size)
+{
+    return allocateOrThrow(size);
+}
+
+void * operator new[](std::size_t size)
+{
+    return allocateOrThrow(size);
+}
+
+void * operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    return allocate(size);
+}
+
+void * operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    return allocate(size);
+}
+
+void operator delete(void * pointer) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete[](void * pointer) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete(void * pointer, std::size_t) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete[](void * pointer, std::size_t) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete(void * pointer, const std::nothrow_t &) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete[](void * pointer, const std::nothrow_t &) noexcept
+{
+    deallocate(pointer);
+}
+
+#ifdef __cpp_aligned_new
+
+void * operator new(std::size_t size, std::align_val_t alignment)
+{
+    return allocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void * operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return allocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void * operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void * operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void * pointer, std::align_val_t) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete[](void * pointer, std::align_val_t) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete(void * pointer, std::size_t, std::align_val_t) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete[](void * pointer, std::size_t, std::align_val_t) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete(void * pointer, std::align_val_t, const std::nothrow_t &) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete[](void * pointer, std::align_val_t, const std::nothrow_t &) noexcept
+{
+    deallocate(pointer);
+}
+
+#endif
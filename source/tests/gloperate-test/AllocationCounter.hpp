@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+
+
+/** Number of calls to the global operator new since program start, see AllocationCounter.cpp */
+std::size_t allocationCount();
+
+/** Number of bytes allocated through the global operator new and not freed yet */
+std::size_t allocatedBytes();
+
+/** Whether allocations inside the gloperate library are counted as well.
+    A Windows DLL brings its own allocation functions, which the replacements in the executable do not reach.
+*/
+bool allocationCountCoversLibrary();
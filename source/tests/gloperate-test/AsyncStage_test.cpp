@@ -0,0 +1,228 @@
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <gloperate/pipeline/AbstractPipeline.h>
+#include <gloperate/pipeline/AsyncStage.h>
+#include <gloperate/pipeline/InputSlot.h>
+
+#include "DummyStage.hpp"
+
+
+using namespace gloperate;
+
+namespace
+{
+
+class SquareStage : public AsyncStage
+{
+public:
+    SquareStage()
+    :   AsyncStage("square")
+    ,   m_gate(std::make_shared<Gate>())
+    ,   m_result(std::make_shared<int>(0))
+    {
+        addInput("value", value);
+        addOutput("result", result);
+    }
+
+    void release()
+    {
+        std::lock_guard<std::mutex> lock(m_gate->mutex);
+        m_gate->released = true;
+        m_gate->changed.notify_all();
+    }
+
+    void waitUntilFinished()
+    {
+        const auto job = m_job;
+
+        std::unique_lock<std::mutex> lock(job->mutex);
+        job->finished.wait(lock, [&job]() { return job->done; });
+    }
+
+    InputSlot<int> value;
+    Data<int> result;
+
+protected:
+    struct Gate
+    {
+        Gate() : released(false) { }
+
+        std::mutex mutex;
+        std::condition_variable changed;
+        bool released;
+    };
+
+    virtual Job prepare() override
+    {
+        const int input = *value;
+        const auto gate = m_gate;
+        const auto result = std::make_shared<int>(0);
+
+        m_result = result;
+
+        return [input, gate, result](const std::atomic<bool> & cancelled)
+        {
+            std::unique_lock<std::mutex> lock(gate->mutex);
+
+            // Cancellation is not notified, so it is polled like in a long-running loop
+            while (!gate->released && !cancelled)
+                gate->changed.wait_for(lock, std::chrono::milliseconds(1));
+
+            *result = input * input;
+        };
+    }
+
+    virtual void publish() override
+    {
+        result.setData(*m_result);
+    }
+
+protected:
+    std::shared_ptr<Gate> m_gate;
+    std::shared_ptr<int> m_result;
+};
+
+} // namespace
+
+class AsyncStage_test : public testing::Test
+{
+};
+
+TEST_F(AsyncStage_test, DownstreamKeepsLastResultWhilePending)
+{
+    Data<int> parameter(3);
+
+    AbstractPipeline pipeline;
+
+    auto square = new SquareStage;
+    auto consumer = new DummyStage("consumer", { "input0" }, {});
+    square->value = parameter;
+    consumer->inputs.at("input0") = square->result;
+
+    pipeline.addStages(square, consumer);
+    pipeline.initialize();
+
+    // Execution returns while the job is blocked
+    pipeline.execute();
+    ASSERT_TRUE(square->isPending());
+    ASSERT_EQ(0, square->result.data());
+
+    pipeline.execute();
+    ASSERT_TRUE(square->isPending());
+
+    square->release();
+    square->waitUntilFinished();
+
+    pipeline.execute();
+    ASSERT_FALSE(square->isPending());
+    ASSERT_EQ(9, square->result.data());
+    ASSERT_EQ(2, consumer->processCount);
+
+    // Stage is idle until its input changes again
+    pipeline.execute();
+    ASSERT_EQ(0u, pipeline.visitedStageCount());
+
+    parameter.setData(4);
+    pipeline.execute();
+    square->waitUntilFinished();
+    pipeline.execute();
+    ASSERT_EQ(16, square->result.data());
+}
+
+TEST_F(AsyncStage_test, InputChangeCancelsRunningJob)
+{
+    Data<int> parameter(2);
+
+    AbstractPipeline pipeline;
+
+    auto square = new SquareStage;
+    square->value = parameter;
+
+    pipeline.addStage(square);
+    pipeline.initialize();
+    pipeline.execute();
+
+    // The cancelled job's result for 2 is dropped, the restarted job squares 5
+    parameter.setData(5);
+    pipeline.execute();
+    square->waitUntilFinished();
+    pipeline.execute();
+    ASSERT_TRUE(square->isPending());
+    ASSERT_EQ(0, square->result.data());
+
+    square->release();
+    square->waitUntilFinished();
+    pipeline.execute();
+    ASSERT_FALSE(square->isPending());
+    ASSERT_EQ(25, square->result.data());
+}
+
+TEST_F(AsyncStage_test, FinishedJobSchedulesStage)
+{
+    Data<int> parameter(3);
+
+    AbstractPipeline pipeline;
+
+    auto square = new SquareStage;
+    square->value = parameter;
+
+    int finishedCount = 0;
+    std::thread::id finishedThread;
+    square->finished.connect([&finishedCount, &finishedThread]()
+    {
+        ++finishedCount;
+        finishedThread = std::this_thread::get_id();
+    });
+
+    std::atomic<int> postedCount(0);
+    pipeline.backgroundWorkers().posted.connect([&postedCount]() { ++postedCount; });
+
+    pipeline.addStage(square);
+    pipeline.initialize();
+    pipeline.execute();
+
+    // Without being scheduled, the stage is not visited while its job runs
+    pipeline.execute();
+    ASSERT_EQ(0u, pipeline.visitedStageCount());
+
+    // The completion waits for the next execution on the context thread
+    square->release();
+    square->waitUntilFinished();
+    ASSERT_EQ(1, postedCount);
+    ASSERT_EQ(0, finishedCount);
+
+    pipeline.execute();
+    ASSERT_EQ(1, finishedCount);
+    ASSERT_EQ(std::this_thread::get_id(), finishedThread);
+    ASSERT_EQ(1u, pipeline.visitedStageCount());
+    ASSERT_EQ(9, square->result.data());
+    ASSERT_FALSE(square->isAlwaysProcess());
+}
+
+TEST_F(AsyncStage_test, DestructionCancelsRunningJob)
+{
+    Data<int> parameter(3);
+
+    {
+        AbstractPipeline pipeline;
+
+        auto square = new SquareStage;
+        square->value = parameter;
+
+        pipeline.addStage(square);
+        pipeline.initialize();
+        pipeline.execute();
+
+        ASSERT_TRUE(square->isPending());
+    }
+
+    // The job was cancelled instead of waiting for release() forever
+    SUCCEED();
+}
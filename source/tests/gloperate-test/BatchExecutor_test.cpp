@@ -0,0 +1,180 @@
+#include <gmock/gmock.h>
+
+#include <mutex>
+#include <set>
+#include <string>
+
+#include <gloperate/base/make_unique.hpp>
+#include <gloperate/pipeline/AbstractPipeline.h>
+#include <gloperate/pipeline/AbstractStage.h>
+#include <gloperate/pipeline/BatchExecutor.h>
+#include <gloperate/pipeline/Data.h>
+#include <gloperate/pipeline/InputSlot.h>
+#include <gloperate/pipeline/ParameterSweep.h>
+
+
+using namespace gloperate;
+
+namespace
+{
+
+class SumStage : public AbstractStage
+{
+public:
+    SumStage()
+    :   AbstractStage("sum")
+    ,   processCount(0)
+    {
+        addInput("a", a);
+        addInput("b", b);
+        addOutput("sum", sum);
+        setThreadAffinity(ThreadAffinity::AnyThread);
+    }
+
+    virtual void process() override
+    {
+        ++processCount;
+        sum.setData(*a + *b);
+    }
+
+    InputSlot<int> a;
+    InputSlot<int> b;
+    Data<int> sum;
+    int processCount;
+};
+
+class SumPipeline : public AbstractPipeline
+{
+public:
+    SumPipeline()
+    :   a(0)
+    ,   b(0)
+    ,   stage(new SumStage)
+    {
+        addParameter("a", &a);
+        addParameter("b", &b);
+
+        stage->a = a;
+        stage->b = b;
+
+        addStage(stage);
+    }
+
+    Data<int> a;
+    Data<int> b;
+    SumStage * stage;
+};
+
+} // namespace
+
+class BatchExecutor_test : public testing::Test
+{
+protected:
+    ParameterSweep sweep()
+    {
+        ParameterSweep sweep;
+        sweep.addParameter<int>("a", { 0, 10, 20 });
+        sweep.addParameter<int>("b", { 1, 2 });
+
+        return sweep;
+    }
+};
+
+TEST_F(BatchExecutor_test, SweepEnumeratesCombinations)
+{
+    const auto parameters = sweep();
+    ASSERT_EQ(6u, parameters.size());
+
+    // The last parameter varies fastest
+    ASSERT_EQ(0u, parameters.valueIndex(1, 0));
+    ASSERT_EQ(1u, parameters.valueIndex(1, 1));
+    ASSERT_EQ(1u, parameters.valueIndex(2, 0));
+    ASSERT_EQ(0u, parameters.valueIndex(2, 1));
+}
+
+TEST_F(BatchExecutor_test, SequentialRunStreamsOutputsInOrder)
+{
+    SumPipeline pipeline;
+    std::vector<int> sums;
+
+    BatchExecutor executor(pipeline);
+    executor.setOutputNames({ "sum" });
+
+    const auto numExecuted = executor.run(sweep(), [&sums](const BatchExecutor::Result & result)
+    {
+        sums.push_back(static_cast<const DataSnapshot<int> &>(*result.outputs.front()).value());
+    });
+
+    ASSERT_EQ(6u, numExecuted);
+    ASSERT_EQ((std::vector<int>{ 1, 2, 11, 12, 21, 22 }), sums);
+    ASSERT_EQ(6, pipeline.stage->processCount);
+}
+
+TEST_F(BatchExecutor_test, ClonesDeliverAllCombinations)
+{
+    SumPipeline pipeline;
+    std::mutex mutex;
+    std::set<std::pair<std::size_t, int>> results;
+
+    BatchExecutor executor(pipeline);
+    executor.setOutputNames({ "sum" });
+    executor.setClones([]() { return make_unique<SumPipeline>(); }, 3);
+
+    const auto parameters = sweep();
+    executor.run(parameters, [&mutex, &results](const BatchExecutor::Result & result)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        results.emplace(result.combination, static_cast<const DataSnapshot<int> &>(*result.outputs.front()).value());
+    });
+
+    ASSERT_EQ(6u, results.size());
+    ASSERT_EQ(1u, results.count({ 3, 12 }));
+    ASSERT_EQ(1u, results.count({ 4, 21 }));
+
+    // Clones were executed instead of the original pipeline
+    ASSERT_EQ(0, pipeline.stage->processCount);
+}
+
+TEST_F(BatchExecutor_test, SkipsCombinationsThatCannotBeApplied)
+{
+    SumPipeline pipeline;
+    std::size_t numResults = 0;
+
+    // "a" is an int parameter
+    ParameterSweep parameters;
+    parameters.addParameter<float>("a", { 1.0f });
+    parameters.addParameter<int>("b", { 1, 2 });
+
+    BatchExecutor executor(pipeline);
+    executor.setOutputNames({ "sum" });
+
+    const auto numExecuted = executor.run(parameters, [&numResults](const BatchExecutor::Result &)
+    {
+        ++numResults;
+    });
+
+    ASSERT_EQ(0u, numExecuted);
+    ASSERT_EQ(0u, numResults);
+}
+
+TEST_F(BatchExecutor_test, ReadbackReplacesSnapshot)
+{
+    SumPipeline pipeline;
+    std::vector<std::string> sums;
+
+    BatchExecutor executor(pipeline);
+    executor.setOutputNames({ "sum" });
+    executor.setReadback("sum", [](const AbstractData & output)
+    {
+        const auto value = static_cast<const Data<int> &>(output).data();
+
+        return std::unique_ptr<AbstractDataSnapshot>(new DataSnapshot<std::string>(std::to_string(value)));
+    });
+
+    executor.run(sweep(), [&sums](const BatchExecutor::Result & result)
+    {
+        sums.push_back(static_cast<const DataSnapshot<std::string> &>(*result.outputs.front()).value());
+    });
+
+    ASSERT_EQ((std::vector<std::string>{ "1", "2", "11", "12", "21", "22" }), sums);
+}
@@ -0,0 +1,274 @@
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gloperate/pipeline/AbstractPipeline.h>
+#include <gloperate/pipeline/AbstractStage.h>
+#include <gloperate/pipeline/BufferedData.h>
+#include <gloperate/pipeline/InputSlot.h>
+
+#include "DummyStage.hpp"
+
+
+using namespace gloperate;
+
+namespace
+{
+
+class ProducerStage : public AbstractStage
+{
+public:
+    ProducerStage()
+    :   AbstractStage("producer")
+    ,   frame(0)
+    {
+        addInput("trigger", trigger);
+        addOutput("value", value);
+        setThreadAffinity(ThreadAffinity::AnyThread);
+    }
+
+    virtual void process() override
+    {
+        value.back() = ++frame;
+        value.publish();
+    }
+
+    InputSlot<int> trigger;
+    BufferedData<int> value;
+    int frame;
+};
+
+class ConsumerStage : public AbstractStage
+{
+public:
+    ConsumerStage()
+    :   AbstractStage("consumer")
+    ,   lastValue(0)
+    {
+        addInput("value", value);
+    }
+
+    virtual void process() override
+    {
+        lastValue = *value;
+    }
+
+    InputSlot<int> value;
+    int lastValue;
+};
+
+/** Frame-ahead source without inputs, which processes on every execution */
+class CounterStage : public AbstractStage
+{
+public:
+    CounterStage()
+    :   AbstractStage("counter")
+    {
+        addOutput("count", count);
+        setThreadAffinity(ThreadAffinity::AnyThread);
+    }
+
+    virtual void process() override
+    {
+        count.setData(count.data() + 1);
+    }
+
+    Data<int> count;
+};
+
+/** Buffers its input and tells the consumer about every published frame */
+class RelayStage : public AbstractStage
+{
+public:
+    RelayStage()
+    :   AbstractStage("relay")
+    ,   numPublished(0)
+    {
+        addInput("count", count);
+        addOutput("value", value);
+        setThreadAffinity(ThreadAffinity::AnyThread);
+    }
+
+    virtual void process() override
+    {
+        value.back() = *count;
+        value.publish();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        ++numPublished;
+        threads.push_back(std::this_thread::get_id());
+        published.notify_all();
+    }
+
+    InputSlot<int> count;
+    BufferedData<int> value;
+
+    std::mutex mutex;
+    std::condition_variable published;
+    int numPublished;
+    std::vector<std::thread::id> threads;
+};
+
+/** Waits on the context thread until the next frame has been published in the background */
+class WaitingConsumerStage : public AbstractStage
+{
+public:
+    WaitingConsumerStage(RelayStage & relay)
+    :   AbstractStage("consumer")
+    ,   relay(relay)
+    ,   lastValue(0)
+    ,   numOverlapped(0)
+    {
+        addInput("value", value);
+    }
+
+    virtual void process() override
+    {
+        lastValue = *value;
+
+        std::unique_lock<std::mutex> lock(relay.mutex);
+
+        if (relay.published.wait_for(lock, std::chrono::seconds(5), [this]() { return relay.numPublished > lastValue; }))
+            ++numOverlapped;
+    }
+
+    InputSlot<int> value;
+    RelayStage & relay;
+    int lastValue;
+    int numOverlapped;
+};
+
+} // namespace
+
+class BufferedData_test : public testing::Test
+{
+};
+
+TEST_F(BufferedData_test, ConsumersReadFrontUntilAcquire)
+{
+    BufferedData<int, 3> data(1);
+    InputSlot<int> slot;
+    slot = data;
+
+    data.back() = 2;
+    ASSERT_TRUE(data.publish());
+    data.back() = 3;
+    ASSERT_TRUE(data.publish());
+    ASSERT_FALSE(data.canPublish());
+    ASSERT_FALSE(data.publish());
+    ASSERT_EQ(1, *slot);
+
+    slot.processed();
+    ASSERT_TRUE(data.acquire());
+    ASSERT_TRUE(slot.hasChanged());
+    ASSERT_EQ(2, *slot);
+    ASSERT_TRUE(data.acquire());
+    ASSERT_EQ(3, *slot);
+    ASSERT_FALSE(data.acquire());
+    ASSERT_EQ(0u, data.numPending());
+}
+
+TEST_F(BufferedData_test, FramePipeliningRunsProducerAhead)
+{
+    for (unsigned int workerCount : { 1u, 2u })
+    {
+        Data<int> trigger;
+
+        AbstractPipeline pipeline;
+        pipeline.setWorkerCount(workerCount);
+
+        auto producer = new ProducerStage;
+        auto consumer = new ConsumerStage;
+        producer->trigger = trigger;
+        consumer->value = producer->value;
+
+        pipeline.addStages(producer, consumer);
+        pipeline.setFramePipelining(true);
+        pipeline.initialize();
+
+        ASSERT_TRUE(pipeline.isFrameAhead(producer));
+        ASSERT_FALSE(pipeline.isFrameAhead(consumer));
+
+        for (int frame = 1; frame <= 5; ++frame)
+        {
+            pipeline.synchronize();
+            trigger.invalidate();
+            pipeline.execute();
+
+            ASSERT_EQ(frame, consumer->lastValue);
+        }
+    }
+}
+
+TEST_F(BufferedData_test, UnbufferedConsumerKeepsProducerInFrame)
+{
+    AbstractPipeline pipeline;
+
+    auto producer = new DummyStage("producer", {}, { "output0" });
+    auto consumer = new DummyStage("consumer", { "input0" }, {});
+    consumer->inputs.at("input0") = producer->outputs.at("output0");
+    producer->setThreadAffinity(AbstractStage::ThreadAffinity::AnyThread);
+
+    pipeline.addStages(producer, consumer);
+    pipeline.setFramePipelining(true);
+    pipeline.initialize();
+    pipeline.execute();
+
+    ASSERT_FALSE(pipeline.isFrameAhead(producer));
+    ASSERT_EQ(1, consumer->processCount);
+}
+
+TEST_F(BufferedData_test, NextFrameRunsDuringContextStages)
+{
+    AbstractPipeline pipeline;
+    pipeline.setWorkerCount(2);
+
+    auto counter = new CounterStage;
+    auto relay = new RelayStage;
+    auto consumer = new WaitingConsumerStage(*relay);
+    relay->count = counter->count;
+    consumer->value = relay->value;
+
+    pipeline.addStages(counter, relay, consumer);
+    pipeline.setFramePipelining(true);
+    pipeline.initialize();
+
+    ASSERT_TRUE(pipeline.isFrameAhead(counter));
+    ASSERT_TRUE(pipeline.isFrameAhead(relay));
+
+    // Notifications of the background executions have to arrive on this thread
+    const auto contextThread = std::this_thread::get_id();
+    std::vector<std::thread::id> notifiedThreads;
+    counter->count.invalidated.connect([&notifiedThreads]() { notifiedThreads.push_back(std::this_thread::get_id()); });
+    relay->processScheduled.connect([&notifiedThreads]() { notifiedThreads.push_back(std::this_thread::get_id()); });
+
+    for (int frame = 1; frame <= 5; ++frame)
+    {
+        pipeline.execute();
+
+        ASSERT_EQ(frame, consumer->lastValue);
+    }
+
+    pipeline.synchronize();
+
+    // Every frame after the first was published while the consumer of the previous one waited
+    ASSERT_EQ(5, consumer->numOverlapped);
+    ASSERT_EQ(6, relay->numPublished);
+    ASSERT_EQ(contextThread, relay->threads.front());
+
+    for (std::size_t frame = 1; frame < relay->threads.size(); ++frame)
+    {
+        ASSERT_NE(contextThread, relay->threads[frame]);
+    }
+
+    ASSERT_FALSE(notifiedThreads.empty());
+
+    for (auto thread : notifiedThreads)
+    {
+        ASSERT_EQ(contextThread, thread);
+    }
+}
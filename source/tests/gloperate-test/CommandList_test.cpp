@@ -0,0 +1,138 @@
+#include <gmock/gmock.h>
+
+#include <thread>
+
+#include <glm/glm.hpp>
+
+#include <glbinding/gl/enum.h>
+#include <glbinding/gl/bitfield.h>
+
+#include <gloperate/base/CommandList.h>
+#include <gloperate/base/StateCache.h>
+
+
+using namespace gloperate;
+using testing::_;
+
+namespace
+{
+
+class MockFunctions
+{
+public:
+    MOCK_METHOD1(enable, void(gl::GLenum));
+    MOCK_METHOD1(disable, void(gl::GLenum));
+    MOCK_METHOD1(useProgram, void(gl::GLuint));
+    MOCK_METHOD1(clear, void(gl::ClearBufferMask));
+    MOCK_METHOD1(bindVertexArray, void(gl::GLuint));
+    MOCK_METHOD2(uniform1i, void(gl::GLint, gl::GLint));
+    MOCK_METHOD5(uniform4f, void(gl::GLint, gl::GLfloat, gl::GLfloat, gl::GLfloat, gl::GLfloat));
+    MOCK_METHOD3(drawArrays, void(gl::GLenum, gl::GLint, gl::GLsizei));
+
+    StateCache::Functions stateFunctions()
+    {
+        StateCache::Functions functions;
+
+        functions.enable = [this](gl::GLenum capability) { enable(capability); };
+        functions.disable = [this](gl::GLenum capability) { disable(capability); };
+        functions.useProgram = [this](gl::GLuint program) { useProgram(program); };
+
+        return functions;
+    }
+
+    CommandList::Functions commandFunctions()
+    {
+        CommandList::Functions functions;
+
+        functions.clear = [this](gl::ClearBufferMask mask) { clear(mask); };
+        functions.bindVertexArray = [this](gl::GLuint vertexArray) { bindVertexArray(vertexArray); };
+        functions.uniform1i = [this](gl::GLint location, gl::GLint value) { uniform1i(location, value); };
+        functions.uniform4fv = [this](gl::GLint location, gl::GLsizei, const gl::GLfloat * values) { uniform4f(location, values[0], values[1], values[2], values[3]); };
+        functions.drawArrays = [this](gl::GLenum mode, gl::GLint first, gl::GLsizei count) { drawArrays(mode, first, count); };
+
+        return functions;
+    }
+};
+
+} // namespace
+
+class CommandList_test : public testing::Test
+{
+public:
+    CommandList_test()
+    :   cache(gl.stateFunctions())
+    ,   commands(gl.commandFunctions())
+    {
+    }
+
+protected:
+    testing::StrictMock<MockFunctions> gl;
+    StateCache cache;
+    CommandList commands;
+};
+
+TEST_F(CommandList_test, RecordingDoesNotCallOpenGL)
+{
+    commands.disable(gl::GL_DEPTH_TEST);
+    commands.uniform(0, 1);
+    commands.drawArrays(gl::GL_TRIANGLES, 0, 3);
+
+    ASSERT_EQ(3u, commands.size());
+}
+
+TEST_F(CommandList_test, ReplaysInRecordedOrder)
+{
+    testing::InSequence sequence;
+    EXPECT_CALL(gl, disable(gl::GL_DEPTH_TEST));
+    EXPECT_CALL(gl, clear(gl::GL_COLOR_BUFFER_BIT));
+    EXPECT_CALL(gl, bindVertexArray(0u));
+    EXPECT_CALL(gl, uniform1i(2, 1));
+    EXPECT_CALL(gl, uniform4f(3, 1.0f, 0.5f, 0.25f, 0.0f));
+    EXPECT_CALL(gl, drawArrays(gl::GL_TRIANGLE_STRIP, 0, 4));
+    EXPECT_CALL(gl, uniform1i(2, 2));
+    EXPECT_CALL(gl, drawArrays(gl::GL_TRIANGLE_STRIP, 4, 4));
+
+    commands.disable(gl::GL_DEPTH_TEST);
+    commands.clear(gl::GL_COLOR_BUFFER_BIT);
+    commands.bindVertexArray(nullptr);
+    commands.uniform(2, 1);
+    commands.uniform(3, glm::vec4(1.0f, 0.5f, 0.25f, 0.0f));
+    commands.drawArrays(gl::GL_TRIANGLE_STRIP, 0, 4);
+    commands.uniform(2, 2);
+    commands.drawArrays(gl::GL_TRIANGLE_STRIP, 4, 4);
+
+    commands.replay(cache);
+}
+
+TEST_F(CommandList_test, StateChangesAreFilteredByTheCache)
+{
+    EXPECT_CALL(gl, disable(gl::GL_DEPTH_TEST)).Times(1);
+    EXPECT_CALL(gl, drawArrays(_, _, _)).Times(2);
+
+    commands.disable(gl::GL_DEPTH_TEST);
+    commands.drawArrays(gl::GL_TRIANGLES, 0, 3);
+    commands.disable(gl::GL_DEPTH_TEST);
+    commands.drawArrays(gl::GL_TRIANGLES, 3, 3);
+
+    commands.replay(cache);
+
+    EXPECT_EQ(1u, cache.statistics().filtered);
+}
+
+TEST_F(CommandList_test, RecordedOnWorkerReplayedOnCaller)
+{
+    EXPECT_CALL(gl, drawArrays(gl::GL_POINTS, _, 1)).Times(100);
+
+    std::thread worker([this]()
+    {
+        for (auto i = 0; i < 100; ++i)
+            commands.drawArrays(gl::GL_POINTS, i, 1);
+    });
+
+    worker.join();
+
+    commands.replay(cache);
+    commands.reset();
+
+    ASSERT_TRUE(commands.empty());
+}
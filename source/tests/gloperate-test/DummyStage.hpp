@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <vector>
 
@@ -18,6 +19,8 @@ public:
         const std::vector<std::string> & inputNames,
         const std::vector<std::string> & outputNames)
     :   AbstractStage(name)
+    ,   processCount(0)
+    ,   processOrder(0)
     {
         for (const auto & inputName : inputNames)
         {
@@ -32,8 +35,17 @@ public:
     
     virtual void process() override
     {
+        static std::atomic<int> s_processCounter(0);
+
+        ++processCount;
+        processOrder = ++s_processCounter;
+
+        invalidateOutputs();
     }
 
     std::map<std::string, InputSlot<int>> inputs;
     std::map<std::string, Data<int>> outputs;
+
+    int processCount;
+    int processOrder;
 };
@@ -0,0 +1,136 @@
+#include <gmock/gmock.h>
+
+#include <string>
+#include <vector>
+
+#include <glbinding/gl/enum.h>
+
+#include <gloperate/pipeline/FusibleStage.h>
+
+
+using namespace gloperate;
+
+namespace
+{
+
+class ScaleStage : public FusibleStage
+{
+public:
+    ScaleStage(const std::string & name, float scale = 1.0f)
+    :   FusibleStage(name, gl::GL_RGBA8, gl::GL_RGBA, gl::GL_UNSIGNED_BYTE, scale)
+    {
+    }
+
+protected:
+    virtual std::string declarations() const override
+    {
+        return "uniform float $factor;";
+    }
+
+    virtual std::string snippet() const override
+    {
+        return "    color.rgb *= $factor;";
+    }
+};
+
+} // namespace
+
+class FusibleStage_test : public testing::Test
+{
+public:
+    FusibleStage_test()
+    :   stage0("stage0")
+    ,   stage1("stage1")
+    ,   stage2("stage2")
+    {
+        stage1.source = stage0.target;
+        stage2.source = stage1.target;
+    }
+
+    std::vector<AbstractStage *> stages()
+    {
+        return { &stage0, &stage1, &stage2 };
+    }
+
+protected:
+    ScaleStage stage0;
+    ScaleStage stage1;
+    ScaleStage stage2;
+};
+
+TEST_F(FusibleStage_test, FusesLinearChain)
+{
+    FusibleStage::fuseChains(stages(), true);
+
+    const std::vector<FusibleStage *> chain = { &stage0, &stage1, &stage2 };
+    ASSERT_EQ(chain, stage2.chain());
+    ASSERT_TRUE(stage0.chain().empty());
+    ASSERT_TRUE(stage1.chain().empty());
+
+    ASSERT_EQ(&stage2, stage0.fusedInto());
+    ASSERT_EQ(&stage2, stage1.processedBy());
+    ASSERT_EQ(nullptr, stage2.fusedInto());
+
+    // Only the tail renders into a target
+    ASSERT_TRUE(stage0.transientResources().empty());
+    ASSERT_TRUE(stage1.transientResources().empty());
+    ASSERT_EQ(1u, stage2.transientResources().size());
+}
+
+TEST_F(FusibleStage_test, DisablingFusionSplitsChains)
+{
+    FusibleStage::fuseChains(stages(), true);
+    FusibleStage::fuseChains(stages(), false);
+
+    for (auto stage : { &stage0, &stage1, &stage2 })
+    {
+        ASSERT_EQ(std::vector<FusibleStage *>{ stage }, stage->chain());
+        ASSERT_EQ(nullptr, stage->fusedInto());
+        ASSERT_EQ(1u, stage->transientResources().size());
+    }
+}
+
+TEST_F(FusibleStage_test, SharedTargetEndsChain)
+{
+    // stage1.target is read by two stages, so it has to be rendered
+    ScaleStage stage3("stage3");
+    stage3.source = stage1.target;
+
+    FusibleStage::fuseChains({ &stage0, &stage1, &stage2, &stage3 }, true);
+
+    const std::vector<FusibleStage *> chain = { &stage0, &stage1 };
+    ASSERT_EQ(chain, stage1.chain());
+    ASSERT_EQ(std::vector<FusibleStage *>{ &stage2 }, stage2.chain());
+    ASSERT_EQ(std::vector<FusibleStage *>{ &stage3 }, stage3.chain());
+    ASSERT_EQ(&stage1, stage0.fusedInto());
+}
+
+TEST_F(FusibleStage_test, DifferentScalesAreNotFused)
+{
+    // A half-resolution stage renders its own target, and a full-resolution consumer starts a new chain
+    ScaleStage half("half", 0.5f);
+    ScaleStage full("full");
+    half.source = stage2.target;
+    full.source = half.target;
+
+    FusibleStage::fuseChains({ &stage0, &stage1, &stage2, &half, &full }, true);
+
+    ASSERT_EQ(3u, stage2.chain().size());
+    ASSERT_EQ(std::vector<FusibleStage *>{ &half }, half.chain());
+    ASSERT_EQ(std::vector<FusibleStage *>{ &full }, full.chain());
+}
+
+TEST_F(FusibleStage_test, FragmentShaderAppliesSnippetsInOrder)
+{
+    const auto source = FusibleStage::fragmentShaderSource({ &stage0, &stage1 });
+
+    ASSERT_NE(std::string::npos, source.find("uniform float s0_factor;"));
+    ASSERT_NE(std::string::npos, source.find("color.rgb *= s1_factor;"));
+    ASSERT_EQ(std::string::npos, source.find('$'));
+
+    const auto first = source.find("s0_apply(color, v_uv);");
+    const auto second = source.find("s1_apply(color, v_uv);");
+    ASSERT_NE(std::string::npos, first);
+    ASSERT_NE(std::string::npos, second);
+    ASSERT_LT(first, second);
+}
@@ -0,0 +1,160 @@
+#include <gmock/gmock.h>
+
+#include <gloperate/pipeline/AbstractPipeline.h>
+#include <gloperate/pipeline/AbstractStage.h>
+#include <gloperate/pipeline/Data.h>
+#include <gloperate/pipeline/InputSlot.h>
+#include <gloperate/pipeline/OutputCache.h>
+
+
+using namespace gloperate;
+
+struct Colliding
+{
+    int value;
+
+    bool operator==(const Colliding & other) const
+    {
+        return value == other.value;
+    }
+};
+
+namespace std
+{
+
+template <>
+struct hash<Colliding>
+{
+    std::size_t operator()(const Colliding &) const
+    {
+        return 0;
+    }
+};
+
+} // namespace std
+
+class CopyStage : public AbstractStage
+{
+public:
+    CopyStage()
+    {
+        addInput("value", value);
+        addOutput("copy", copy);
+
+        setMemoized(true);
+    }
+
+    virtual void process() override
+    {
+        copy.setData(value.data().value);
+    }
+
+    InputSlot<Colliding> value;
+    Data<int> copy;
+};
+
+class SquareStage : public AbstractStage
+{
+public:
+    SquareStage()
+    :   processCount(0)
+    {
+        addInput("value", value);
+        addOutput("square", square);
+
+        setMemoized(true);
+    }
+
+    virtual void process() override
+    {
+        ++processCount;
+        square.setData(value.data() * value.data());
+    }
+
+    InputSlot<int> value;
+    Data<int> square;
+
+    int processCount;
+};
+
+class OutputCache_test : public testing::Test
+{
+public:
+    OutputCache_test()
+    :   stage(new SquareStage)
+    {
+        stage->value = parameter;
+        pipeline.addStages(stage);
+        pipeline.initialize();
+    }
+
+    void execute(int value)
+    {
+        parameter.setData(value);
+        pipeline.execute();
+    }
+
+protected:
+    Data<int> parameter;
+    AbstractPipeline pipeline;
+    SquareStage * stage;
+};
+
+TEST_F(OutputCache_test, RestoresOutputsForKnownInputs)
+{
+    execute(2);
+    execute(3);
+    ASSERT_EQ(2, stage->processCount);
+
+    execute(2);
+    ASSERT_EQ(2, stage->processCount);
+    ASSERT_EQ(4, stage->square.data());
+
+    const auto statistics = pipeline.outputCache().statistics();
+    ASSERT_EQ(1u, statistics.hits);
+    ASSERT_EQ(2u, statistics.misses);
+    ASSERT_EQ(2u, statistics.entries);
+}
+
+TEST_F(OutputCache_test, EvictsLeastRecentlyUsedEntries)
+{
+    // Each entry holds a copy of the input and of the output
+    pipeline.outputCache().setBudget(4 * sizeof(int));
+
+    execute(2);
+    execute(3);
+    execute(2);
+    execute(4);
+    ASSERT_EQ(3, stage->processCount);
+    ASSERT_EQ(1u, pipeline.outputCache().statistics().evictions);
+
+    // 3 was used least recently and got evicted
+    execute(2);
+    ASSERT_EQ(3, stage->processCount);
+    execute(3);
+    ASSERT_EQ(4, stage->processCount);
+    ASSERT_EQ(9, stage->square.data());
+}
+
+TEST_F(OutputCache_test, ComparesInputsOnHashCollisions)
+{
+    Data<Colliding> value(Colliding{1});
+    AbstractPipeline collidingPipeline;
+    CopyStage * copyStage = new CopyStage;
+    copyStage->value = value;
+    collidingPipeline.addStages(copyStage);
+    collidingPipeline.initialize();
+
+    collidingPipeline.execute();
+    ASSERT_EQ(1, copyStage->copy.data());
+
+    value.setData(Colliding{2});
+    collidingPipeline.execute();
+    ASSERT_EQ(2, copyStage->copy.data());
+    ASSERT_EQ(0u, collidingPipeline.outputCache().statistics().hits);
+
+    value.setData(Colliding{2});
+    collidingPipeline.execute();
+    ASSERT_EQ(2, copyStage->copy.data());
+    ASSERT_EQ(1u, collidingPipeline.outputCache().statistics().hits);
+}
@@ -0,0 +1,114 @@
+#include <gmock/gmock.h>
+
+#include <gloperate/painter/AbstractCapability.h>
+#include <gloperate/painter/AbstractInputCapability.h>
+#include <gloperate/painter/Painter.h>
+#include <gloperate/painter/ProgressiveCapability.h>
+#include <gloperate/painter/ViewportCapability.h>
+#include <gloperate/resources/ResourceManager.h>
+
+
+using namespace gloperate;
+
+namespace
+{
+
+class AbstractTestCapability : public AbstractCapability
+{
+};
+
+class OtherBase
+{
+public:
+    virtual ~OtherBase() {}
+    int value = 0;
+};
+
+// The second base makes the cast to it adjust the pointer
+class TestCapability : public OtherBase, public AbstractTestCapability
+{
+};
+
+class UnsupportedCapability : public AbstractCapability
+{
+};
+
+// Registered interface behind a second base
+class OffsetProgressiveCapability : public OtherBase, public ProgressiveCapability
+{
+public:
+    OffsetProgressiveCapability()
+    :   ProgressiveCapability(4)
+    {
+    }
+};
+
+class TestPainter : public Painter
+{
+public:
+    TestPainter(ResourceManager & resourceManager)
+    :   Painter(resourceManager, "TestPainter")
+    {
+    }
+
+    using Painter::addCapability;
+
+protected:
+    virtual void onInitialize() override
+    {
+    }
+
+    virtual void onPaint() override
+    {
+    }
+};
+
+} // namespace
+
+class Painter_test : public testing::Test
+{
+public:
+    Painter_test()
+    :   painter(resourceManager)
+    {
+    }
+
+protected:
+    ResourceManager resourceManager;
+    TestPainter painter;
+};
+
+TEST_F(Painter_test, LookupsReturnTheCastCapability)
+{
+    auto capability = painter.addCapability(new TestCapability);
+
+    for (auto i = 0; i < 2; ++i)
+    {
+        ASSERT_EQ(capability, painter.getCapability<TestCapability>());
+        ASSERT_EQ(static_cast<AbstractTestCapability *>(capability), painter.getCapability<AbstractTestCapability>());
+        ASSERT_EQ(static_cast<OtherBase *>(capability), painter.getCapability<OtherBase>());
+    }
+}
+
+TEST_F(Painter_test, AddedCapabilityAnswersEarlierMisses)
+{
+    ASSERT_FALSE(painter.supports<UnsupportedCapability>());
+
+    auto capability = painter.addCapability(new UnsupportedCapability);
+
+    ASSERT_TRUE(painter.supports<UnsupportedCapability>());
+    ASSERT_EQ(capability, painter.getCapability<UnsupportedCapability>());
+}
+
+TEST_F(Painter_test, RegisteredInterfacesReturnTheFirstCapability)
+{
+    ASSERT_EQ(nullptr, painter.getCapability<AbstractViewportCapability>());
+
+    auto first = painter.addCapability(new ViewportCapability);
+    painter.addCapability(new ViewportCapability);
+    auto progressive = painter.addCapability(new OffsetProgressiveCapability);
+
+    ASSERT_EQ(static_cast<AbstractViewportCapability *>(first), painter.getCapability<AbstractViewportCapability>());
+    ASSERT_EQ(static_cast<AbstractProgressiveCapability *>(progressive), painter.getCapability<AbstractProgressiveCapability>());
+    ASSERT_FALSE(painter.supports<AbstractInputCapability>());
+}
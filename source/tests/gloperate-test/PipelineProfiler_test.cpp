@@ -0,0 +1,65 @@
+#include <gmock/gmock.h>
+
+#include <sstream>
+
+#include <gloperate/pipeline/PipelineProfiler.h>
+
+#include "TestPipeline.hpp"
+
+
+using namespace gloperate;
+
+class PipelineProfiler_test : public testing::Test
+{
+public:
+    PipelineProfiler_test()
+    {
+    }
+
+protected:
+};
+
+TEST_F(PipelineProfiler_test, RecordsProcessedStages)
+{
+    TestPipeline pipeline;
+    pipeline.setProfilingEnabled(true);
+    pipeline.initialize();
+
+    for (auto i = 0; i < 5; ++i)
+    {
+        pipeline.execute();
+    }
+
+    const auto statistics = pipeline.profiler()->statistics();
+    ASSERT_EQ(pipeline.stages().size(), statistics.size());
+
+    for (const auto & stageStatistics : statistics)
+    {
+        auto dummyStage = static_cast<const DummyStage *>(stageStatistics.stage);
+
+        ASSERT_EQ(static_cast<std::size_t>(dummyStage->processCount), stageStatistics.cpu.numSamples);
+        ASSERT_EQ(0u, stageStatistics.gpu.numSamples);
+
+        if (stageStatistics.cpu.numSamples == 0)
+            continue;
+
+        ASSERT_LE(stageStatistics.cpu.min, stageStatistics.cpu.average);
+        ASSERT_LE(stageStatistics.cpu.min, stageStatistics.cpu.p95);
+    }
+}
+
+TEST_F(PipelineProfiler_test, ExportsChromeTrace)
+{
+    TestPipeline pipeline;
+    pipeline.stages().front()->setName("source");
+    pipeline.setProfilingEnabled(true);
+    pipeline.initialize();
+    pipeline.execute();
+
+    std::stringstream trace;
+    pipeline.profiler()->writeChromeTrace(trace);
+
+    ASSERT_EQ(0u, trace.str().find("{\"traceEvents\":["));
+    ASSERT_NE(std::string::npos, trace.str().find("\"name\":\"Frame 1\""));
+    ASSERT_NE(std::string::npos, trace.str().find("\"name\":\"source\",\"cat\":\"cpu\""));
+}
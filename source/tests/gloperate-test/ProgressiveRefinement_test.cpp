@@ -0,0 +1,131 @@
+#include <gmock/gmock.h>
+
+#include <vector>
+
+#include <gloperate/painter/Painter.h>
+#include <gloperate/painter/ProgressiveCapability.h>
+#include <gloperate/painter/ViewportCapability.h>
+#include <gloperate/painter/VirtualTimeCapability.h>
+#include <gloperate/resources/ResourceManager.h>
+#include <gloperate/tools/ProgressiveRefinement.h>
+
+
+using namespace gloperate;
+
+namespace
+{
+
+class ProgressivePainter : public Painter
+{
+public:
+    ProgressivePainter(ResourceManager & resourceManager)
+    :   Painter(resourceManager, "ProgressivePainter")
+    ,   viewport(addCapability(new ViewportCapability))
+    ,   progressive(addCapability(new ProgressiveCapability(4)))
+    ,   time(addCapability(new VirtualTimeCapability))
+    {
+    }
+
+    ViewportCapability * viewport;
+    ProgressiveCapability * progressive;
+    VirtualTimeCapability * time;
+    std::vector<unsigned int> paintedFrames;
+
+protected:
+    virtual void onInitialize() override
+    {
+    }
+
+    virtual void onPaint() override
+    {
+        paintedFrames.push_back(progressive->frameIndex());
+    }
+};
+
+} // namespace
+
+class ProgressiveRefinement_test : public testing::Test
+{
+public:
+    ProgressiveRefinement_test()
+    :   painter(resourceManager)
+    ,   refinement(&painter)
+    {
+    }
+
+protected:
+    void paint()
+    {
+        refinement.beginPaint();
+        painter.paint();
+        refinement.endPaint();
+    }
+
+protected:
+    ResourceManager resourceManager;
+    ProgressivePainter painter;
+    ProgressiveRefinement refinement;
+};
+
+TEST_F(ProgressiveRefinement_test, StillViewRefinesUntilConverged)
+{
+    while (refinement.isRefining())
+        paint();
+
+    ASSERT_EQ(std::vector<unsigned int>({ 0, 1, 2, 3 }), painter.paintedFrames);
+
+    paint();
+
+    ASSERT_EQ(4u, refinement.frameIndex());
+    ASSERT_TRUE(painter.progressive->isConverged());
+}
+
+TEST_F(ProgressiveRefinement_test, ViewportChangeRestarts)
+{
+    paint();
+    paint();
+
+    painter.viewport->setViewport(0, 0, 640, 480);
+
+    ASSERT_TRUE(refinement.isRefining());
+    ASSERT_EQ(0u, refinement.frameIndex());
+
+    paint();
+
+    ASSERT_EQ(std::vector<unsigned int>({ 0, 1, 0 }), painter.paintedFrames);
+}
+
+TEST_F(ProgressiveRefinement_test, VirtualTimeChangeRestarts)
+{
+    paint();
+    paint();
+
+    painter.time->update(0.1f);
+
+    ASSERT_EQ(0u, refinement.frameIndex());
+}
+
+TEST_F(ProgressiveRefinement_test, ChangeWhilePaintingRestartsCurrentFrame)
+{
+    paint();
+    paint();
+
+    refinement.beginPaint();
+    painter.viewport->setViewport(0, 0, 320, 240);
+    painter.paint();
+    refinement.endPaint();
+
+    ASSERT_EQ(0u, painter.paintedFrames.back());
+    ASSERT_EQ(1u, refinement.frameIndex());
+}
+
+TEST_F(ProgressiveRefinement_test, PainterWithoutCapabilityNeverRefines)
+{
+    refinement.setPainter(nullptr);
+
+    ASSERT_FALSE(refinement.isRefining());
+
+    refinement.setPainter(&painter);
+
+    ASSERT_TRUE(refinement.isRefining());
+}
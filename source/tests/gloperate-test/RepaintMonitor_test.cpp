@@ -0,0 +1,177 @@
+#include <gmock/gmock.h>
+
+#include <thread>
+
+#include <gloperate/painter/AbstractOutputCapability.h>
+#include <gloperate/painter/Painter.h>
+#include <gloperate/painter/ViewportCapability.h>
+#include <gloperate/pipeline/BufferedData.h>
+#include <gloperate/pipeline/Data.h>
+#include <gloperate/resources/ResourceManager.h>
+#include <gloperate/tools/RepaintMonitor.h>
+
+
+using namespace gloperate;
+
+namespace
+{
+
+class TestOutputCapability : public AbstractOutputCapability
+{
+public:
+    virtual std::vector<AbstractData *> allOutputs() const override
+    {
+        return { const_cast<Data<int> *>(&output), const_cast<BufferedData<int> *>(&buffered) };
+    }
+
+    Data<int> output;
+    BufferedData<int> buffered;
+};
+
+class TestPainter : public Painter
+{
+public:
+    TestPainter(ResourceManager & resourceManager)
+    :   Painter(resourceManager, "TestPainter")
+    ,   viewport(addCapability(new ViewportCapability))
+    ,   outputs(addCapability(new TestOutputCapability))
+    {
+    }
+
+    ViewportCapability * viewport;
+    TestOutputCapability * outputs;
+
+protected:
+    virtual void onInitialize() override
+    {
+    }
+
+    // Like a pipeline, painting writes the outputs
+    virtual void onPaint() override
+    {
+        outputs->output.setData(outputs->output.data() + 1);
+    }
+};
+
+} // namespace
+
+class RepaintMonitor_test : public testing::Test
+{
+public:
+    RepaintMonitor_test()
+    :   painter(resourceManager)
+    ,   monitor(&painter)
+    {
+        monitor.repaintRequested.connect([this]() { ++requests; });
+    }
+
+protected:
+    void paint()
+    {
+        monitor.beginPaint();
+        painter.paint();
+        monitor.endPaint();
+    }
+
+protected:
+    ResourceManager resourceManager;
+    TestPainter painter;
+    RepaintMonitor monitor;
+    int requests = 0;
+};
+
+TEST_F(RepaintMonitor_test, FirstFrameIsRequired)
+{
+    ASSERT_TRUE(monitor.isRepaintRequired());
+
+    paint();
+
+    ASSERT_FALSE(monitor.isRepaintRequired());
+}
+
+TEST_F(RepaintMonitor_test, ChangesDuringPaintingAreIgnored)
+{
+    paint();
+    paint();
+
+    ASSERT_FALSE(monitor.isRepaintRequired());
+    ASSERT_EQ(0, requests);
+}
+
+TEST_F(RepaintMonitor_test, CapabilityChangesRequireRepaint)
+{
+    paint();
+
+    painter.viewport->setViewport(0, 0, 640, 480);
+    painter.viewport->setViewport(0, 0, 800, 600);
+
+    ASSERT_TRUE(monitor.isRepaintRequired());
+    ASSERT_EQ(1, requests);
+
+    paint();
+
+    ASSERT_FALSE(monitor.isRepaintRequired());
+}
+
+TEST_F(RepaintMonitor_test, OutputInvalidationOnWorkerRequiresRepaint)
+{
+    paint();
+
+    std::thread worker([this]() { painter.outputs->output.invalidate(); });
+    worker.join();
+
+    ASSERT_TRUE(monitor.isRepaintRequired());
+    ASSERT_EQ(1, requests);
+}
+
+TEST_F(RepaintMonitor_test, PublishOnWorkerRequiresRepaint)
+{
+    paint();
+
+    std::thread worker([this]() { painter.outputs->buffered.publish(); });
+    worker.join();
+
+    ASSERT_TRUE(monitor.isRepaintRequired());
+    ASSERT_EQ(1, requests);
+}
+
+TEST_F(RepaintMonitor_test, ChangesFromOtherThreadsDuringPaintingAreKept)
+{
+    monitor.beginPaint();
+
+    std::thread worker([this]() { painter.outputs->output.invalidate(); });
+    worker.join();
+
+    painter.viewport->setViewport(0, 0, 640, 480);
+
+    monitor.endPaint();
+
+    ASSERT_TRUE(monitor.isRepaintRequired());
+    ASSERT_EQ(1, requests);
+}
+
+TEST_F(RepaintMonitor_test, ExplicitRequestsDuringPaintingAreKept)
+{
+    monitor.beginPaint();
+    monitor.requestRepaint();
+    monitor.endPaint();
+
+    ASSERT_TRUE(monitor.isRepaintRequired());
+}
+
+TEST_F(RepaintMonitor_test, ReplacedPainterIsNotMonitored)
+{
+    ResourceManager otherResourceManager;
+    TestPainter other(otherResourceManager);
+
+    monitor.setPainter(&other);
+    paint();
+
+    painter.viewport->setViewport(0, 0, 640, 480);
+
+    ASSERT_FALSE(monitor.isRepaintRequired());
+
+    other.viewport->setViewport(0, 0, 640, 480);
+
+    ASSERT_TRUE(monitor.isRepaintRequired());
+}
@@ -0,0 +1,89 @@
+#include <gmock/gmock.h>
+
+#include <gloperate/painter/ResolutionScaleCapability.h>
+#include <gloperate/tools/ResolutionScaleController.h>
+
+
+using namespace gloperate;
+
+namespace
+{
+
+const float target = 1.0f / 60.0f;
+
+float feed(ResolutionScaleController & controller, float frameTime)
+{
+    for (std::size_t i = 1; i < ResolutionScaleController::numSamples; ++i)
+        controller.update(frameTime);
+
+    return controller.update(frameTime);
+}
+
+} // namespace
+
+TEST(ResolutionScaleController_test, ScaleIsKeptUntilEnoughSamples)
+{
+    ResolutionScaleController controller(target);
+
+    for (std::size_t i = 1; i < ResolutionScaleController::numSamples; ++i)
+        ASSERT_FLOAT_EQ(1.0f, controller.update(4.0f * target));
+
+    ASSERT_FLOAT_EQ(0.5f, controller.update(4.0f * target));
+}
+
+TEST(ResolutionScaleController_test, SlowFramesLowerScaleByPixelCount)
+{
+    ResolutionScaleController controller(target);
+
+    // Half the pixels at sqrt(0.5) ~ 0.707, rounded down to the step
+    ASSERT_FLOAT_EQ(0.7f, feed(controller, 2.0f * target));
+}
+
+TEST(ResolutionScaleController_test, SlightlySlowFramesLowerScaleByOneStep)
+{
+    ResolutionScaleController controller(target);
+
+    ASSERT_FLOAT_EQ(0.95f, feed(controller, 1.01f * target));
+}
+
+TEST(ResolutionScaleController_test, ScaleIsRaisedOnlyBelowHeadroom)
+{
+    ResolutionScaleController controller(target);
+    controller.reset(0.5f);
+
+    // 0.55 would take 1.21 times as long, 0.85 * 1.21 > 0.9
+    ASSERT_FLOAT_EQ(0.5f, feed(controller, 0.85f * target));
+
+    // 0.7 * 1.21 < 0.9
+    ASSERT_FLOAT_EQ(0.55f, feed(controller, 0.7f * target));
+}
+
+TEST(ResolutionScaleController_test, ScaleStaysInRange)
+{
+    ResolutionScaleController controller(target);
+    controller.setScaleRange(0.5f, 1.0f);
+
+    ASSERT_FLOAT_EQ(0.5f, feed(controller, 100.0f * target));
+    ASSERT_FLOAT_EQ(0.5f, feed(controller, 100.0f * target));
+
+    controller.reset(1.0f);
+
+    ASSERT_FLOAT_EQ(1.0f, feed(controller, 0.01f * target));
+}
+
+TEST(ResolutionScaleController_test, CapabilityClampsScale)
+{
+    ResolutionScaleCapability capability(0.25f);
+    capability.setChanged(false);
+
+    capability.setScale(0.1f);
+    ASSERT_FLOAT_EQ(0.25f, capability.scale());
+    ASSERT_TRUE(capability.hasChanged());
+
+    capability.setChanged(false);
+    capability.setScale(0.25f);
+    ASSERT_FALSE(capability.hasChanged());
+
+    capability.setScale(2.0f);
+    ASSERT_FLOAT_EQ(1.0f, capability.scale());
+}
@@ -0,0 +1,132 @@
+#include <gmock/gmock.h>
+
+#include <gloperate/painter/Painter.h>
+#include <gloperate/painter/ResolutionScaleCapability.h>
+#include <gloperate/painter/TargetFramebufferCapability.h>
+#include <gloperate/painter/ViewportCapability.h>
+#include <gloperate/resources/ResourceManager.h>
+#include <gloperate/tools/ResolutionScaler.h>
+
+
+using namespace gloperate;
+
+namespace
+{
+
+class ScaledPainter : public Painter
+{
+public:
+    ScaledPainter(ResourceManager & resourceManager)
+    :   Painter(resourceManager, "ScaledPainter")
+    ,   viewport(addCapability(new ViewportCapability))
+    ,   framebuffer(addCapability(new TargetFramebufferCapability))
+    ,   scale(addCapability(new ResolutionScaleCapability(0.25f)))
+    ,   viewportChanges(0)
+    {
+    }
+
+    ViewportCapability * viewport;
+    TargetFramebufferCapability * framebuffer;
+    ResolutionScaleCapability * scale;
+
+    glm::ivec4 paintedViewport;
+    globjects::Framebuffer * paintedFramebuffer;
+    int viewportChanges;
+
+protected:
+    virtual void onInitialize() override
+    {
+    }
+
+    virtual void onPaint() override
+    {
+        if (viewport->hasChanged())
+        {
+            ++viewportChanges;
+            viewport->setChanged(false);
+        }
+
+        paintedViewport = glm::ivec4(viewport->x(), viewport->y(), viewport->width(), viewport->height());
+        paintedFramebuffer = framebuffer->framebuffer();
+    }
+};
+
+} // namespace
+
+class ResolutionScaler_test : public testing::Test
+{
+public:
+    ResolutionScaler_test()
+    :   painter(resourceManager)
+    ,   scaler(&painter)
+    {
+        scaler.setAdaptive(false);
+        scaler.initialize();
+
+        painter.viewport->setViewport(0, 0, 800, 600);
+    }
+
+protected:
+    ResourceManager resourceManager;
+    ScaledPainter painter;
+    ResolutionScaler scaler;
+};
+
+TEST_F(ResolutionScaler_test, FullScaleLeavesOutputToPainter)
+{
+    scaler.paint();
+
+    ASSERT_EQ(glm::ivec4(0, 0, 800, 600), painter.paintedViewport);
+    ASSERT_EQ(nullptr, painter.paintedFramebuffer);
+    ASSERT_EQ(glm::ivec2(400, 300), scaler.mapToViewport(glm::ivec2(400, 300)));
+}
+
+TEST_F(ResolutionScaler_test, PainterSeesScaledViewportAndOwnTarget)
+{
+    painter.scale->setScale(0.5f);
+    scaler.paint();
+
+    ASSERT_EQ(glm::ivec4(0, 0, 400, 300), painter.paintedViewport);
+    ASSERT_NE(nullptr, painter.paintedFramebuffer);
+    ASSERT_EQ(glm::ivec2(200, 150), scaler.mapToViewport(glm::ivec2(400, 300)));
+}
+
+TEST_F(ResolutionScaler_test, ViewportChangesOnlyWithScaleOrOutput)
+{
+    painter.scale->setScale(0.5f);
+
+    scaler.paint();
+    scaler.paint();
+    scaler.paint();
+
+    ASSERT_EQ(1, painter.viewportChanges);
+
+    painter.viewport->setViewport(0, 0, 1000, 500);
+    scaler.paint();
+
+    ASSERT_EQ(2, painter.viewportChanges);
+    ASSERT_EQ(glm::ivec4(0, 0, 500, 250), painter.paintedViewport);
+
+    painter.scale->setScale(0.25f);
+    scaler.paint();
+
+    ASSERT_EQ(3, painter.viewportChanges);
+    ASSERT_EQ(glm::ivec4(0, 0, 250, 125), painter.paintedViewport);
+}
+
+TEST_F(ResolutionScaler_test, FullScaleRestoresOutput)
+{
+    auto target = new globjects::Framebuffer;
+    painter.framebuffer->setFramebuffer(target);
+
+    painter.scale->setScale(0.5f);
+    scaler.paint();
+
+    ASSERT_NE(target, painter.paintedFramebuffer);
+
+    painter.scale->setScale(1.0f);
+    scaler.paint();
+
+    ASSERT_EQ(glm::ivec4(0, 0, 800, 600), painter.paintedViewport);
+    ASSERT_EQ(target, painter.paintedFramebuffer);
+}
@@ -0,0 +1,103 @@
+#include <gmock/gmock.h>
+
+#include <vector>
+
+#include <gloperate/pipeline/Data.h>
+#include <gloperate/pipeline/InputSlot.h>
+#include <gloperate/pipeline/Shared.h>
+
+
+using namespace gloperate;
+
+namespace
+{
+
+struct Counted
+{
+    static int constructions;
+
+    Counted(int value)
+    :   value(value)
+    {
+        ++constructions;
+    }
+
+    int value;
+};
+
+int Counted::constructions = 0;
+
+} // namespace
+
+class Shared_test : public testing::Test
+{
+};
+
+TEST_F(Shared_test, DataMovesAndAssignsValues)
+{
+    Data<std::vector<int>> data;
+
+    std::vector<int> values(1000, 1);
+    const auto buffer = values.data();
+
+    data.setData(std::move(values));
+    ASSERT_EQ(buffer, data->data());
+
+    const auto generation = data.generation();
+    data.assign(10, 2);
+    ASSERT_EQ(10u, data->size());
+    ASSERT_NE(generation, data.generation());
+}
+
+TEST_F(Shared_test, ConsumersShareThePayload)
+{
+    Data<Shared<std::vector<int>>> output(Shared<std::vector<int>>::make(1000, 1));
+    InputSlot<Shared<std::vector<int>>> input;
+    input = output;
+
+    ASSERT_EQ(&output->get(), &input->get());
+}
+
+TEST_F(Shared_test, WriteCopiesOnlyWhileSnapshotsExist)
+{
+    Data<Shared<std::vector<int>>> output(Shared<std::vector<int>>::make(3, 1));
+
+    const auto payload = &output->get();
+    output->write()[0] = 2;
+    ASSERT_EQ(payload, &output->get());
+
+    auto snapshot = output->snapshot();
+    output->write()[0] = 3;
+    ASSERT_NE(payload, &output->get());
+    ASSERT_EQ(2, (*snapshot)[0]);
+    ASSERT_EQ(3, output->get()[0]);
+}
+
+TEST_F(Shared_test, WriteChangesVersion)
+{
+    auto value = Shared<std::vector<int>>::make(3, 1);
+    const auto copy = value;
+    ASSERT_EQ(copy, value);
+    ASSERT_EQ(std::hash<Shared<std::vector<int>>>()(copy), std::hash<Shared<std::vector<int>>>()(value));
+
+    // Modified in place, as the only reference
+    auto unique = Shared<std::vector<int>>::make(3, 1);
+    const auto hash = std::hash<Shared<std::vector<int>>>()(unique);
+    const auto payload = &unique.get();
+    unique.write()[0] = 2;
+    ASSERT_EQ(payload, &unique.get());
+    ASSERT_NE(hash, std::hash<Shared<std::vector<int>>>()(unique));
+
+    value.write()[0] = 2;
+    ASSERT_NE(copy, value);
+}
+
+TEST_F(Shared_test, MakeConstructsTheValueOnce)
+{
+    Counted::constructions = 0;
+
+    // Counted has no default constructor
+    const auto value = Shared<Counted>::make(3);
+    ASSERT_EQ(3, value->value);
+    ASSERT_EQ(1, Counted::constructions);
+}
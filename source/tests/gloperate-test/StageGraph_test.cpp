@@ -0,0 +1,84 @@
+#include <gmock/gmock.h>
+
+#include <gloperate/pipeline/StageGraph.h>
+
+#include "DummyStage.hpp"
+
+
+using namespace gloperate;
+
+class StageGraph_test : public testing::Test
+{
+public:
+    StageGraph_test()
+    :   stage0{"stage0", {}, { "output0" }}
+    ,   stage1{"stage1", { "input0" }, { "output0" }}
+    ,   stage2{"stage2", { "input0" }, { "output0" }}
+    ,   stage3{"stage3", { "input0" }, {}}
+    {
+        stage1.inputs["input0"] = stage0.outputs["output0"];
+        stage2.inputs["input0"] = stage1.outputs["output0"];
+
+        // Added in reverse to force reordering
+        graph.addStage(&stage3);
+        graph.addStage(&stage2);
+        graph.addStage(&stage1);
+        graph.addStage(&stage0);
+    }
+
+protected:
+    bool isBefore(const AbstractStage * first, const AbstractStage * second) const
+    {
+        return graph.position(graph.indexOf(first)) < graph.position(graph.indexOf(second));
+    }
+
+protected:
+    DummyStage stage0;
+    DummyStage stage1;
+    DummyStage stage2;
+    DummyStage stage3;
+
+    StageGraph graph;
+};
+
+TEST_F(StageGraph_test, SortsByConnections)
+{
+    ASSERT_TRUE(graph.sort());
+
+    EXPECT_TRUE(isBefore(&stage0, &stage1));
+    EXPECT_TRUE(isBefore(&stage1, &stage2));
+    EXPECT_TRUE(graph.cyclicStages().empty());
+}
+
+TEST_F(StageGraph_test, RepairsOrderOnNewConnection)
+{
+    ASSERT_TRUE(graph.sort());
+
+    stage3.inputs["input0"] = stage2.outputs["output0"];
+
+    ASSERT_TRUE(graph.updateStage(&stage3));
+    ASSERT_TRUE(graph.isSorted());
+
+    EXPECT_TRUE(isBefore(&stage0, &stage1));
+    EXPECT_TRUE(isBefore(&stage1, &stage2));
+    EXPECT_TRUE(isBefore(&stage2, &stage3));
+}
+
+TEST_F(StageGraph_test, ReportsCyclicStages)
+{
+    ASSERT_TRUE(graph.sort());
+
+    stage3.inputs["input0"] = stage2.outputs["output0"];
+    graph.updateStage(&stage3);
+
+    stage1.addDependency(&stage2);
+    graph.updateStage(&stage1);
+
+    ASSERT_FALSE(graph.isSorted());
+    ASSERT_FALSE(graph.sort());
+
+    auto cyclic = graph.cyclicStages();
+
+    EXPECT_THAT(cyclic, testing::UnorderedElementsAre(&stage1, &stage2));
+    EXPECT_EQ(graph.size(), graph.order().size());
+}
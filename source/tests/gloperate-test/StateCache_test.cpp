@@ -0,0 +1,159 @@
+#include <gmock/gmock.h>
+
+#include <glbinding/gl/enum.h>
+
+#include <gloperate/base/StateCache.h>
+
+
+using namespace gloperate;
+using testing::_;
+
+namespace
+{
+
+class MockFunctions
+{
+public:
+    MOCK_METHOD1(enable, void(gl::GLenum));
+    MOCK_METHOD1(disable, void(gl::GLenum));
+    MOCK_METHOD4(viewport, void(gl::GLint, gl::GLint, gl::GLsizei, gl::GLsizei));
+    MOCK_METHOD4(clearColor, void(gl::GLfloat, gl::GLfloat, gl::GLfloat, gl::GLfloat));
+    MOCK_METHOD1(depthMask, void(gl::GLboolean));
+    MOCK_METHOD2(bindFramebuffer, void(gl::GLenum, gl::GLuint));
+    MOCK_METHOD1(activeTexture, void(gl::GLenum));
+    MOCK_METHOD2(bindTexture, void(gl::GLenum, gl::GLuint));
+    MOCK_METHOD1(useProgram, void(gl::GLuint));
+
+    StateCache::Functions table()
+    {
+        StateCache::Functions functions;
+
+        functions.enable = [this](gl::GLenum capability) { enable(capability); };
+        functions.disable = [this](gl::GLenum capability) { disable(capability); };
+        functions.viewport = [this](gl::GLint x, gl::GLint y, gl::GLsizei width, gl::GLsizei height) { viewport(x, y, width, height); };
+        functions.clearColor = [this](gl::GLfloat r, gl::GLfloat g, gl::GLfloat b, gl::GLfloat a) { clearColor(r, g, b, a); };
+        functions.depthMask = [this](gl::GLboolean enabled) { depthMask(enabled); };
+        functions.bindFramebuffer = [this](gl::GLenum target, gl::GLuint framebuffer) { bindFramebuffer(target, framebuffer); };
+        functions.activeTexture = [this](gl::GLenum unit) { activeTexture(unit); };
+        functions.bindTexture = [this](gl::GLenum target, gl::GLuint texture) { bindTexture(target, texture); };
+        functions.useProgram = [this](gl::GLuint program) { useProgram(program); };
+
+        return functions;
+    }
+};
+
+} // namespace
+
+class StateCache_test : public testing::Test
+{
+public:
+    StateCache_test()
+    :   cache(gl.table())
+    {
+    }
+
+protected:
+    testing::StrictMock<MockFunctions> gl;
+    StateCache cache;
+};
+
+TEST_F(StateCache_test, DropsRedundantCalls)
+{
+    EXPECT_CALL(gl, disable(gl::GL_DEPTH_TEST)).Times(1);
+    EXPECT_CALL(gl, enable(gl::GL_DEPTH_TEST)).Times(1);
+
+    cache.disable(gl::GL_DEPTH_TEST);
+    cache.disable(gl::GL_DEPTH_TEST);
+    cache.enable(gl::GL_DEPTH_TEST);
+    cache.enable(gl::GL_DEPTH_TEST);
+
+    EXPECT_EQ(2u, cache.statistics().issued);
+    EXPECT_EQ(2u, cache.statistics().filtered);
+}
+
+TEST_F(StateCache_test, ComparesAllComponents)
+{
+    EXPECT_CALL(gl, viewport(0, 0, 640, 480)).Times(1);
+    EXPECT_CALL(gl, viewport(0, 0, 640, 360)).Times(1);
+    EXPECT_CALL(gl, clearColor(1.0f, 1.0f, 1.0f, 0.0f)).Times(1);
+
+    cache.viewport(0, 0, 640, 480);
+    cache.viewport(0, 0, 640, 480);
+    cache.viewport(0, 0, 640, 360);
+    cache.clearColor(1.0f, 1.0f, 1.0f, 0.0f);
+    cache.clearColor(1.0f, 1.0f, 1.0f, 0.0f);
+}
+
+TEST_F(StateCache_test, TracksDrawAndReadFramebuffers)
+{
+    EXPECT_CALL(gl, bindFramebuffer(gl::GL_FRAMEBUFFER, 1u)).Times(1);
+    EXPECT_CALL(gl, bindFramebuffer(gl::GL_READ_FRAMEBUFFER, 2u)).Times(1);
+    EXPECT_CALL(gl, bindFramebuffer(gl::GL_FRAMEBUFFER, 2u)).Times(1);
+
+    cache.bindFramebuffer(gl::GL_FRAMEBUFFER, 1);
+    cache.bindFramebuffer(gl::GL_DRAW_FRAMEBUFFER, 1);
+    cache.bindFramebuffer(gl::GL_READ_FRAMEBUFFER, 2);
+
+    // Only the draw framebuffer differs
+    cache.bindFramebuffer(gl::GL_FRAMEBUFFER, 2);
+    cache.bindFramebuffer(gl::GL_READ_FRAMEBUFFER, 2);
+}
+
+TEST_F(StateCache_test, TracksTextureBindingsPerUnit)
+{
+    EXPECT_CALL(gl, activeTexture(gl::GL_TEXTURE0)).Times(1);
+    EXPECT_CALL(gl, activeTexture(gl::GL_TEXTURE1)).Times(1);
+    EXPECT_CALL(gl, bindTexture(gl::GL_TEXTURE_2D, 3u)).Times(1);
+    EXPECT_CALL(gl, bindTexture(gl::GL_TEXTURE_2D, 4u)).Times(1);
+
+    cache.bindTexture(gl::GL_TEXTURE0, gl::GL_TEXTURE_2D, 3);
+    cache.bindTexture(gl::GL_TEXTURE1, gl::GL_TEXTURE_2D, 4);
+
+    // Bound already, the active unit is not switched back
+    cache.bindTexture(gl::GL_TEXTURE0, gl::GL_TEXTURE_2D, 3);
+    cache.bindTexture(gl::GL_TEXTURE_2D, 4);
+}
+
+TEST_F(StateCache_test, InvalidateReissuesCalls)
+{
+    EXPECT_CALL(gl, useProgram(5u)).Times(2);
+    EXPECT_CALL(gl, depthMask(_)).Times(2);
+
+    cache.useProgram(5);
+    cache.depthMask(false);
+
+    cache.invalidate();
+
+    cache.useProgram(5);
+    cache.depthMask(false);
+}
+
+TEST_F(StateCache_test, InvalidateTexturesKeepsOtherState)
+{
+    EXPECT_CALL(gl, activeTexture(gl::GL_TEXTURE0)).Times(1);
+    EXPECT_CALL(gl, bindTexture(gl::GL_TEXTURE_2D, 3u)).Times(2);
+    EXPECT_CALL(gl, useProgram(5u)).Times(1);
+
+    cache.useProgram(5);
+    cache.bindTexture(gl::GL_TEXTURE0, gl::GL_TEXTURE_2D, 3);
+
+    cache.invalidateTextures();
+
+    cache.useProgram(5);
+    cache.bindTexture(gl::GL_TEXTURE0, gl::GL_TEXTURE_2D, 3);
+}
+
+TEST_F(StateCache_test, BeginFrameResetsStatistics)
+{
+    EXPECT_CALL(gl, enable(gl::GL_BLEND)).Times(2);
+
+    cache.enable(gl::GL_BLEND);
+    cache.enable(gl::GL_BLEND);
+
+    cache.beginFrame();
+    EXPECT_EQ(0u, cache.statistics().issued);
+    EXPECT_EQ(0u, cache.statistics().filtered);
+
+    cache.enable(gl::GL_BLEND);
+    EXPECT_EQ(1u, cache.statistics().issued);
+}
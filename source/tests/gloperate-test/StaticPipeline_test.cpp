@@ -0,0 +1,140 @@
+#include <gmock/gmock.h>
+
+#include <gloperate/pipeline/AbstractStage.h>
+#include <gloperate/pipeline/InvalidationTransaction.h>
+#include <gloperate/pipeline/StaticPipeline.h>
+
+
+using namespace gloperate;
+
+namespace
+{
+
+class SourceStage : public AbstractStage
+{
+public:
+    SourceStage()
+    :   AbstractStage("source")
+    {
+        addInput("value", value);
+        addOutput("doubled", doubled);
+    }
+
+    virtual void process() override
+    {
+        doubled.setData(*value * 2);
+    }
+
+    InputSlot<int> value;
+    Data<int> doubled;
+};
+
+class SinkStage : public AbstractStage
+{
+public:
+    SinkStage()
+    :   AbstractStage("sink")
+    ,   processCount(0)
+    {
+        addInput("value", value);
+        addOutput("result", result);
+    }
+
+    virtual void process() override
+    {
+        ++processCount;
+        result.setData(*value + 1);
+    }
+
+    InputSlot<int> value;
+    Data<int> result;
+    int processCount;
+};
+
+class ChainPipeline : public StaticPipeline<SourceStage, SinkStage>
+{
+public:
+    ChainPipeline()
+    :   parameter(1)
+    {
+        addParameter("parameter", &parameter);
+
+        connect(stage<0>().value, parameter);
+        connect(stage<1>().value, stage<0>().doubled);
+    }
+
+    Data<int> parameter;
+};
+
+class ReversedPipeline : public StaticPipeline<SinkStage, SourceStage>
+{
+public:
+    ReversedPipeline()
+    {
+        connect(stage<0>().value, stage<1>().doubled);
+    }
+};
+
+} // namespace
+
+class StaticPipeline_test : public testing::Test
+{
+};
+
+TEST_F(StaticPipeline_test, ExecutesInDeclarationOrder)
+{
+    ChainPipeline pipeline;
+    pipeline.initialize();
+    ASSERT_TRUE(pipeline.isInitialized());
+
+    pipeline.execute();
+    ASSERT_EQ(3, pipeline.stage<1>().result.data());
+    ASSERT_EQ(2u, pipeline.processedStageCount());
+
+    pipeline.execute();
+    ASSERT_EQ(0u, pipeline.processedStageCount());
+
+    pipeline.parameter.setData(5);
+    pipeline.execute();
+    ASSERT_EQ(11, pipeline.stage<1>().result.data());
+    ASSERT_EQ(2, pipeline.stage<1>().processCount);
+}
+
+TEST_F(StaticPipeline_test, SupportsIntrospection)
+{
+    ChainPipeline pipeline;
+
+    ASSERT_EQ(2u, pipeline.stages().size());
+    ASSERT_EQ(&pipeline.parameter, pipeline.findParameter("parameter"));
+    ASSERT_EQ(&pipeline.stage<1>().result, pipeline.getOutput<int>("result"));
+}
+
+TEST_F(StaticPipeline_test, RejectsUnsortedDeclaration)
+{
+    ReversedPipeline pipeline;
+    pipeline.initialize();
+
+    ASSERT_FALSE(pipeline.isInitialized());
+}
+
+TEST_F(StaticPipeline_test, RefusesUnsupportedExecution)
+{
+    ChainPipeline pipeline;
+    pipeline.initialize();
+
+    pipeline.setWorkerCount(2);
+    pipeline.execute();
+    ASSERT_EQ(0, pipeline.stage<1>().processCount);
+
+    pipeline.setWorkerCount(1);
+
+    {
+        InvalidationTransaction transaction(pipeline);
+
+        pipeline.execute();
+        ASSERT_EQ(0, pipeline.stage<1>().processCount);
+    }
+
+    pipeline.execute();
+    ASSERT_EQ(1, pipeline.stage<1>().processCount);
+}
@@ -0,0 +1,191 @@
+#include <gmock/gmock.h>
+
+#include <memory>
+
+#include <glbinding/gl/enum.h>
+
+#include <gloperate/pipeline/AbstractStage.h>
+#include <gloperate/pipeline/Data.h>
+#include <gloperate/pipeline/InputSlot.h>
+#include <gloperate/pipeline/StageGraph.h>
+#include <gloperate/pipeline/TransientResource.h>
+#include <gloperate/pipeline/TransientResourcePool.h>
+
+
+using namespace gloperate;
+
+namespace
+{
+
+class RenderStage : public AbstractStage
+{
+public:
+    RenderStage(const std::string & name)
+    :   AbstractStage(name)
+    ,   color(gl::GL_RGBA8, gl::GL_RGBA, gl::GL_UNSIGNED_BYTE)
+    ,   scratch(gl::GL_RGBA8, gl::GL_RGBA, gl::GL_UNSIGNED_BYTE)
+    ,   depth(gl::GL_DEPTH_COMPONENT32)
+    {
+        addOptionalInput(name + "_input", input);
+        addOutput(name + "_output", output);
+    }
+
+    virtual void process() override
+    {
+    }
+
+    InputSlot<int> input;
+    Data<int> output;
+
+    TransientResource color;
+    TransientResource scratch;
+    TransientResource depth;
+};
+
+} // namespace
+
+class TransientResourcePool_test : public testing::Test
+{
+public:
+    TransientResourcePool_test()
+    :   stage0("stage0")
+    ,   stage1("stage1")
+    ,   stage2("stage2")
+    {
+        stage1.input = stage0.output;
+        stage2.input = stage1.output;
+
+        // stage0 passes its color target on to stage1
+        stage0.addTransientResource(stage0.color, &stage0.output);
+        stage1.addTransientResource(stage1.scratch);
+        stage1.addTransientResource(stage1.depth);
+        stage2.addTransientResource(stage2.color);
+    }
+
+protected:
+    void plan()
+    {
+        StageGraph graph;
+        graph.addStage(&stage2);
+        graph.addStage(&stage1);
+        graph.addStage(&stage0);
+        graph.sort();
+
+        std::vector<std::size_t> times(graph.size());
+
+        for (std::size_t index = 0; index < graph.size(); ++index)
+        {
+            times[index] = graph.position(index);
+        }
+
+        pool.plan(graph, times);
+    }
+
+protected:
+    RenderStage stage0;
+    RenderStage stage1;
+    RenderStage stage2;
+
+    TransientResourcePool pool;
+};
+
+TEST_F(TransientResourcePool_test, AliasesResourcesWithDisjointLifetimes)
+{
+    plan();
+
+    ASSERT_TRUE(pool.isPlanned());
+    EXPECT_EQ(4u, pool.resourceCount());
+    EXPECT_EQ(3u, pool.slotCount());
+
+    // The exported target is alive while stage1 processes, but free again for stage2
+    EXPECT_NE(stage0.color.slot(), stage1.scratch.slot());
+    EXPECT_EQ(stage0.color.slot(), stage2.color.slot());
+}
+
+TEST_F(TransientResourcePool_test, ConsumersExtendTheLifetime)
+{
+    RenderStage stage3("stage3");
+    stage3.input = stage0.output;
+    stage3.addTransientResource(stage3.color);
+
+    StageGraph graph;
+    graph.addStage(&stage0);
+    graph.addStage(&stage1);
+    graph.addStage(&stage2);
+    graph.addStage(&stage3);
+    graph.sort();
+
+    // stage3 consumes the exported target last
+    pool.plan(graph, { 0, 1, 2, 3 });
+
+    EXPECT_NE(stage0.color.slot(), stage2.color.slot());
+    EXPECT_NE(stage0.color.slot(), stage3.color.slot());
+    EXPECT_EQ(stage1.scratch.slot(), stage2.color.slot());
+    EXPECT_EQ(stage1.scratch.slot(), stage3.color.slot());
+    EXPECT_EQ(3u, pool.slotCount());
+}
+
+TEST_F(TransientResourcePool_test, OnlyAliasesCompatibleDescriptions)
+{
+    stage2.color.setFixedSize(glm::ivec2(256, 256));
+
+    plan();
+
+    EXPECT_NE(stage0.color.slot(), stage2.color.slot());
+    EXPECT_EQ(4u, pool.slotCount());
+}
+
+TEST_F(TransientResourcePool_test, AliasingCanBeDisabled)
+{
+    pool.setAliasing(false);
+
+    plan();
+
+    EXPECT_EQ(4u, pool.slotCount());
+}
+
+TEST_F(TransientResourcePool_test, ScalesRelativeToViewport)
+{
+    TransientResource halfRes(gl::GL_RGBA8, gl::GL_RGBA, gl::GL_UNSIGNED_BYTE, 0.5f);
+
+    EXPECT_EQ(glm::ivec2(640, 360), halfRes.sizeFor(glm::ivec2(1280, 720)));
+    EXPECT_EQ(glm::ivec2(1, 1), halfRes.sizeFor(glm::ivec2(0, 0)));
+
+    halfRes.setFixedSize(glm::ivec2(64, 32));
+    EXPECT_EQ(glm::ivec2(64, 32), halfRes.sizeFor(glm::ivec2(1280, 720)));
+}
+
+TEST_F(TransientResourcePool_test, ForgetsRemovedAndDestroyedResources)
+{
+    std::unique_ptr<RenderStage> stage3(new RenderStage("stage3"));
+    stage3->input = stage2.output;
+    stage3->setTransientResourcePool(&pool);
+    stage3->addTransientResource(stage3->color);
+    stage3->addTransientResource(stage3->scratch);
+
+    StageGraph graph;
+    graph.addStage(&stage0);
+    graph.addStage(&stage1);
+    graph.addStage(&stage2);
+    graph.addStage(stage3.get());
+    graph.sort();
+
+    pool.setViewport(glm::ivec2(64, 64));
+    pool.plan(graph, { 0, 1, 2, 3 });
+    pool.acquire(stage3.get());
+    EXPECT_EQ(6u, pool.resourceCount());
+
+    stage3->removeTransientResource(stage3->scratch);
+    EXPECT_FALSE(pool.isPlanned());
+    EXPECT_EQ(5u, pool.resourceCount());
+    EXPECT_EQ(TransientResourcePool::npos, stage3->scratch.slot());
+
+    // The slots occupied by the destroyed resources are free for other stages
+    stage3.reset();
+    EXPECT_EQ(4u, pool.resourceCount());
+
+    plan();
+    pool.acquire(&stage1);
+    pool.acquire(&stage2);
+    EXPECT_TRUE(pool.isPlanned());
+}
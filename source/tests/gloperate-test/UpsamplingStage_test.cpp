@@ -0,0 +1,42 @@
+#include <gmock/gmock.h>
+
+#include <string>
+
+#include <glm/vec2.hpp>
+
+#include <gloperate/pipeline/TransientResource.h>
+#include <gloperate/pipeline/UpsamplingStage.h>
+
+
+using namespace gloperate;
+
+TEST(UpsamplingStage_test, OnlyBilateralFilterWeightsByDepth)
+{
+    const auto bilinear = UpsamplingStage::fragmentShaderSource(UpsamplingStage::Filter::Bilinear);
+    const auto bilateral = UpsamplingStage::fragmentShaderSource(UpsamplingStage::Filter::Bilateral);
+
+    ASSERT_EQ(std::string::npos, bilinear.find("sourceDepth"));
+    ASSERT_NE(std::string::npos, bilateral.find("uniform sampler2D sourceDepth;"));
+    ASSERT_NE(std::string::npos, bilateral.find("uniform sampler2D depth;"));
+    ASSERT_NE(std::string::npos, bilateral.find("uniform float depthSharpness;"));
+}
+
+TEST(UpsamplingStage_test, TargetIsScaledRelativeToViewport)
+{
+    UpsamplingStage full;
+    UpsamplingStage half(UpsamplingStage::Filter::Bilateral, gl::GL_RGBA8, gl::GL_RGBA, gl::GL_UNSIGNED_BYTE, 0.5f);
+
+    ASSERT_EQ(1u, full.transientResources().size());
+    ASSERT_EQ(&full.target, full.transientResources().front()->exportedAs());
+    ASSERT_EQ(glm::ivec2(640, 480), full.transientResources().front()->sizeFor(glm::ivec2(640, 480)));
+    ASSERT_EQ(glm::ivec2(320, 240), half.transientResources().front()->sizeFor(glm::ivec2(640, 480)));
+}
+
+TEST(UpsamplingStage_test, DepthInputsAreOptional)
+{
+    UpsamplingStage stage(UpsamplingStage::Filter::Bilateral);
+
+    ASSERT_FALSE(stage.source.isOptional());
+    ASSERT_TRUE(stage.sourceDepth.isOptional());
+    ASSERT_TRUE(stage.depth.isOptional());
+}
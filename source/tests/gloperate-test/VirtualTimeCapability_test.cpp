@@ -0,0 +1,129 @@
+#include <gmock/gmock.h>
+
+#include <vector>
+
+#include <gloperate/painter/Painter.h>
+#include <gloperate/painter/VirtualTimeCapability.h>
+#include <gloperate/resources/ResourceManager.h>
+#include <gloperate/tools/FixedStepDriver.h>
+
+
+using namespace gloperate;
+
+namespace
+{
+
+class AnimatedPainter : public Painter
+{
+public:
+    AnimatedPainter(ResourceManager & resourceManager)
+    :   Painter(resourceManager, "AnimatedPainter")
+    ,   time(addCapability(new VirtualTimeCapability))
+    {
+        time->setLoopDuration(100.0f);
+    }
+
+    VirtualTimeCapability * time;
+    std::vector<float> paintedTimes;
+
+protected:
+    virtual void onInitialize() override
+    {
+    }
+
+    virtual void onPaint() override
+    {
+        paintedTimes.push_back(time->time());
+    }
+};
+
+} // namespace
+
+TEST(VirtualTimeCapability_test, VariableStepAdvancesByDelta)
+{
+    VirtualTimeCapability capability;
+
+    capability.update(0.25f);
+
+    ASSERT_FLOAT_EQ(0.25f, capability.time());
+    ASSERT_FLOAT_EQ(0.25f, capability.delta());
+    ASSERT_EQ(1u, capability.steps());
+    ASSERT_FLOAT_EQ(0.0f, capability.interpolation());
+}
+
+TEST(VirtualTimeCapability_test, FixedStepAccumulatesDeltas)
+{
+    VirtualTimeCapability capability;
+    capability.setFixedStep(0.5f);
+
+    capability.update(0.25f);
+
+    ASSERT_FLOAT_EQ(0.0f, capability.time());
+    ASSERT_EQ(0u, capability.steps());
+    ASSERT_FLOAT_EQ(0.5f, capability.interpolation());
+
+    capability.update(1.0f);
+
+    ASSERT_FLOAT_EQ(1.0f, capability.time());
+    ASSERT_FLOAT_EQ(1.0f, capability.delta());
+    ASSERT_EQ(2u, capability.steps());
+    ASSERT_FLOAT_EQ(0.5f, capability.interpolation());
+}
+
+TEST(VirtualTimeCapability_test, FixedStepCutsLongDeltas)
+{
+    VirtualTimeCapability capability;
+    capability.setLoopDuration(100.0f);
+    capability.setFixedStep(0.5f);
+
+    capability.update(60.0f);
+
+    ASSERT_EQ(VirtualTimeCapability::maxSteps, capability.steps());
+    ASSERT_FLOAT_EQ(VirtualTimeCapability::maxSteps * 0.5f, capability.time());
+    ASSERT_FLOAT_EQ(0.0f, capability.interpolation());
+}
+
+TEST(VirtualTimeCapability_test, ResetRewindsTime)
+{
+    VirtualTimeCapability capability;
+    capability.setFixedStep(0.5f);
+    capability.update(0.75f);
+
+    capability.reset();
+
+    ASSERT_FLOAT_EQ(0.0f, capability.time());
+    ASSERT_FLOAT_EQ(0.0f, capability.interpolation());
+}
+
+TEST(VirtualTimeCapability_test, DriverRendersIdenticalSequences)
+{
+    ResourceManager resourceManager;
+    AnimatedPainter painter(resourceManager);
+    painter.time->update(3.7f);
+
+    std::vector<float> first;
+
+    {
+        FixedStepDriver driver(&painter, 0.1f);
+        driver.run(20);
+        first = painter.paintedTimes;
+
+        painter.paintedTimes.clear();
+        driver.rewind();
+
+        std::vector<std::size_t> frames;
+        driver.run(20, [&](std::size_t frameNumber)
+        {
+            frames.push_back(frameNumber);
+            painter.paint();
+        });
+
+        ASSERT_EQ(20u, frames.size());
+        ASSERT_EQ(19u, frames.back());
+        ASSERT_EQ(20u, driver.frameNumber());
+    }
+
+    ASSERT_EQ(first, painter.paintedTimes);
+    ASSERT_FLOAT_EQ(0.1f, first.front());
+    ASSERT_FLOAT_EQ(0.0f, painter.time->fixedStep());
+}